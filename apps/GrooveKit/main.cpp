@@ -1,9 +1,21 @@
 #include "AppEngine.h"
+#include "HeadlessRenderer.h"
 #include "MainComponent.h"
+#include "PluginScanWorker.h"
+#include "StartupTrace.h"
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <melatonin_inspector/melatonin_inspector.h>
+#include <iostream>
 #include <memory>
 
+namespace
+{
+    // Starts the trace clock during static initialisation, as close to launch as we can get
+    [[maybe_unused]] const auto& startupTraceOrigin = StartupTrace::getInstance();
+
+    constexpr const char* startupBenchmarkSwitch = "--startup-benchmark";
+}
+
 class GrooveKitApplication final : public juce::JUCEApplication
 {
 public:
@@ -12,7 +24,53 @@ public:
 
     void initialise (const juce::String&) override
     {
-        mainWindow = std::make_unique<MainWindow>(getApplicationName());
+        const auto args = getCommandLineParameterArray();
+
+        // Launched by OutOfProcessPluginScanner: scan the job, stream results to stdout, exit
+        if (PluginScanWorker::isWorkerCommandLine (args))
+        {
+            juce::AudioPluginFormatManager formats;
+            formats.addDefaultFormats();
+
+            setApplicationReturnValue (PluginScanWorker::runFromCommandLine (args, formats));
+            quit();
+            return;
+        }
+
+        // --render in out [...]: batch render without any window, exit with a status code
+        if (HeadlessRenderer::isRenderCommandLine (args))
+        {
+            setApplicationReturnValue (HeadlessRenderer::run (args));
+            quit();
+            return;
+        }
+
+        // --startup-benchmark [trace.json]: launch, reach an idle first frame, write the trace, exit
+        const auto benchmarkIndex = args.indexOf (startupBenchmarkSwitch);
+        const bool isBenchmark = benchmarkIndex >= 0;
+
+        auto traceFile = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                             .getChildFile ("GrooveKit")
+                             .getChildFile ("startup-trace.json");
+
+        if (isBenchmark && args[benchmarkIndex + 1].isNotEmpty() && ! args[benchmarkIndex + 1].startsWith ("-"))
+            traceFile = juce::File::getCurrentWorkingDirectory().getChildFile (args[benchmarkIndex + 1].unquoted());
+
+        auto& trace = StartupTrace::getInstance();
+        trace.onStartupFinished = [traceFile, isBenchmark] {
+            auto& t = StartupTrace::getInstance();
+            t.writeTo (traceFile);
+
+            if (isBenchmark)
+            {
+                std::cout << "Startup to idle first frame: " << juce::String (t.getStartupMillis(), 1)
+                          << " ms (trace: " << traceFile.getFullPathName() << ")" << std::endl;
+                quit();
+            }
+        };
+
+        GK_TRACE_SCOPE ("JUCEApplication::initialise");
+        mainWindow = std::make_unique<MainWindow>(getApplicationName(), ! isBenchmark);
     }
 
     void shutdown() override
@@ -23,7 +81,7 @@ public:
     class MainWindow final : public juce::DocumentWindow
     {
     public:
-        explicit MainWindow (const juce::String& name)
+        MainWindow (const juce::String& name, bool showInspector)
             : juce::DocumentWindow (name,
                   juce::Desktop::getInstance().getDefaultLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId),
                   juce::DocumentWindow::allButtons)
@@ -33,7 +91,7 @@ public:
             setResizable (true, true);
             centreWithSize (getWidth(), getHeight());
             Component::setVisible (true);
-            inspector.setVisible (true);
+            inspector.setVisible (showInspector);
             juce::Logger::outputDebugString ("== APP STARTED ==");
         }
 
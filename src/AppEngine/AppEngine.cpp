@@ -8,6 +8,7 @@
 #include "../UI/Plugins/Synthesizer/MorphSynthView.h"
 #include "../UI/Plugins/Synthesizer/MorphSynthWindow.h"
 #include "GrooveKitUIBehaviour.h"
+#include "StartupTrace.h"
 #include "TrackManager.h"
 #include <tracktion_engine/tracktion_engine.h>
 
@@ -79,15 +80,32 @@ namespace
 
 AppEngine::AppEngine()
 {
-    engine = std::make_unique<te::Engine> (
-        "GrooveKitEngine",
-        std::make_unique<GrooveKitUIBehaviour>(),
-        nullptr
-    );
+    GK_TRACE_SCOPE ("AppEngine::AppEngine");
 
-    registerMorphSynthCompat(*engine);
+    {
+        GK_TRACE_SCOPE ("te::Engine");
 
-    createOrLoadEdit();
+        engine = std::make_unique<te::Engine> (
+            "GrooveKitEngine",
+            std::make_unique<GrooveKitUIBehaviour>(),
+            nullptr
+        );
+
+        registerMorphSynthCompat(*engine);
+        registerMeterTap(*engine);
+    }
+
+    // A journal left behind by a crash is set aside before this session starts its own
+    if (AutosaveJournal::hasRecoverableSession (getAutosaveDirectory()))
+    {
+        getRecoveredSessionDirectory().deleteRecursively();
+        getAutosaveDirectory().moveFileTo (getRecoveredSessionDirectory());
+    }
+
+    {
+        GK_TRACE_SCOPE ("createOrLoadEdit");
+        createOrLoadEdit();
+    }
 
     midiEngine = std::make_unique<MIDIEngine> (*edit);
     audioEngine = std::make_unique<AudioEngine> (*edit, *engine);
@@ -96,15 +114,34 @@ AppEngine::AppEngine()
     midiListener = std::make_unique<MidiListener> (this);
     midiRecorder = std::make_unique<MidiRecorder> (*engine);
 
+    trackFreezer = std::make_unique<TrackFreezer> (*engine);
+    trackFreezer->onChange = [this] { freezeBroadcaster.sendChangeMessage(); };
+    trackFreezer->onFreezeFailed = [] (const juce::String& trackName, const juce::String& error)
+    {
+        juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon,
+                                                "Freeze failed",
+                                                "Couldn't freeze \"" + trackName + "\".\n" + error);
+    };
+
+    dspLoadMonitor = std::make_unique<DspLoadMonitor> ([this] { return edit.get(); });
+    dspLoadMonitor->onChange = [this] { dspLoadBroadcaster.sendChangeMessage(); };
+
     qwertyForwarder_ = std::make_unique<MidiListenerKeyAdapter>(*midiListener);
 
     editViewState = std::make_unique<EditViewState> (*edit, *selectionManager);
 
-    audioEngine->initialiseDefaults (48000.0, 512);
+    {
+        GK_TRACE_SCOPE ("Open audio device");
+        audioEngine->initialiseDefaults (48000.0, 512);
+    }
 
-    // Setup MIDI input devices using Tracktion's InputDevice system
-    // CRITICAL: This must be called BEFORE restartPlayback() to ensure proper MIDI routing
-    audioEngine->setupMidiInputDevices(*edit);
+    {
+        GK_TRACE_SCOPE ("MIDI input setup");
+
+        // Setup MIDI input devices using Tracktion's InputDevice system
+        // CRITICAL: This must be called BEFORE restartPlayback() to ensure proper MIDI routing
+        audioEngine->setupMidiInputDevices(*edit);
+    }
 
     // Now restart playback with MIDI devices properly enabled
     edit->restartPlayback();
@@ -114,6 +151,14 @@ AppEngine::~AppEngine()
 {
     // Signal shutdown early so UI listeners don't touch the registry while we tear down
     shuttingDown = true;
+    // A load still being swapped in holds edits, which must go before the engine
+    editInstallJob.reset();
+    // Clean exit: nothing to recover next launch
+    autosaveJournal.stop (true);
+    // Stop any export renders; their private edits must go before the engine
+    audioExporter.reset();
+    trackFreezer.reset();
+    dspLoadMonitor.reset();
     // Clear listener map defensively to release any dangling pointers
     trackListenerMap.clear();
 }
@@ -169,12 +214,15 @@ void AppEngine::createOrLoadEdit()
     edit->clickTrackEmphasiseBars = true;  // Emphasize downbeats with different click sample
 
     markSaved();
+    startAutosaveJournal();
     // NOTE: restartPlayback() moved to AppEngine constructor after MIDI setup
 }
 
 void AppEngine::newUntitledEdit()
 {
     closeInstrumentWindow();
+    autosaveJournal.stop (true);
+    trackFreezer->cancelAll();
 
     audioEngine.reset();
 
@@ -205,6 +253,7 @@ void AppEngine::newUntitledEdit()
         trackManager->setPluginManager (pluginManager.get());
 
     markSaved();
+    startAutosaveJournal();
 
     audioEngine->initialiseDefaults (48000.0, 512);
     audioEngine->setupMidiInputDevices(*edit);
@@ -320,6 +369,17 @@ tracktion::TimeRange AppEngine::getRecordingPreviewBounds() const
     return tracktion::TimeRange();
 }
 
+void AppEngine::setLoopRecordMode (MidiRecorder::LoopRecordMode mode)
+{
+    if (midiRecorder)
+        midiRecorder->setLoopRecordMode (mode);
+}
+
+MidiRecorder::LoopRecordMode AppEngine::getLoopRecordMode() const
+{
+    return midiRecorder ? midiRecorder->getLoopRecordMode() : MidiRecorder::LoopRecordMode::replace;
+}
+
 //==============================================================================
 // Transport Control
 
@@ -506,6 +566,8 @@ void AppEngine::setBpm (double newBpm)
 
 void AppEngine::initialise()
 {
+    GK_TRACE_SCOPE ("AppEngine::initialise");
+
     // --- App support dir (for caches, dead-mans file, etc.) ---
    #if JUCE_MAC
     auto appSupport = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
@@ -516,16 +578,7 @@ void AppEngine::initialise()
    #endif
     appSupport.createDirectory();
 
-    // --- Your app-level plugin manager (keep as-is) ---
-    PluginManager::Settings pmSettings;
-    pmSettings.appDataDir      = appSupport;
-    pmSettings.scanAudioUnits  = true;
-    pmSettings.scanVST3        = true;
-
-    pluginManager = std::make_unique<PluginManager>(*edit, pmSettings);
-    trackManager->setPluginManager(pluginManager.get());
-
-    // --- NEW: Initialise Tracktion Engine's PluginManager too ---
+    // --- Tracktion Engine's PluginManager: ExternalPlugin resolves/instantiates using its list+formats ---
     auto& tePM = engine->getPluginManager();
 
     // Add formats we intend to host (guarded by JUCE host flags)
@@ -536,50 +589,32 @@ void AppEngine::initialise()
     tePM.pluginFormatManager.addFormat(new juce::VST3PluginFormat());
    #endif
 
-    // Do a quick blocking scan once so TE's knownPluginList is populated.
-    // ExternalPlugin resolves/instantiates using *this* list+formats.
-    {
-        juce::FileSearchPath searchPaths;
-       #if JUCE_MAC
-        // AU locations (Components) — TE will use these only for AU formats
-        searchPaths.add(juce::File("/Library/Audio/Plug-Ins/Components"));
-        searchPaths.add(juce::File("~/Library/Audio/Plug-Ins/Components"));
-
-        // VST3 locations
-        searchPaths.add(juce::File("/Library/Audio/Plug-Ins/VST3"));
-        searchPaths.add(juce::File("~/Library/Audio/Plug-Ins/VST3"));
-       #endif
-
-        static juce::File teDeadMans = appSupport.getChildFile("TE_ScanDeadMans.txt");
-
-        for (int i = 0; i < tePM.pluginFormatManager.getNumFormats(); ++i)
-        {
-            auto* fmt = tePM.pluginFormatManager.getFormat(i);
-            if (!fmt) continue;
-
-            DBG("[TE-PM] Scan started for format: " + fmt->getName()
-                + " paths: " + searchPaths.toString());
-
-            juce::PluginDirectoryScanner scanner(tePM.knownPluginList,
-                                                 *fmt,
-                                                 searchPaths,
-                                                 /*recursive*/ true,
-                                                 teDeadMans,
-                                                 /*allowAsync*/ false);
+    // --- App-level plugin manager ---
+    // Both known lists are filled from the persistent scan cache straight away; the
+    // incremental scan then runs in the background and only touches new/changed plugins,
+    // so startup never waits on plugin instantiation. Plugins are instantiated in child
+    // processes of this executable (see main.cpp), so one that hangs or crashes is
+    // blacklisted rather than taking the app down.
+    PluginManager::Settings pmSettings;
+    pmSettings.appDataDir        = appSupport;
+    pmSettings.scanAudioUnits    = true;
+    pmSettings.scanVST3          = true;
+    pmSettings.mirrorList        = &tePM.knownPluginList;
+    pmSettings.scanWorkerCommand = { juce::File::getSpecialLocation(juce::File::currentExecutableFile).getFullPathName() };
 
-            juce::String err;
-            while (scanner.scanNextFile(true, err))
-                ; // pump scan
+    {
+        GK_TRACE_SCOPE ("PluginManager (scan cache)");
+        pluginManager = std::make_unique<PluginManager>(*edit, pmSettings);
+    }
 
-            if (err.isNotEmpty())
-                DBG("[TE-PM] Scanner reported: " + err);
-        }
+    trackManager->setPluginManager(pluginManager.get());
 
-        DBG("[TE-PM] Scan finished. TE known types: "
-            + juce::String(tePM.knownPluginList.getNumTypes()));
-    }
+    // Shows in the startup trace only if it finishes before the first idle frame
+    pluginManager->onScanFinished = [scanStart = StartupTrace::getInstance().now()] {
+        auto& trace = StartupTrace::getInstance();
+        trace.addAsyncPhase("Plugin scan (background)", scanStart, trace.now());
+    };
 
-    // You can still keep your async scan/UI for your own list
     pluginManager->scanForPluginsAsync();
 
     // --- Ensure playback graph exists (useful for live monitoring) ---
@@ -636,12 +671,11 @@ void AppEngine::markSaved()
     lastSavedTxn = currentUndoTxn();
 }
 
-bool AppEngine::writeEditToFile (const juce::File& file)
+void AppEngine::flushPluginState()
 {
     if (! edit)
-        return false;
+        return;
 
-    // 1) Flush plugin state into the edit's ValueTree
     for (auto* track : te::getAudioTracks (*edit))
     {
         if (! track)
@@ -662,41 +696,66 @@ bool AppEngine::writeEditToFile (const juce::File& file)
             }
         }
     }
+}
 
-    // 2) Now serialize the edit
-    if (auto xml = edit->state.createXml())
+juce::ValueTree AppEngine::createSaveSnapshot()
+{
+    if (! edit)
+        return {};
+
+    // Plugin state must be in the tree before it is copied
+    flushPluginState();
+    return edit->state.createCopy();
+}
+
+void AppEngine::writeEditToFileAsync (const juce::File& file, bool markAsSaved,
+                                      std::function<void (bool)> onDone)
+{
+    if (! edit)
     {
-        juce::TemporaryFile tf (file);
+        if (onDone)
+            onDone (false);
+        return;
+    }
+
+    // Snapshot on the message thread; serialising and writing happen on the saver's thread.
+    // The undo position and edit identity are captured now so a save that finishes after
+    // further edits (or after a different edit was loaded) doesn't mark the wrong state clean.
+    const int txn = currentUndoTxn();
+    auto editState = edit->state;
 
-        if (tf.getFile().replaceWithText (xml->toString())
-            && tf.overwriteTargetFileWithTemporary())
+    projectSaver.saveAsync (createSaveSnapshot(), file,
+        [this, file, txn, editState, markAsSaved, onDone = std::move (onDone)] (bool ok)
         {
-            DBG ("Saved edit to: " << file.getFullPathName());
-            return true;
-        }
-    }
+            const bool sameEdit = edit != nullptr && edit->state == editState;
 
-    return false;
+            if (ok && markAsSaved && sameEdit)
+                lastSavedTxn = txn;
+
+            if (ok)
+                DBG ("Saved edit to: " << file.getFullPathName());
+
+            if (onDone)
+                onDone (ok && sameEdit);
+        });
 }
 
-bool AppEngine::saveEdit()
+void AppEngine::saveEdit (std::function<void (bool)> onDone)
 {
     if (!edit)
-        return false;
+    {
+        if (onDone)
+            onDone (false);
+        return;
+    }
 
     if (currentEditFile.getFullPathName().isNotEmpty())
     {
-        const bool ok = writeEditToFile (currentEditFile);
-        if (ok)
-        {
-            markSaved();
-        }
-
-        return ok;
+        writeEditToFileAsync (currentEditFile, true, std::move (onDone));
+        return;
     }
 
-    saveEditAsAsync();
-    return false;
+    saveEditAsAsync (std::move (onDone));
 }
 
 void AppEngine::saveEditAsAsync (std::function<void (bool)> onDone)
@@ -709,7 +768,7 @@ void AppEngine::saveEditAsAsync (std::function<void (bool)> onDone)
 
     auto chooser = std::make_shared<juce::FileChooser> ("Save Project As...",
         defaultDir,
-        "*.tracktionedit;*.xml");
+        "*.tracktionedit;*.gkproj;*.xml");
 
     chooser->launchAsync (juce::FileBrowserComponent::saveMode
                               | juce::FileBrowserComponent::canSelectFiles,
@@ -722,20 +781,29 @@ void AppEngine::saveEditAsAsync (std::function<void (bool)> onDone)
                 return;
             }
 
-            auto chosen = result.withFileExtension (".tracktionedit");
-            const bool ok = writeEditToFile (chosen);
-            if (ok)
-            {
-                currentEditFile = chosen;
-                if (edit)
-                    edit->editFileRetriever = [f = currentEditFile] { return f; };
-                markSaved();
-            }
-            if (onDone)
-                onDone (ok);
+            // The extension picks the format; anything else gets the default one
+            auto chosen = result.hasFileExtension (ProjectSaver::binaryExtension) || result.hasFileExtension (".tracktionedit")
+                              ? result
+                              : result.withFileExtension (getDefaultProjectExtension());
+            writeEditToFileAsync (chosen, true, [this, chosen, onDone] (const bool ok) {
+                if (ok)
+                {
+                    currentEditFile = chosen;
+                    if (edit)
+                        edit->editFileRetriever = [f = currentEditFile] { return f; };
+                    autosaveJournal.setEditFile (currentEditFile);
+                }
+                if (onDone)
+                    onDone (ok);
+            });
         });
 }
 
+bool AppEngine::isSaving() const noexcept
+{
+    return projectSaver.isSaving();
+}
+
 void AppEngine::setAutosaveMinutes (int minutes)
 {
     if (minutes <= 0)
@@ -746,19 +814,82 @@ void AppEngine::setAutosaveMinutes (int minutes)
     startTimer (juce::jmax (1, minutes) * 60 * 1000);
 }
 
-juce::File AppEngine::getAutosaveFile() const
+void AppEngine::setDefaultProjectFormat (ProjectSaver::Format format) noexcept
 {
-    if (currentEditFile.getFullPathName().isNotEmpty())
-        return currentEditFile.getSiblingFile (currentEditFile.getFileNameWithoutExtension()
-                                               + "_autosave.tracktionedit");
-    return juce::File::getSpecialLocation (juce::File::tempDirectory)
-        .getChildFile ("groovekit_autosave.tracktionedit");
+    defaultProjectFormat = format;
+}
+
+juce::String AppEngine::getDefaultProjectExtension() const
+{
+    return defaultProjectFormat == ProjectSaver::Format::binary ? ProjectSaver::binaryExtension
+                                                               : ".tracktionedit";
+}
+
+juce::File AppEngine::getAutosaveDirectory() const
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+        .getChildFile ("GrooveKit")
+        .getChildFile ("Autosave");
+}
+
+juce::File AppEngine::getRecoveredSessionDirectory() const
+{
+    return getAutosaveDirectory().getSiblingFile ("Autosave-recovered");
+}
+
+void AppEngine::startAutosaveJournal()
+{
+    if (edit)
+        autosaveJournal.start (getAutosaveDirectory(), edit->state, currentEditFile);
 }
 
 void AppEngine::timerCallback()
 {
-    if (isDirty())
-        writeEditToFile (getAutosaveFile());
+    // Journal records each change as it happens; the timer only folds them into a fresh
+    // snapshot (and captures plugin state, which isn't in the tree until flushed)
+    if (autosaveJournal.isActive() && autosaveJournal.getBytesSinceCompaction() > 0)
+    {
+        flushPluginState();
+        autosaveJournal.compact();
+    }
+}
+
+bool AppEngine::hasRecoverableSession() const
+{
+    return AutosaveJournal::hasRecoverableSession (getRecoveredSessionDirectory());
+}
+
+bool AppEngine::recoverAutosavedSession()
+{
+    juce::File originalFile;
+    const auto state = AutosaveJournal::recover (getRecoveredSessionDirectory(), &originalFile);
+    if (! state.isValid())
+        return false;
+
+    // Load through the normal path so the engine, tracks and plugins are set up as usual
+    juce::TemporaryFile recovered (ProjectSaver::binaryExtension);
+    if (! ProjectSaver::writeSnapshot (state, recovered.getFile())
+        || ! loadEditFromFile (recovered.getFile()))
+        return false;
+
+    auto placeholder = juce::File::getSpecialLocation (juce::File::userDocumentsDirectory)
+                           .getChildFile ("GrooveKit")
+                           .getNonexistentChildFile ("Recovered", ".tracktionedit", false);
+
+    currentEditFile = originalFile;
+    edit->editFileRetriever = [f = originalFile != juce::File() ? originalFile : placeholder] { return f; };
+    autosaveJournal.setEditFile (currentEditFile);
+
+    // Recovered work hasn't been saved anywhere yet
+    lastSavedTxn = -1;
+
+    discardRecoveredSession();
+    return true;
+}
+
+void AppEngine::discardRecoveredSession()
+{
+    getRecoveredSessionDirectory().deleteRecursively();
 }
 
 void AppEngine::openEditAsync (std::function<void (bool)> onDone)
@@ -770,34 +901,188 @@ void AppEngine::openEditAsync (std::function<void (bool)> onDone)
     startDir.createDirectory();
 
     auto chooser = std::make_shared<juce::FileChooser> (
-        "Open Project...", startDir, "*.tracktionedit;*.xml");
+        "Open Project...", startDir, "*.tracktionedit;*.gkproj;*.xml");
 
     chooser->launchAsync (juce::FileBrowserComponent::openMode
                               | juce::FileBrowserComponent::canSelectFiles,
         [this, chooser, onDone] (const juce::FileChooser& fc) {
             auto f = fc.getResult();
-            bool ok = false;
-            if (f != juce::File {})
-                ok = loadEditFromFile (f);
+            if (f == juce::File {})
+            {
+                if (onDone)
+                    onDone (false);
+                return;
+            }
 
-            if (onDone)
-                onDone (ok);
+            loadEditAsync (f, onDone);
         });
 }
 
-bool AppEngine::loadEditFromFile (const juce::File& file)
+//==============================================================================
+/**
+ * Runs the message-thread part of loadEditAsync: one stage per message-loop
+ * turn, reporting its name before it starts, so the UI repaints in between.
+ * A stage returning false ends the job as failed. Destroying the job abandons
+ * the stages that haven't run (and whatever they captured).
+ */
+class AppEngine::EditInstallJob : private juce::Timer
 {
-    closeInstrumentWindow();
+public:
+    struct Stage
+    {
+        juce::String name;
+        double progress;               ///< Overall progress when the stage starts.
+        std::function<bool()> run;
+    };
+
+    EditInstallJob (std::vector<Stage> stagesToRun,
+                    std::function<void (double, const juce::String&)> onProgressToUse,
+                    std::function<void (bool)> onFinishedToUse)
+        : stages (std::move (stagesToRun)),
+          onProgress (std::move (onProgressToUse)),
+          onFinished (std::move (onFinishedToUse))
+    {
+        jassert (! stages.empty());
+        reportNextStage();
+        startTimer (1);
+    }
 
+private:
+    void timerCallback() override
+    {
+        stopTimer();
+
+        const bool ok = stages[next++].run();
+
+        if (! ok || next == stages.size())
+        {
+            auto finished = onFinished;   // a copy, as it may delete this job
+            finished (ok);
+            return;
+        }
+
+        reportNextStage();
+        startTimer (1);
+    }
+
+    void reportNextStage()
+    {
+        if (onProgress)
+            onProgress (stages[next].progress, stages[next].name);
+    }
+
+    std::vector<Stage> stages;
+    size_t next = 0;
+    std::function<void (double, const juce::String&)> onProgress;
+    std::function<void (bool)> onFinished;
+};
+
+void AppEngine::loadEditAsync (const juce::File& file, std::function<void (bool)> onDone)
+{
+    // A newer load replaces one that is still being swapped in
+    editInstallJob.reset();
+
+    // Share of the progress bar for reading the file; the message-thread stages take the rest
+    constexpr double readShare = 0.5;
+
+    auto finish = [this, onDone] (bool ok)
+    {
+        if (onLoadProgress)
+            onLoadProgress (1.0, ok ? "Done" : "Failed");
+
+        if (onDone)
+            onDone (ok);
+    };
+
+    // Reading and parsing run on the loader's thread; the current edit stays
+    // live until the new one is swapped in
+    projectLoader.loadAsync (file,
+        [this] (double progress, const juce::String& stage)
+        {
+            if (onLoadProgress)
+                onLoadProgress (progress * readShare, stage);
+        },
+        [this, finish] (std::shared_ptr<ProjectLoader::Result> result)
+        {
+            if (! result->state.isValid() || ! engine)
+            {
+                DBG ("[AppEngine] Load failed: " << result->error);
+                finish (false);
+                return;
+            }
+
+            struct Edits { std::unique_ptr<te::Edit> loaded, previous; };
+            auto edits = std::make_shared<Edits>();
+
+            // Tracktion creates the Edit and its plugins on the message thread, so that
+            // stage can't be split further; the old edit is destroyed in a later turn
+            std::vector<EditInstallJob::Stage> stages {
+                { "Creating edit", readShare, [this, edits, result]
+                    {
+                        edits->loaded = te::loadEditFromState (*engine, result->state, te::Edit::forEditing);
+                        return edits->loaded != nullptr;
+                    } },
+                { "Setting up tracks", 0.8, [this, edits, result]
+                    {
+                        edits->previous = installEdit (std::move (edits->loaded), result->file);
+                        return true;
+                    } },
+                { "Starting playback", 0.9, [this]
+                    {
+                        edit->restartPlayback();  // Rebuild playback graph with MIDI devices enabled
+                        return true;
+                    } },
+                { "Closing previous project", 0.95, [edits]
+                    {
+                        edits->previous.reset();
+                        return true;
+                    } }
+            };
+
+            editInstallJob = std::make_unique<EditInstallJob> (std::move (stages), onLoadProgress,
+                [this, finish] (bool ok)
+                {
+                    editInstallJob.reset();
+                    finish (ok);
+                });
+        });
+}
+
+bool AppEngine::isLoadingEdit() const noexcept
+{
+    return projectLoader.isLoading() || editInstallJob != nullptr;
+}
+
+bool AppEngine::loadEditFromFile (const juce::File& file)
+{
     if (!file.existsAsFile() || !engine)
         return false;
 
-    auto newEdit = tracktion::loadEditFromFile (*engine, file);
+    projectLoader.cancel();
+    editInstallJob.reset();
+
+    const auto result = ProjectLoader::load (file);
+    if (!result->state.isValid())
+        return false;
+
+    auto newEdit = te::loadEditFromState (*engine, result->state, te::Edit::forEditing);
     if (!newEdit)
         return false;
 
+    installEdit (std::move (newEdit), file);
+    edit->restartPlayback();  // Rebuild playback graph with MIDI devices enabled
+    return true;
+}
+
+std::unique_ptr<te::Edit> AppEngine::installEdit (std::unique_ptr<te::Edit> newEdit, const juce::File& file)
+{
+    closeInstrumentWindow();
+    autosaveJournal.stop (true);
+    trackFreezer->cancelAll();
     audioEngine.reset();
 
+    // Kept alive until everything below that refers to it has been replaced
+    auto previousEdit = std::move (edit);
     edit = std::move (newEdit);
     currentEditFile = file;
     edit->editFileRetriever = [f = currentEditFile] { return f; };
@@ -817,27 +1102,29 @@ bool AppEngine::loadEditFromFile (const juce::File& file)
 
 
     audioEngine = std::make_unique<AudioEngine> (*edit, *engine);
-    audioEngine->initialiseDefaults (48000.0, 512);
-    audioEngine->setupMidiInputDevices(*edit);
 
-    edit->restartPlayback();  // Rebuild playback graph with MIDI devices enabled
+    // The device is shared by every edit; only configure it if nothing is open yet
+    if (engine->getDeviceManager().deviceManager.getCurrentAudioDevice() == nullptr)
+        audioEngine->initialiseDefaults (48000.0, 512);
+
+    audioEngine->setupMidiInputDevices(*edit);
 
     for (auto* track : te::getAudioTracks (*edit))
     {
         if (!track) continue;
 
         for (auto* p : track->pluginList)
-            if (auto* morph = dynamic_cast<MorphSynthPlugin*> (p))
-                if (morph->state.isValid())
-                    morph->restoreFromValueTree (morph->state);
+            if (auto* morph = dynamic_cast<MorphSynthPlugin*> (p); morph != nullptr && morph->state.isValid())
+                morph->restoreFromValueTree (morph->state);
     }
 
     markSaved();
+    startAutosaveJournal();
 
     if (onEditLoaded)
         onEditLoaded();
 
-    return true;
+    return previousEdit;
 }
 
 void AppEngine::openInstrumentEditor (int trackIndex)
@@ -1267,6 +1554,62 @@ juce::String AppEngine::getInsertSlotLabel (int trackIndex, int slotIndex) const
     return {};
 }
 
+DspLoadMonitor::Load AppEngine::getTrackDspLoad (int trackIndex) const
+{
+    if (dspLoadMonitor && trackManager)
+        if (auto* track = trackManager->getTrack (trackIndex))
+            return dspLoadMonitor->getTrackLoad (*track);
+
+    return {};
+}
+
+DspLoadMonitor::Load AppEngine::getInstrumentDspLoad (int trackIndex) const
+{
+    if (dspLoadMonitor && trackManager)
+        if (auto* plug = trackManager->getInstrumentPluginOnTrack (trackIndex))
+            return dspLoadMonitor->getPluginLoad (*plug);
+
+    return {};
+}
+
+DspLoadMonitor::Load AppEngine::getInsertSlotDspLoad (int trackIndex, int slotIndex) const
+{
+    if (!dspLoadMonitor || !trackManager)
+        return {};
+
+    auto* track = trackManager->getTrack (trackIndex);
+    if (!track)
+        return {};
+
+    const int pluginIndex = trackManager->getFxInsertBaseIndex (trackIndex) + slotIndex;
+
+    if (pluginIndex < 0 || pluginIndex >= track->pluginList.size())
+        return {};
+
+    if (auto* plug = track->pluginList[pluginIndex])
+        return dspLoadMonitor->getPluginLoad (*plug);
+
+    return {};
+}
+
+juce::Result AppEngine::saveDspLoadReport (const juce::File& file) const
+{
+    if (!dspLoadMonitor)
+        return juce::Result::fail ("No DSP load figures have been collected");
+
+    return dspLoadMonitor->writeCsv (file);
+}
+
+MeterTapPlugin* AppEngine::getTrackMeterTap (int trackIndex)
+{
+    return trackManager ? trackManager->getMeterTap (trackIndex) : nullptr;
+}
+
+MeterTapPlugin* AppEngine::getMasterMeterTap()
+{
+    return trackManager ? trackManager->getMasterMeterTap() : nullptr;
+}
+
 bool AppEngine::addMidiClipToTrackAt(int trackIndex, t::TimePosition start, t::BeatDuration length)
 {
     if (!midiEngine)
@@ -1493,50 +1836,126 @@ bool AppEngine::canPasteToTrack (int trackIndex) const
     return lastCopiedClipWasDrum == targetIsDrum;
 }
 
-bool AppEngine::exportAudio (const juce::File& destFile)
+double AppEngine::getExportSampleRate() const
 {
-    if (edit == nullptr)
+    const auto sampleRate = engine->getDeviceManager().getSampleRate();
+    return sampleRate > 0.0 ? sampleRate : 48000.0;
+}
+
+bool AppEngine::exportAudio (const juce::File& destFile,
+                             AudioExporter::ProgressCallback onProgress,
+                             AudioExporter::CompletionCallback onComplete)
+{
+    if (edit == nullptr || isExporting())
         return false;
 
-    auto parentDir = destFile.getParentDirectory();
-    if (! parentDir.exists())
-        parentDir.createDirectory();
+    if (audioExporter == nullptr)
+        audioExporter = std::make_unique<AudioExporter> (*engine);
 
+    // The render runs on a private copy, so the live graph is only paused to free the CPU.
+    // Remember where it was so the user comes back to the same spot.
     auto& transport = edit->getTransport();
     const bool wasPlaying = transport.isPlaying();
+    const auto position = transport.getPosition();
+    const auto* exportedEdit = edit.get();
+
     if (wasPlaying)
         transport.stop (false, false);
 
-    juce::BigInteger tracksToDo;
+    auto restoreTransport = [this, wasPlaying, position, exportedEdit]
     {
-        auto allTracks = te::getAllTracks (*edit);
-        for (int i = 0; i < allTracks.size(); ++i)
-            tracksToDo.setBit (i);
-    }
+        // A different project may have been opened meanwhile
+        if (edit == nullptr || edit.get() != exportedEdit)
+            return;
 
-    const auto start  = t::TimePosition::fromSeconds (0.0);
-    const auto length = edit->getLength();
-    const t::TimeRange range { start, length };
+        auto& liveTransport = edit->getTransport();
+        liveTransport.setPosition (position);
 
-    const bool usePlugins = true;
-    const bool useThread  = false;
+        if (wasPlaying)
+            liveTransport.play (false);
+    };
 
     DBG ("[Export] Rendering audio to: " << destFile.getFullPathName());
-    DBG ("[Export] Edit length (seconds): " << length.inSeconds());
+    DBG ("[Export] Edit length (seconds): " << edit->getLength().inSeconds());
 
-    const bool ok = te::Renderer::renderToFile ("Export audio",
-                                                destFile,
-                                                *edit,
-                                                range,
-                                                tracksToDo,
-                                                usePlugins,
-                                                useThread);
+    const bool started = audioExporter->startMixdown (createSaveSnapshot(), currentEditFile, destFile, getExportSampleRate(),
+        std::move (onProgress),
+        [restoreTransport, onComplete = std::move (onComplete)] (const AudioExporter::Result& result)
+        {
+            DBG (juce::String ("[Export] Render ") + (result.ok ? "OK" : result.cancelled ? "CANCELLED" : "FAILED"));
 
-    te::TransportControl::restartAllTransports (*engine, true);
-    if (wasPlaying && ok)
-        transport.play (false);
+            restoreTransport();
 
-    DBG (juce::String ("[Export] Render ") + (ok ? "OK" : "FAILED"));
+            if (onComplete)
+                onComplete (result);
+        });
+
+    if (! started)
+        restoreTransport();
+
+    return started;
+}
+
+bool AppEngine::exportStems (const juce::File& destDir,
+                             AudioExporter::ProgressCallback onProgress,
+                             AudioExporter::CompletionCallback onComplete)
+{
+    if (edit == nullptr || isExporting())
+        return false;
+
+    if (audioExporter == nullptr)
+        audioExporter = std::make_unique<AudioExporter> (*engine);
+
+    const auto baseName = currentEditFile != juce::File() ? currentEditFile.getFileNameWithoutExtension()
+                                                          : juce::String ("GrooveKit");
+
+    DBG ("[Export] Rendering stems to: " << destDir.getFullPathName());
+
+    return audioExporter->startStems (createSaveSnapshot(), currentEditFile, destDir, baseName, getExportSampleRate(),
+                                      std::move (onProgress), std::move (onComplete));
+}
+
+void AppEngine::cancelExport()
+{
+    if (audioExporter != nullptr)
+        audioExporter->cancel();
+}
+
+//==============================================================================
+// Track freeze
+
+void AppEngine::setTrackFrozen (int trackIndex, bool shouldBeFrozen)
+{
+    auto* track = trackManager->getTrack (trackIndex);
+    if (track == nullptr)
+        return;
+
+    if (! shouldBeFrozen)
+    {
+        trackFreezer->unfreeze (*track);
+        return;
+    }
+
+    // A frozen track can't be played from the keyboard, so it can't stay armed either
+    if (getArmedTrackIndex() == trackIndex)
+        setArmedTrack (-1);
+
+    if (! trackFreezer->freeze (*track, createSaveSnapshot(), currentEditFile, getExportSampleRate()))
+        freezeBroadcaster.sendChangeMessage();   // let the toggle snap back
+}
+
+TrackFreezer::State AppEngine::getTrackFreezeState (int trackIndex) const
+{
+    if (auto* track = trackManager->getTrack (trackIndex))
+        return trackFreezer->getState (*track);
+
+    return TrackFreezer::State::live;
+}
+
+double AppEngine::getTrackFreezeProgress (int trackIndex) const
+{
+    if (auto* track = trackManager->getTrack (trackIndex))
+        return trackFreezer->getProgress (*track);
 
-    return ok;
+    return 0.0;
 }
@@ -7,6 +7,12 @@
 #include "TrackManager.h"
 #include "MidiListener.h"
 #include "MidiRecorder.h"
+#include "ProjectSaver.h"
+#include "AutosaveJournal.h"
+#include "ProjectLoader.h"
+#include "AudioExporter.h"
+#include "TrackFreezer.h"
+#include "DspLoadMonitor.h"
 #include <tracktion_engine/tracktion_engine.h>
 struct MidiListenerKeyAdapter;
 namespace IDs
@@ -260,6 +266,20 @@ public:
      */
     tracktion::TimeRange getRecordingPreviewBounds() const;
 
+    /**
+     * @brief Sets how loop recording treats each pass (replace, overdub or take lanes).
+     *
+     * @param mode The loop recording mode; applies from the next loop wrap.
+     */
+    void setLoopRecordMode (MidiRecorder::LoopRecordMode mode);
+
+    /**
+     * @brief Returns the current loop recording mode.
+     *
+     * @return The loop recording mode.
+     */
+    MidiRecorder::LoopRecordMode getLoopRecordMode() const;
+
     /**
      * @brief Callback invoked after recording stops and clips are finalized.
      *
@@ -330,6 +350,14 @@ public:
      */
     bool setSampleRate (double sampleRate)                 { return audioEngine->setSampleRate (sampleRate); }
 
+    /**
+     * @brief Returns the audio callback monitor (timing histogram, near misses, xruns).
+     *
+     * Belongs to the current AudioEngine, which is replaced with the edit, so
+     * don't hold on to the reference.
+     */
+    AudioCallbackMonitor& getCallbackMonitor()             { return audioEngine->getCallbackMonitor(); }
+
     //==============================================================================
     // MIDI Input Device Management
 
@@ -342,17 +370,43 @@ public:
      */
     juce::StringArray listMidiInputDevices()         const { return audioEngine->listMidiInputDevices(); }
 
-    bool saveEdit();
+    /**
+     * Saves to the current file in the background, or falls back to Save As when the
+     * edit has no file yet. @p onDone is called on the message thread once the file is on disk.
+     */
+    void saveEdit (std::function<void (bool success)> onDone = {});
     void saveEditAsAsync (std::function<void (bool success)> onDone = {});
+    /** Format used by Save As when the chosen name has no project extension. */
+    void setDefaultProjectFormat (ProjectSaver::Format format) noexcept;
+    ProjectSaver::Format getDefaultProjectFormat() const noexcept { return defaultProjectFormat; }
+    /** True while a save or autosave is being written on the background thread. */
+    bool isSaving() const noexcept;
 
     bool isDirty() const noexcept;
     const juce::File& getCurrentEditFile() const noexcept { return currentEditFile; }
 
     void setAutosaveMinutes (int minutes);
 
+    /** True if the previous run exited without shutting down and left an autosave journal. */
+    bool hasRecoverableSession() const;
+    /** Loads the previous run's autosaved state (snapshot + journal) as a dirty edit. */
+    bool recoverAutosavedSession();
+    void discardRecoveredSession();
+
     void openEditAsync (std::function<void (bool success)> onDone = {});
+    /**
+     * Loads @p file in the background (see ProjectLoader) and swaps it in when ready.
+     * The current edit keeps playing until then. Creating the Edit and swapping it in
+     * must happen on the message thread; they run in stages, one per message-loop turn,
+     * so the UI keeps repainting. @p onDone is called on the message thread.
+     */
+    void loadEditAsync (const juce::File& file, std::function<void (bool success)> onDone = {});
+    bool isLoadingEdit() const noexcept;
+    /** Blocking load, used when the result is needed immediately (e.g. session recovery). */
     bool loadEditFromFile (const juce::File& file);
     std::function<void()> onEditLoaded;
+    /** Progress of loadEditAsync (0..1 plus a stage name); the final call is always 1.0. */
+    std::function<void(double progress, const juce::String& stage)> onLoadProgress;
     std::function<void(double oldBpm, double newBpm, t::TimeRange oldLoopRange, t::TimePosition oldPlayheadPos)> onBpmChanged;
 
     void newUntitledEdit();
@@ -404,7 +458,78 @@ public:
 
     PluginManager& getPluginManager() { return *pluginManager; }
 
-    bool exportAudio (const juce::File& destFile);
+    /**
+     * @brief Renders the whole edit to @p destFile in the background.
+     *
+     * Playback is paused for the render so it gets the CPU, then the transport
+     * is put back where it was (position and play state), also on failure or
+     * cancel. Callbacks arrive on the message thread. Returns false if an export
+     * is already running or there is nothing to render.
+     */
+    bool exportAudio (const juce::File& destFile,
+                      AudioExporter::ProgressCallback onProgress,
+                      AudioExporter::CompletionCallback onComplete);
+
+    /**
+     * @brief Renders each AudioTrack, plus the master mix, to its own WAV in @p destDir.
+     *
+     * Renders run concurrently in the background; the live edit keeps playing.
+     * Callbacks arrive on the message thread. Returns false if an export is
+     * already running or there is nothing to render.
+     */
+    bool exportStems (const juce::File& destDir,
+                      AudioExporter::ProgressCallback onProgress,
+                      AudioExporter::CompletionCallback onComplete);
+
+    /** Stops a running mixdown or stem export and deletes its files. */
+    void cancelExport();
+
+    bool isExporting() const noexcept { return audioExporter != nullptr && audioExporter->isRunning(); }
+
+    //==============================================================================
+    // Track Freeze
+
+    /**
+     * @brief Freezes or unfreezes a track (see TrackFreezer).
+     *
+     * Freezing renders in the background and disarms the track; unfreezing a
+     * track that is still rendering cancels the render. Register with
+     * addFreezeListener to follow state and progress.
+     */
+    void setTrackFrozen (int trackIndex, bool shouldBeFrozen);
+
+    TrackFreezer::State getTrackFreezeState (int trackIndex) const;
+
+    /** Render progress (0..1) while the track is freezing. */
+    double getTrackFreezeProgress (int trackIndex) const;
+
+    /** Notified (asynchronously) whenever a track's freeze state or progress changes. */
+    void addFreezeListener (juce::ChangeListener* l)    { freezeBroadcaster.addChangeListener (l); }
+    void removeFreezeListener (juce::ChangeListener* l) { freezeBroadcaster.removeChangeListener (l); }
+
+    //==============================================================================
+    // DSP Load
+
+    /** Summed load of the track's measured plugins (see DspLoadMonitor). */
+    DspLoadMonitor::Load getTrackDspLoad (int trackIndex) const;
+    DspLoadMonitor::Load getInstrumentDspLoad (int trackIndex) const;
+    DspLoadMonitor::Load getInsertSlotDspLoad (int trackIndex, int slotIndex) const;
+
+    /** Writes every load figure collected this session to a CSV file. */
+    juce::Result saveDspLoadReport (const juce::File& file) const;
+
+    /** Notified after each DSP load poll (a few times a second). */
+    void addDspLoadListener (juce::ChangeListener* l)    { dspLoadBroadcaster.addChangeListener (l); }
+    void removeDspLoadListener (juce::ChangeListener* l) { dspLoadBroadcaster.removeChangeListener (l); }
+
+    //==============================================================================
+    // Level Metering
+
+    /** The track's meter tap (peak/RMS/LUFS, read lock-free at display rate), or nullptr. */
+    MeterTapPlugin* getTrackMeterTap (int trackIndex);
+
+    /** The master's meter tap; its readings are before the master fader. */
+    MeterTapPlugin* getMasterMeterTap();
 
 
 private:
@@ -437,11 +562,36 @@ private:
 
 
 
-    bool writeEditToFile (const juce::File& file);
+    ProjectSaver projectSaver;
+    AutosaveJournal autosaveJournal { projectSaver };
+    ProjectLoader projectLoader;
+    class EditInstallJob;
+    std::unique_ptr<EditInstallJob> editInstallJob; ///< Message-thread stages of loadEditAsync.
+    std::unique_ptr<AudioExporter> audioExporter; ///< Created on first use; owns edits on *engine.
+    std::unique_ptr<TrackFreezer> trackFreezer;   ///< Reset before *engine, like audioExporter.
+    juce::ChangeBroadcaster freezeBroadcaster;
+    std::unique_ptr<DspLoadMonitor> dspLoadMonitor;
+    juce::ChangeBroadcaster dspLoadBroadcaster;
+    ProjectSaver::Format defaultProjectFormat = ProjectSaver::Format::xml;
+
+    void flushPluginState();
+    juce::ValueTree createSaveSnapshot();
+    double getExportSampleRate() const;
+    void writeEditToFileAsync (const juce::File& file, bool markAsSaved,
+                               std::function<void (bool)> onDone);
+    /**
+     * Swaps @p newEdit in and rebuilds everything that refers to the edit. Playback
+     * isn't restarted (call edit->restartPlayback()). Returns the previous edit, which
+     * nothing refers to any more, so the caller can destroy it when convenient.
+     */
+    std::unique_ptr<te::Edit> installEdit (std::unique_ptr<te::Edit> newEdit, const juce::File& file);
     void markSaved();
     int currentUndoTxn() const;
 
-    juce::File getAutosaveFile() const;
+    juce::File getAutosaveDirectory() const;
+    juce::File getRecoveredSessionDirectory() const;
+    void startAutosaveJournal();
+    juce::String getDefaultProjectExtension() const;
     void timerCallback() override;
 
 
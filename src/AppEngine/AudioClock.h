@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <juce_audio_devices/juce_audio_devices.h>
+
+/**
+ * @brief Sample-accurate clock driven by the audio device callback.
+ *
+ * AudioClock counts samples processed by the audio device and publishes the
+ * sample position and wall-clock time of the most recent block. Any thread can
+ * then estimate the sample position "now" by interpolating from that block,
+ * without locks or calls into the transport.
+ *
+ * Architecture:
+ *  - Registered as an extra juce::AudioIODeviceCallback (outputs are cleared,
+ *    so it adds nothing to the mix)
+ *  - Block start (samples, ms) is published through a sequence lock built on
+ *    atomics; readers retry if they race a write
+ *  - Before the device has run, positions are derived from the millisecond
+ *    counter at the nominal sample rate so timestamps stay monotonic
+ *
+ * Usage:
+ *  - deviceManager.addAudioCallback(&clock) once, removeAudioCallback on shutdown
+ *  - getSamplePosition() from any thread (e.g. a MIDI input callback)
+ */
+class AudioClock : public juce::AudioIODeviceCallback
+{
+public:
+    //==============================================================================
+    // Reading (any thread, lock-free)
+
+    /**
+     * @brief Estimated sample position at the given millisecond counter time.
+     *
+     * Interpolates from the last published block, clamped to at most two
+     * blocks ahead so a stalled device cannot produce runaway positions.
+     *
+     * @param timeMs Time from juce::Time::getMillisecondCounterHiRes().
+     */
+    juce::int64 getSamplePositionAt(double timeMs) const noexcept
+    {
+        const auto block = readBlock();
+
+        if (!block.running)
+            return (juce::int64) std::llround(timeMs * 0.001 * block.sampleRate);
+
+        const double elapsed = juce::jmax(0.0, timeMs - block.timeMs) * 0.001 * block.sampleRate;
+        return block.startSample + (juce::int64) std::llround(juce::jmin(elapsed, 2.0 * block.numSamples));
+    }
+
+    /** Estimated sample position right now. */
+    juce::int64 getSamplePosition() const noexcept
+    {
+        return getSamplePositionAt(juce::Time::getMillisecondCounterHiRes());
+    }
+
+    /** Sample position at the start of the most recent block (matches the transport's block position). */
+    juce::int64 getBlockStartSample() const noexcept
+    {
+        const auto block = readBlock();
+        return block.running ? block.startSample : getSamplePosition();
+    }
+
+    /** Sample rate of the running device (or the nominal rate before it starts). */
+    double getSampleRate() const noexcept { return sampleRate.load(std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Writing (audio thread)
+
+    /**
+     * @brief Publishes a block of @p numSamples that started at @p timeMs.
+     *
+     * Called by the device callback; public so tests can drive the clock.
+     */
+    void publishBlock(int numSamples, double timeMs) noexcept
+    {
+        const auto seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        blockStartSample.store(nextBlockSample, std::memory_order_relaxed);
+        blockTimeMs.store(timeMs, std::memory_order_relaxed);
+        blockSize.store(numSamples, std::memory_order_relaxed);
+
+        sequence.store(seq + 2, std::memory_order_release);
+
+        nextBlockSample += numSamples;
+    }
+
+    /** Starts counting at @p rate. The position carries on from where it stopped. */
+    void start(double rate) noexcept
+    {
+        sampleRate.store(rate > 0.0 ? rate : nominalSampleRate, std::memory_order_relaxed);
+        blockSize.store(0, std::memory_order_relaxed);
+        running.store(true, std::memory_order_release);
+    }
+
+    /** Stops counting; readers fall back to the millisecond counter. */
+    void stop() noexcept { running.store(false, std::memory_order_release); }
+
+    //==============================================================================
+    // juce::AudioIODeviceCallback
+
+    void audioDeviceIOCallbackWithContext(const float* const*, int,
+                                          float* const* outputChannelData, int numOutputChannels,
+                                          int numSamples,
+                                          const juce::AudioIODeviceCallbackContext&) override
+    {
+        publishBlock(numSamples, juce::Time::getMillisecondCounterHiRes());
+
+        for (int ch = 0; ch < numOutputChannels; ++ch)
+            if (outputChannelData[ch] != nullptr)
+                juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+    }
+
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override
+    {
+        start(device != nullptr ? device->getCurrentSampleRate() : nominalSampleRate);
+    }
+
+    void audioDeviceStopped() override { stop(); }
+
+private:
+    //==============================================================================
+    struct Block
+    {
+        juce::int64 startSample = 0;
+        double timeMs = 0.0;
+        double sampleRate = 0.0;
+        int numSamples = 0;
+        bool running = false;
+    };
+
+    Block readBlock() const noexcept
+    {
+        Block b;
+        b.sampleRate = getSampleRate();
+        b.running = running.load(std::memory_order_acquire);
+
+        for (;;)
+        {
+            const auto before = sequence.load(std::memory_order_acquire);
+
+            b.startSample = blockStartSample.load(std::memory_order_relaxed);
+            b.timeMs = blockTimeMs.load(std::memory_order_relaxed);
+            b.numSamples = blockSize.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if ((before & 1u) == 0 && sequence.load(std::memory_order_relaxed) == before)
+                break;
+        }
+
+        // No block published yet since start(): nothing to interpolate from
+        b.running = b.running && b.numSamples > 0;
+        return b;
+    }
+
+    static constexpr double nominalSampleRate = 48000.0;
+
+    std::atomic<juce::uint32> sequence{0};                   ///< Even = stable, odd = write in progress.
+    std::atomic<juce::int64> blockStartSample{0};            ///< First sample of the last block.
+    std::atomic<double> blockTimeMs{0.0};                    ///< Millisecond counter at that block.
+    std::atomic<int> blockSize{0};                           ///< Length of the last block.
+    std::atomic<double> sampleRate{nominalSampleRate};       ///< Current device rate.
+    std::atomic<bool> running{false};                        ///< Device callback is active.
+
+    juce::int64 nextBlockSample = 0;                         ///< Audio thread only.
+};
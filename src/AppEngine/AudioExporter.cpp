@@ -0,0 +1,440 @@
+#include "AudioExporter.h"
+
+namespace t = tracktion;
+
+//==============================================================================
+// Construction
+
+AudioExporter::AudioExporter (te::Engine& e, int numThreads)
+    : engine (e),
+      pool (numThreads > 0 ? numThreads : juce::jmax (1, juce::SystemStats::getNumCpus()))
+{
+}
+
+AudioExporter::~AudioExporter()
+{
+    onComplete = nullptr;
+
+    if (isRunning())
+        finish (true);
+}
+
+//==============================================================================
+// Helpers
+
+juce::String AudioExporter::makeStemFileName (const juce::String& baseName, int stemNumber, const juce::String& trackName)
+{
+    const auto number = juce::String (stemNumber).paddedLeft ('0', 2);
+    return juce::File::createLegalFileName (baseName + " - " + number + " " + trackName.trim()) + ".wav";
+}
+
+double AudioExporter::estimateSecondsRemaining (double elapsedSeconds, double progress)
+{
+    // The first percent or so is dominated by plugin and file setup, so the rate isn't meaningful yet
+    if (progress < 0.02 || elapsedSeconds < 0.5)
+        return -1.0;
+
+    if (progress >= 1.0)
+        return 0.0;
+
+    return elapsedSeconds * (1.0 - progress) / progress;
+}
+
+juce::String AudioExporter::formatTimeRemaining (double seconds)
+{
+    if (seconds < 0.0)
+        return {};
+
+    if (seconds < 1.0)
+        return "less than a second left";
+
+    const auto total   = (int) std::ceil (seconds);
+    const auto hours   = total / 3600;
+    const auto minutes = (total / 60) % 60;
+    const auto secs    = juce::String (total % 60).paddedLeft ('0', 2);
+
+    if (hours > 0)
+        return "about " + juce::String (hours) + ":" + juce::String (minutes).paddedLeft ('0', 2) + ":" + secs + " left";
+
+    return "about " + juce::String (minutes) + ":" + secs + " left";
+}
+
+std::unique_ptr<te::Edit> AudioExporter::makeEdit (const juce::ValueTree& editState, const juce::File& editFile)
+{
+    // A private edit per render: each owns its plugin instances, so renders can run side by side.
+    // The state is copied each time because an Edit works directly on the tree it's given.
+    return loadEdit (editState.createCopy(), editFile);
+}
+
+std::unique_ptr<te::Edit> AudioExporter::loadEdit (const juce::ValueTree& ownedState, const juce::File& editFile)
+{
+    auto e = te::loadEditFromState (engine, ownedState, te::Edit::forRendering);
+
+    if (e != nullptr)
+        e->editFileRetriever = [editFile] { return editFile; };
+
+    return e;
+}
+
+juce::ValueTree AudioExporter::copyWithOnlyAudioTrack (const juce::ValueTree& editState, te::EditItemID keep)
+{
+    auto copy = editState.createCopy();
+
+    // Audio tracks can sit inside folder tracks
+    std::function<void (juce::ValueTree)> removeOthers = [&] (juce::ValueTree parent)
+    {
+        for (int i = parent.getNumChildren(); --i >= 0;)
+        {
+            auto child = parent.getChild (i);
+
+            if (child.hasType (te::IDs::TRACK) && te::EditItemID::fromID (child) != keep)
+                parent.removeChild (i, nullptr);
+            else if (child.hasType (te::IDs::FOLDERTRACK))
+                removeOthers (child);
+        }
+    };
+
+    removeOthers (copy);
+    return copy;
+}
+
+void AudioExporter::addJob (std::unique_ptr<te::Edit> edit, const juce::String& name, const juce::File& file,
+                            const juce::BigInteger& tracks, bool useMasterPlugins, t::TimeRange time,
+                            double sampleRate, int bitDepth)
+{
+    auto job = std::make_unique<Job>();
+    job->name = name;
+    job->file = file;
+    file.deleteFile();
+
+    te::Renderer::Parameters params (*edit);
+    params.destFile           = file;
+    params.audioFormat        = engine.getAudioFileFormatManager().getWavFormat();
+    params.bitDepth           = bitDepth;
+    params.sampleRateForAudio = sampleRate;
+    params.blockSizeForAudio  = 512;
+    params.time               = time;
+    params.tracksToDo         = tracks;
+    params.usePlugins         = true;
+    params.useMasterPlugins   = useMasterPlugins;
+    params.realTimeRender     = false;
+
+    job->task = std::make_unique<te::Renderer::RenderTask> ("Export " + name, params, &job->progress, nullptr);
+    job->edit = std::move (edit);
+    jobs.push_back (std::move (job));
+}
+
+void AudioExporter::launch (bool stemExport, ProgressCallback progressCallback, CompletionCallback completionCallback)
+{
+    exportingStems = stemExport;
+    startTimeMs = juce::Time::getMillisecondCounterHiRes();
+
+    onProgress = std::move (progressCallback);
+    onComplete = std::move (completionCallback);
+
+    for (auto& job : jobs)
+        pool.addJob (job->task.get(), false);
+
+    startTimerHz (10);
+}
+
+//==============================================================================
+// Export
+
+bool AudioExporter::startMixdown (const juce::ValueTree& editState,
+                                  const juce::File& editFile,
+                                  const juce::File& destFile,
+                                  double sampleRate,
+                                  ProgressCallback progressCallback,
+                                  CompletionCallback completionCallback)
+{
+    return startMixdown (editState, editFile, destFile, sampleRate, 24, {},
+                         std::move (progressCallback), std::move (completionCallback));
+}
+
+bool AudioExporter::startMixdown (const juce::ValueTree& editState,
+                                  const juce::File& editFile,
+                                  const juce::File& destFile,
+                                  double sampleRate,
+                                  int bitDepth,
+                                  t::TimeRange range,
+                                  ProgressCallback progressCallback,
+                                  CompletionCallback completionCallback)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (isRunning() || ! editState.isValid())
+        return false;
+
+    auto edit = makeEdit (editState, editFile);
+    if (edit == nullptr)
+        return false;
+
+    const auto end = range.isEmpty() ? t::TimePosition() + edit->getLength() : range.getEnd();
+
+    if (end <= range.getStart() || ! destFile.getParentDirectory().createDirectory())
+        return false;
+
+    juce::BigInteger allTrackBits;
+    allTrackBits.setRange (0, te::getAllTracks (*edit).size(), true);
+
+    addJob (std::move (edit), "Mixdown", destFile, allTrackBits, true, { range.getStart(), end }, sampleRate, bitDepth);
+    launch (false, std::move (progressCallback), std::move (completionCallback));
+    return true;
+}
+
+bool AudioExporter::startTrackRender (const juce::ValueTree& editState,
+                                      const juce::File& editFile,
+                                      te::EditItemID trackId,
+                                      const juce::File& destFile,
+                                      double sampleRate,
+                                      t::TimeDuration tail,
+                                      ProgressCallback progressCallback,
+                                      CompletionCallback completionCallback)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (isRunning() || ! editState.isValid())
+        return false;
+
+    auto edit = makeEdit (editState, editFile);
+    if (edit == nullptr || edit->getLength() <= t::TimeDuration())
+        return false;
+
+    auto* track = dynamic_cast<te::AudioTrack*> (te::findTrackForID (*edit, trackId));
+    if (track == nullptr || ! destFile.getParentDirectory().createDirectory())
+        return false;
+
+    // Pre-fader and independent of the mixer state: the live fader still applies on playback
+    for (auto* other : te::getAllTracks (*edit))
+        other->setSolo (false);
+
+    track->setMute (false);
+
+    if (auto* vnp = track->getVolumePlugin())
+    {
+        vnp->setVolumeDb (0.0f);
+        vnp->setPan (0.0f);
+    }
+
+    juce::BigInteger bits;
+    bits.setBit (te::getAllTracks (*edit).indexOf (track));
+
+    const auto name = track->getName();
+    const auto time = t::TimeRange (t::TimePosition(), edit->getLength() + tail);
+    addJob (std::move (edit), name, destFile, bits, false, time, sampleRate);
+    launch (false, std::move (progressCallback), std::move (completionCallback));
+    return true;
+}
+
+bool AudioExporter::startStems (const juce::ValueTree& editState,
+                                const juce::File& editFile,
+                                const juce::File& destDir,
+                                const juce::String& baseName,
+                                double sampleRate,
+                                ProgressCallback progressCallback,
+                                CompletionCallback completionCallback)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (isRunning() || ! editState.isValid())
+        return false;
+
+    // The master render needs the whole edit; it also tells us which stems there are
+    auto masterEdit = makeEdit (editState, editFile);
+    if (masterEdit == nullptr || masterEdit->getLength() <= t::TimeDuration())
+        return false;
+
+    const auto allTracks = te::getAllTracks (*masterEdit);
+    const bool anySolo = masterEdit->areAnyTracksSolo();
+
+    struct Stem
+    {
+        int number;
+        te::EditItemID id;
+        juce::String name;
+    };
+
+    std::vector<Stem> stems;
+    juce::BigInteger allTrackBits;
+    int audioTrackNumber = 0;
+
+    for (int i = 0; i < allTracks.size(); ++i)
+    {
+        allTrackBits.setBit (i);
+
+        auto* track = dynamic_cast<te::AudioTrack*> (allTracks[i]);
+        if (track == nullptr)
+            continue;
+
+        // Numbered by position, so a stem keeps its number when others are skipped
+        ++audioTrackNumber;
+
+        // Muted, solo'd out and empty tracks would only give silent files
+        const bool audible = ! track->isMuted (true) && (! anySolo || track->isSolo (true) || track->isSoloIsolate (true));
+
+        if (audible && ! track->getClips().isEmpty())
+            stems.push_back ({ audioTrackNumber, track->itemID, track->getName() });
+    }
+
+    if (stems.empty() || ! destDir.createDirectory())
+        return false;
+
+    // Every file covers the whole song, so stems line up when imported elsewhere
+    const auto time = t::TimeRange (t::TimePosition(), masterEdit->getLength());
+
+    // Each stem's edit holds only its own audio track, so it loads just that track's plugins and clips
+    for (const auto& stem : stems)
+    {
+        auto edit = loadEdit (copyWithOnlyAudioTrack (editState, stem.id), editFile);
+        auto* track = edit != nullptr ? te::findTrackForID (*edit, stem.id) : nullptr;
+
+        if (track == nullptr)
+        {
+            jobs.clear();
+            return false;
+        }
+
+        juce::BigInteger bits;
+        bits.setBit (te::getAllTracks (*edit).indexOf (track));
+
+        // Stems are pre-master
+        addJob (std::move (edit), stem.name, destDir.getChildFile (makeStemFileName (baseName, stem.number, stem.name)),
+                bits, false, time, sampleRate);
+    }
+
+    addJob (std::move (masterEdit), "Master",
+            destDir.getChildFile (juce::File::createLegalFileName (baseName + " - Master") + ".wav"),
+            allTrackBits, true, time, sampleRate);
+
+    launch (true, std::move (progressCallback), std::move (completionCallback));
+    return true;
+}
+
+void AudioExporter::cancel()
+{
+    if (isRunning())
+        finish (true);
+}
+
+bool AudioExporter::waitForCompletion (int timeoutMs)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto deadline = juce::Time::getMillisecondCounterHiRes() + timeoutMs;
+
+    while (! jobs.empty())
+    {
+        if (getNumFinishedJobs() == (int) jobs.size())
+        {
+            finish (false);
+            break;
+        }
+
+        if (timeoutMs >= 0 && juce::Time::getMillisecondCounterHiRes() > deadline)
+            return false;
+
+        juce::Thread::sleep (10);
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Progress / completion
+
+int AudioExporter::getNumFinishedJobs() const
+{
+    int numDone = 0;
+
+    for (auto& job : jobs)
+        if (! pool.contains (job->task.get()))
+            ++numDone;
+
+    return numDone;
+}
+
+void AudioExporter::timerCallback()
+{
+    double total = 0.0;
+
+    for (auto& job : jobs)
+        total += juce::jlimit (0.0f, 1.0f, job->progress.load());
+
+    const auto numDone = getNumFinishedJobs();
+    const auto numJobs = (int) jobs.size();
+
+    if (numDone == numJobs)
+    {
+        finish (false);
+        return;
+    }
+
+    if (onProgress)
+    {
+        const auto progress = total / numJobs;
+        const auto elapsed = (juce::Time::getMillisecondCounterHiRes() - startTimeMs) / 1000.0;
+        const auto eta = formatTimeRemaining (estimateSecondsRemaining (elapsed, progress));
+
+        juce::String status;
+
+        if (exportingStems)
+            status = juce::String (numDone) + " of " + juce::String (numJobs) + " stems rendered"
+                   + (eta.isNotEmpty() ? ", " + eta : juce::String());
+        else
+            status = eta.isNotEmpty() ? "Rendering, " + eta : juce::String ("Rendering...");
+
+        onProgress (progress, status);
+    }
+}
+
+void AudioExporter::finish (bool cancelled)
+{
+    stopTimer();
+
+    if (cancelled)
+    {
+        for (auto& job : jobs)
+            job->task->signalJobShouldExit();
+
+        // A running task uses its edit, so both must outlive it: wait as long as it takes
+        while (! pool.removeAllJobs (true, 1000))
+            for (auto& job : jobs)
+                job->task->signalJobShouldExit();
+    }
+
+    Result result;
+    result.cancelled = cancelled;
+
+    for (auto& job : jobs)
+    {
+        const bool written = ! cancelled
+                          && job->task->errorMessage.isEmpty()
+                          && job->file.existsAsFile();
+
+        if (written)
+        {
+            result.files.add (job->file);
+            continue;
+        }
+
+        // Partial (or, on cancel, any) output is removed
+        job->file.deleteFile();
+
+        if (! cancelled && result.error.isEmpty())
+            result.error = "Couldn't render " + job->name
+                         + (job->task->errorMessage.isNotEmpty() ? ": " + job->task->errorMessage : juce::String());
+    }
+
+    result.ok = ! cancelled && result.files.size() == (int) jobs.size();
+
+    // Tasks go before their edits (Job member order)
+    jobs.clear();
+    onProgress = nullptr;
+
+    auto callback = std::move (onComplete);
+    onComplete = nullptr;
+
+    if (callback)
+        callback (result);
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Renders the project to audio files in the background: a full mixdown,
+ *        every AudioTrack (plus the master mix) as stems in parallel, or a
+ *        single track for freezing.
+ *
+ * Architecture:
+ *  - The start*() functions build one private te::Edit per output file
+ *    from a snapshot of the project (message thread). Each render owns its
+ *    plugin instances, so renders can't race each other or the live edit.
+ *    A stem's edit only contains its own audio track, so only that track's
+ *    plugins are loaded; the master render gets the whole project.
+ *  - Each file is a te::Renderer::RenderTask run on a ThreadPool sized to the
+ *    machine, so stems render concurrently. Inside a task TE's node player
+ *    spreads the graph over the engine's audio worker threads (the same
+ *    count the realtime graph uses), so a single mixdown also uses several cores.
+ *  - A timer on the message thread averages the tasks' progress into one
+ *    value plus an ETA for the UI, and reports completion.
+ *  - cancel() stops every render and deletes the partially written files.
+ *
+ * Stems are pre-master (track plugins, volume and pan, no master plugins);
+ * the master file and the mixdown include master plugins. Tracks that are
+ * muted, solo'd out or have no clips get no stem.
+ */
+class AudioExporter : private juce::Timer
+{
+public:
+    //==============================================================================
+    struct Result
+    {
+        bool ok = false;
+        bool cancelled = false;
+        juce::Array<juce::File> files;   ///< Written files, master last.
+        juce::String error;
+    };
+
+    using ProgressCallback   = std::function<void (double progress, const juce::String& status)>;
+    using CompletionCallback = std::function<void (const Result&)>;
+
+    /** @param numThreads  Renders run at once; 0 means one per CPU core. */
+    explicit AudioExporter (te::Engine& engine, int numThreads = 0);
+    ~AudioExporter() override;
+
+    //==============================================================================
+    /**
+     * @brief Starts rendering the whole of @p editState to @p destFile (24-bit WAV).
+     *
+     * @param editState   Snapshot of the edit (see AppEngine::createSaveSnapshot).
+     * @param editFile    Used to resolve relative media paths in the snapshot.
+     * @param sampleRate  Output sample rate.
+     * @return false (and no callbacks) if already running or there is nothing to render.
+     */
+    bool startMixdown (const juce::ValueTree& editState,
+                       const juce::File& editFile,
+                       const juce::File& destFile,
+                       double sampleRate,
+                       ProgressCallback onProgress,
+                       CompletionCallback onComplete);
+
+    /**
+     * @brief Starts rendering part of @p editState to @p destFile at a given bit depth.
+     *
+     * @param bitDepth  16, 24 or 32.
+     * @param range     Part of the edit to render; a range with no length renders
+     *                  from its start to the end of the edit.
+     * @return false (and no callbacks) if already running or the range holds nothing to render.
+     * @see startMixdown for the other parameters.
+     */
+    bool startMixdown (const juce::ValueTree& editState,
+                       const juce::File& editFile,
+                       const juce::File& destFile,
+                       double sampleRate,
+                       int bitDepth,
+                       tracktion::TimeRange range,
+                       ProgressCallback onProgress,
+                       CompletionCallback onComplete);
+
+    /**
+     * @brief Starts rendering the stems of @p editState into @p destDir.
+     *
+     * Stems are numbered by the track's position among the audio tracks, so
+     * numbers don't shift when a silent track is skipped.
+     *
+     * @param baseName    Prefix for every file ("<baseName> - 01 Drums.wav").
+     * @see startMixdown for the other parameters.
+     */
+    bool startStems (const juce::ValueTree& editState,
+                     const juce::File& editFile,
+                     const juce::File& destDir,
+                     const juce::String& baseName,
+                     double sampleRate,
+                     ProgressCallback onProgress,
+                     CompletionCallback onComplete);
+
+    /**
+     * @brief Starts a pre-fader render of a single track through its instrument and inserts.
+     *
+     * The track's volume and pan are left at unity and its mute/solo ignored, so
+     * the result can replace the track's plugin chain (see TrackFreezer).
+     *
+     * @param tail  Rendered past the end of the edit, so release, reverb and delay
+     *              tails aren't cut off.
+     * @see startMixdown for the other parameters.
+     */
+    bool startTrackRender (const juce::ValueTree& editState,
+                           const juce::File& editFile,
+                           te::EditItemID trackId,
+                           const juce::File& destFile,
+                           double sampleRate,
+                           tracktion::TimeDuration tail,
+                           ProgressCallback onProgress,
+                           CompletionCallback onComplete);
+
+    /** Stops all renders (waiting until they have) and deletes partial files; onComplete reports cancelled. */
+    void cancel();
+
+    /**
+     * @brief Blocks until every render has finished, then completes as the timer would.
+     *
+     * For callers without a running message loop (command line, tests).
+     * @return false if @p timeoutMs (-1 = no limit) passed first; the renders carry on.
+     */
+    bool waitForCompletion (int timeoutMs);
+
+    /** True while any render is queued or running. */
+    bool isRunning() const { return ! jobs.empty() || pool.getNumJobs() > 0; }
+
+    //==============================================================================
+    /** File name for a stem: "<baseName> - <nn> <trackName>.wav", made filesystem-safe. */
+    static juce::String makeStemFileName (const juce::String& baseName, int stemNumber, const juce::String& trackName);
+
+    /** Seconds left after @p elapsedSeconds at @p progress (0..1), or -1 while it's too early to tell. */
+    static double estimateSecondsRemaining (double elapsedSeconds, double progress);
+
+    /** "about 1:05 left" style text for an estimate; empty when the estimate is unknown (< 0). */
+    static juce::String formatTimeRemaining (double seconds);
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        juce::String name;
+        juce::File file;
+        std::unique_ptr<te::Edit> edit;
+        std::unique_ptr<te::Renderer::RenderTask> task;
+        std::atomic<float> progress { 0.0f };
+    };
+
+    std::unique_ptr<te::Edit> makeEdit (const juce::ValueTree& editState, const juce::File& editFile);
+    std::unique_ptr<te::Edit> loadEdit (const juce::ValueTree& ownedState, const juce::File& editFile);
+
+    /** Copy of @p editState without the audio tracks other than @p keep (and so without their plugins and clips). */
+    static juce::ValueTree copyWithOnlyAudioTrack (const juce::ValueTree& editState, te::EditItemID keep);
+    void addJob (std::unique_ptr<te::Edit> edit, const juce::String& name, const juce::File& file,
+                 const juce::BigInteger& tracks, bool useMasterPlugins, tracktion::TimeRange time,
+                 double sampleRate, int bitDepth = 24);
+    void launch (bool stemExport, ProgressCallback, CompletionCallback);
+
+    int getNumFinishedJobs() const;
+    void timerCallback() override;
+    void finish (bool cancelled);
+
+    te::Engine& engine;
+    juce::ThreadPool pool;
+    std::vector<std::unique_ptr<Job>> jobs;
+
+    bool exportingStems = false;
+    double startTimeMs = 0.0;
+
+    ProgressCallback onProgress;
+    CompletionCallback onComplete;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioExporter)
+};
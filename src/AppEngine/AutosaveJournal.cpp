@@ -0,0 +1,416 @@
+#include "AutosaveJournal.h"
+#include <algorithm>
+
+namespace
+{
+    constexpr int journalMagic   = 0x314a4b47; // "GKJ1"
+    constexpr int journalVersion = 1;
+    constexpr int maxRecordSize  = 256 * 1024 * 1024;
+
+    const juce::String snapshotPrefix  = "snapshot_";
+    const juce::String journalPrefix   = "journal_";
+    const juce::String snapshotPattern = "snapshot_*.gkproj";
+    const juce::String journalPattern  = "journal_*.gkj";
+
+    // FNV-1a; only has to catch torn or garbage tails, not adversarial edits
+    juce::uint32 checksum (const void* data, size_t size) noexcept
+    {
+        auto* bytes = static_cast<const juce::uint8*> (data);
+        juce::uint32 h = 2166136261u;
+
+        for (size_t i = 0; i < size; ++i)
+            h = (h ^ bytes[i]) * 16777619u;
+
+        return h;
+    }
+}
+
+//==============================================================================
+// Construction / Destruction
+
+AutosaveJournal::AutosaveJournal (ProjectSaver& saverToUse)
+    : saver (saverToUse)
+{
+}
+
+AutosaveJournal::~AutosaveJournal()
+{
+    stop (false);
+}
+
+//==============================================================================
+// Session
+
+void AutosaveJournal::start (const juce::File& dir, const juce::ValueTree& state, const juce::File& file)
+{
+    stop (true);
+
+    directory = dir;
+    editFile = file;
+    root = state;
+    ++session;
+
+    directory.deleteRecursively();
+    directory.createDirectory();
+
+    generation = -1;
+    beginGeneration();
+
+    root.addListener (this);
+    startTimer (flushIntervalMs);
+}
+
+void AutosaveJournal::stop (bool discard)
+{
+    if (! root.isValid())
+        return;
+
+    stopTimer();
+    root.removeListener (this);
+    root = {};
+
+    flush();
+    journal.reset();
+
+    if (discard)
+    {
+        // A snapshot still being written would otherwise reappear after the delete
+        saver.waitForPendingSaves();
+        directory.deleteRecursively();
+    }
+}
+
+void AutosaveJournal::setEditFile (const juce::File& newEditFile)
+{
+    if (newEditFile == editFile)
+        return;
+
+    editFile = newEditFile;
+
+    if (isActive())
+        compact();
+}
+
+//==============================================================================
+// Writing
+
+void AutosaveJournal::flush()
+{
+    if (pending.getDataSize() == 0)
+        return;
+
+    if (journal != nullptr)
+    {
+        journal->write (pending.getData(), pending.getDataSize());
+        journal->flush();
+    }
+
+    pending.reset();
+
+    if (bytesSinceCompaction >= compactionThreshold && isActive())
+        compact();
+}
+
+void AutosaveJournal::compact()
+{
+    if (! isActive())
+        return;
+
+    flush();
+    beginGeneration();
+}
+
+juce::File AutosaveJournal::getSnapshotFile (juce::int64 gen) const
+{
+    return directory.getChildFile (snapshotPrefix + juce::String (gen) + ProjectSaver::binaryExtension);
+}
+
+juce::File AutosaveJournal::getJournalFile (juce::int64 gen) const
+{
+    return directory.getChildFile (journalPrefix + juce::String (gen) + ".gkj");
+}
+
+juce::int64 AutosaveJournal::getGeneration (const juce::File& f)
+{
+    return f.getFileNameWithoutExtension().fromFirstOccurrenceOf ("_", false, false).getLargeIntValue();
+}
+
+void AutosaveJournal::beginGeneration()
+{
+    ++generation;
+
+    // Journal first: every change after this point belongs to the new generation
+    journal.reset();
+    journal = std::make_unique<juce::FileOutputStream> (getJournalFile (generation));
+
+    if (journal->failedToOpen())
+    {
+        DBG ("[AutosaveJournal] Could not open " << getJournalFile (generation).getFullPathName());
+        journal.reset();
+    }
+    else
+    {
+        journal->setPosition (0);
+        journal->truncate();
+        journal->writeInt (journalMagic);
+        journal->writeInt (journalVersion);
+        journal->writeString (editFile.getFullPathName());
+        journal->flush();
+    }
+
+    bytesSinceCompaction = 0;
+
+    // The callback may arrive after this session was stopped and another started
+    const auto gen = generation;
+    saver.saveAsync (root.createCopy(), getSnapshotFile (gen),
+        [self = juce::WeakReference<AutosaveJournal> (this), gen, s = session] (bool ok)
+        {
+            if (ok && self != nullptr && self->session == s)
+                self->removeGenerationsBefore (gen);
+        });
+}
+
+void AutosaveJournal::removeGenerationsBefore (juce::int64 gen)
+{
+    for (const auto& pattern : { snapshotPattern, journalPattern })
+        for (const auto& f : directory.findChildFiles (juce::File::findFiles, false, pattern))
+            if (getGeneration (f) < gen)
+                f.deleteFile();
+}
+
+bool AutosaveJournal::beginRecord (Op op, const juce::ValueTree& tree)
+{
+    // Child-index path from the root; changes outside the root's hierarchy are ignored
+    path.clear();
+    auto node = tree;
+
+    while (node != root)
+    {
+        auto parent = node.getParent();
+        if (! parent.isValid())
+            return false;
+
+        path.push_back (parent.indexOf (node));
+        node = parent;
+    }
+
+    record.reset();
+    record.writeByte ((char) op);
+    record.writeCompressedInt ((int) path.size());
+
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+        record.writeCompressedInt (*it);
+
+    return true;
+}
+
+void AutosaveJournal::endRecord()
+{
+    const auto size = record.getDataSize();
+
+    pending.writeInt ((int) size);
+    pending.writeInt ((int) checksum (record.getData(), size));
+    pending.write (record.getData(), size);
+
+    bytesSinceCompaction += (juce::int64) size + 8;
+}
+
+//==============================================================================
+// juce::ValueTree::Listener
+
+void AutosaveJournal::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property)
+{
+    const bool removed = ! tree.hasProperty (property);
+
+    if (! beginRecord (removed ? Op::removeProperty : Op::setProperty, tree))
+        return;
+
+    record.writeString (property.toString());
+
+    if (! removed)
+        tree.getProperty (property).writeToStream (record);
+
+    endRecord();
+}
+
+void AutosaveJournal::valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child)
+{
+    if (! beginRecord (Op::addChild, parent))
+        return;
+
+    record.writeCompressedInt (parent.indexOf (child));
+    child.writeToStream (record);
+    endRecord();
+}
+
+void AutosaveJournal::valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree&, int index)
+{
+    if (! beginRecord (Op::removeChild, parent))
+        return;
+
+    record.writeCompressedInt (index);
+    endRecord();
+}
+
+void AutosaveJournal::valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex)
+{
+    if (! beginRecord (Op::moveChild, parent))
+        return;
+
+    record.writeCompressedInt (oldIndex);
+    record.writeCompressedInt (newIndex);
+    endRecord();
+}
+
+//==============================================================================
+// Recovery
+
+bool AutosaveJournal::hasRecoverableSession (const juce::File& dir)
+{
+    return dir.isDirectory()
+        && ! dir.findChildFiles (juce::File::findFiles, false, snapshotPattern).isEmpty();
+}
+
+juce::ValueTree AutosaveJournal::recover (const juce::File& dir, juce::File* editFileOut)
+{
+    auto byGeneration = [] (const juce::File& a, const juce::File& b) { return getGeneration (a) < getGeneration (b); };
+
+    auto snapshots = dir.findChildFiles (juce::File::findFiles, false, snapshotPattern);
+    auto journals  = dir.findChildFiles (juce::File::findFiles, false, journalPattern);
+    std::sort (snapshots.begin(), snapshots.end(), byGeneration);
+    std::sort (journals.begin(), journals.end(), byGeneration);
+
+    // Newest snapshot that parses; snapshots are written via TemporaryFile so are never torn
+    juce::ValueTree state;
+    juce::int64 base = 0;
+
+    for (int i = snapshots.size(); --i >= 0;)
+    {
+        state = ProjectSaver::readProject (snapshots.getReference (i));
+        base = getGeneration (snapshots.getReference (i));
+
+        if (state.isValid())
+            break;
+    }
+
+    if (! state.isValid())
+        return {};
+
+    for (const auto& f : journals)
+    {
+        if (getGeneration (f) < base)
+            continue;
+
+        juce::FileInputStream in (f);
+        juce::String editPath;
+
+        if (in.openedOk() && readHeader (in, editPath))
+        {
+            const int applied = replay (state, in);
+            DBG ("[AutosaveJournal] Replayed " << applied << " changes from " << f.getFileName());
+
+            if (editFileOut != nullptr)
+                *editFileOut = editPath.isNotEmpty() ? juce::File (editPath) : juce::File();
+        }
+    }
+
+    return state;
+}
+
+bool AutosaveJournal::readHeader (juce::InputStream& in, juce::String& editPath)
+{
+    if (in.readInt() != journalMagic || in.readInt() != journalVersion)
+        return false;
+
+    editPath = in.readString();
+    return true;
+}
+
+int AutosaveJournal::replay (juce::ValueTree& state, juce::InputStream& in)
+{
+    int applied = 0;
+    juce::MemoryBlock data;
+
+    while (in.getNumBytesRemaining() >= 8)
+    {
+        const int size = in.readInt();
+        const auto sum = (juce::uint32) in.readInt();
+
+        if (size <= 0 || size > maxRecordSize || in.getNumBytesRemaining() < size)
+            break; // torn tail
+
+        data.setSize ((size_t) size);
+        if (in.read (data.getData(), size) != size || checksum (data.getData(), data.getSize()) != sum)
+            break;
+
+        juce::MemoryInputStream recordIn (data, false);
+        if (! applyRecord (state, recordIn))
+            break;
+
+        ++applied;
+    }
+
+    return applied;
+}
+
+bool AutosaveJournal::applyRecord (juce::ValueTree& state, juce::MemoryInputStream& in)
+{
+    const auto op = (Op) in.readByte();
+    const int depth = in.readCompressedInt();
+
+    auto node = state;
+    for (int i = 0; i < depth; ++i)
+    {
+        node = node.getChild (in.readCompressedInt());
+        if (! node.isValid())
+            return false;
+    }
+
+    switch (op)
+    {
+        case Op::setProperty:
+        {
+            const juce::Identifier property (in.readString());
+            node.setProperty (property, juce::var::readFromStream (in), nullptr);
+            return true;
+        }
+
+        case Op::removeProperty:
+            node.removeProperty (juce::Identifier (in.readString()), nullptr);
+            return true;
+
+        case Op::addChild:
+        {
+            const int index = in.readCompressedInt();
+            auto child = juce::ValueTree::readFromStream (in);
+            if (! child.isValid())
+                return false;
+
+            node.addChild (child, index, nullptr);
+            return true;
+        }
+
+        case Op::removeChild:
+        {
+            const int index = in.readCompressedInt();
+            if (! juce::isPositiveAndBelow (index, node.getNumChildren()))
+                return false;
+
+            node.removeChild (index, nullptr);
+            return true;
+        }
+
+        case Op::moveChild:
+        {
+            const int oldIndex = in.readCompressedInt();
+            const int newIndex = in.readCompressedInt();
+            if (! juce::isPositiveAndBelow (oldIndex, node.getNumChildren()))
+                return false;
+
+            node.moveChild (oldIndex, newIndex, nullptr);
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ProjectSaver.h"
+#include <juce_events/juce_events.h>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Crash-safe incremental autosave for an Edit's ValueTree.
+ *
+ * Instead of rewriting the whole project on every autosave tick, AutosaveJournal
+ * listens to the Edit's state and appends each change (property set/removed,
+ * child added/removed/moved) to a journal file as it happens. Autosave I/O
+ * therefore scales with the size of each change, not with the project.
+ *
+ * Architecture:
+ *  - The session directory holds numbered generations: snapshot_<n>.gkproj (binary)
+ *    is the full state at the start of generation n, journal_<n>.gkj the deltas since
+ *  - Records are length + checksum framed; a crash mid-write only loses the torn tail
+ *  - Records are buffered in memory and flushed on a short timer
+ *  - compact() starts a new generation: the snapshot is written by ProjectSaver on its
+ *    worker thread; older generations are deleted once it is on disk
+ *  - Recovery loads the newest readable snapshot and replays every journal from
+ *    that generation onwards, so a crash during compaction is also recoverable
+ *
+ * Nodes are addressed by their child-index path from the root, which stays valid
+ * because records are replayed in the order they were written.
+ *
+ * Thread-safety: message thread only (like the ValueTree it listens to).
+ */
+class AutosaveJournal : private juce::ValueTree::Listener,
+                        private juce::Timer
+{
+public:
+    //==============================================================================
+    // Construction / Destruction
+
+    /** @param saverToUse Writes compaction snapshots; must outlive the journal. */
+    explicit AutosaveJournal (ProjectSaver& saverToUse);
+
+    /** Flushes and closes the journal, leaving it on disk (see stop()). */
+    ~AutosaveJournal() override;
+
+    //==============================================================================
+    // Session
+
+    /**
+     * @brief Starts journalling @p root into @p directory.
+     *
+     * Any previous session in the directory is discarded and a first snapshot
+     * is written.
+     *
+     * @param root      The Edit's state tree.
+     * @param editFile  Project file the session belongs to (may be empty for untitled edits).
+     */
+    void start (const juce::File& directory, const juce::ValueTree& root, const juce::File& editFile);
+
+    /**
+     * @brief Stops listening and closes the journal.
+     *
+     * @param discard True on a clean shutdown or edit switch: the session files are deleted.
+     */
+    void stop (bool discard);
+
+    bool isActive() const noexcept { return root.isValid(); }
+
+    /** Records a new project file for the session (e.g. after Save As) and compacts. */
+    void setEditFile (const juce::File& newEditFile);
+
+    //==============================================================================
+    // Writing
+
+    /** Writes buffered records to disk. Called automatically every flushIntervalMs. */
+    void flush();
+
+    /** Starts a new generation from a snapshot of the current state. */
+    void compact();
+
+    /** Journal bytes written (or buffered) since the last compaction. */
+    juce::int64 getBytesSinceCompaction() const noexcept { return bytesSinceCompaction; }
+
+    /** Journal size at which compact() is triggered automatically. */
+    void setCompactionThreshold (juce::int64 bytes) noexcept { compactionThreshold = bytes; }
+
+    static constexpr int flushIntervalMs = 500;
+    static constexpr juce::int64 defaultCompactionThreshold = 4 * 1024 * 1024;
+
+    //==============================================================================
+    // Recovery
+
+    /** Returns true if @p directory holds a session that can be recovered. */
+    static bool hasRecoverableSession (const juce::File& directory);
+
+    /**
+     * @brief Rebuilds the state of a session from its snapshot and journals.
+     *
+     * @param directory Session directory.
+     * @param editFile  If non-null, receives the project file recorded for the session.
+     * @return The recovered tree, or an invalid tree if nothing could be read.
+     */
+    static juce::ValueTree recover (const juce::File& directory, juce::File* editFile = nullptr);
+
+private:
+    //==============================================================================
+    enum class Op : juce::uint8
+    {
+        setProperty = 1,
+        removeProperty,
+        addChild,
+        removeChild,
+        moveChild
+    };
+
+    juce::File getSnapshotFile (juce::int64 gen) const;
+    juce::File getJournalFile (juce::int64 gen) const;
+    static juce::int64 getGeneration (const juce::File& f);
+
+    void beginGeneration();
+    void removeGenerationsBefore (juce::int64 gen);
+
+    bool beginRecord (Op op, const juce::ValueTree& tree);
+    void endRecord();
+
+    static bool readHeader (juce::InputStream& in, juce::String& editPath);
+    static int replay (juce::ValueTree& state, juce::InputStream& in);
+    static bool applyRecord (juce::ValueTree& state, juce::MemoryInputStream& in);
+
+    // juce::ValueTree::Listener
+    void valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+    void valueTreeChildOrderChanged (juce::ValueTree& parent, int oldIndex, int newIndex) override;
+
+    // juce::Timer
+    void timerCallback() override { flush(); }
+
+    //==============================================================================
+    ProjectSaver& saver;
+
+    juce::File directory;                                    ///< Session directory.
+    juce::File editFile;                                     ///< Written into each journal header.
+    juce::ValueTree root;                                    ///< Listened-to state (invalid when stopped).
+
+    int session = 0;                                         ///< Incremented by start().
+    juce::int64 generation = -1;                             ///< Current generation number.
+    std::unique_ptr<juce::FileOutputStream> journal;         ///< Current journal file.
+    juce::MemoryOutputStream pending;                        ///< Records not yet flushed.
+    juce::MemoryOutputStream record;                         ///< Record being built.
+    std::vector<int> path;                                   ///< Scratch for child-index paths.
+
+    juce::int64 bytesSinceCompaction = 0;
+    juce::int64 compactionThreshold = defaultCompactionThreshold;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AutosaveJournal)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutosaveJournal)
+};
@@ -0,0 +1,157 @@
+#include "DspLoadMonitor.h"
+#include "../UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    /** Quotes a CSV field, doubling any quotes inside it. */
+    juce::String csvQuoted (const juce::String& s)
+    {
+        return "\"" + s.replace ("\"", "\"\"") + "\"";
+    }
+
+    juce::String percent (double fraction)
+    {
+        return juce::String (fraction * 100.0, 2);
+    }
+}
+
+//==============================================================================
+// Construction
+
+DspLoadMonitor::DspLoadMonitor (std::function<te::Edit*()> getEditToWatch)
+    : getEdit (std::move (getEditToWatch)),
+      startTimeMs (juce::Time::getMillisecondCounterHiRes())
+{
+    startTimer (pollIntervalMs);
+}
+
+DspLoadMonitor::~DspLoadMonitor()
+{
+    stopTimer();
+}
+
+//==============================================================================
+// Polling
+
+void DspLoadMonitor::poll()
+{
+    auto* edit = getEdit ? getEdit() : nullptr;
+
+    // A new edit means new plugin IDs; the history stays for the CSV
+    if (edit != lastEdit)
+    {
+        pluginLoads.clear();
+        trackLoads.clear();
+        lastEdit = edit;
+    }
+
+    if (edit == nullptr)
+        return;
+
+    const double now = (juce::Time::getMillisecondCounterHiRes() - startTimeMs) / 1000.0;
+    const auto tracks = te::getAudioTracks (*edit);
+
+    for (int trackIndex = 0; trackIndex < tracks.size(); ++trackIndex)
+    {
+        auto* track = tracks[trackIndex];
+        Load trackLoad;
+
+        for (auto* plugin : track->pluginList)
+        {
+            if (plugin == nullptr || ! plugin->isEnabled())
+                continue;
+
+            Row row;
+
+            if (auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin))
+            {
+                const auto figures = morph->takeDspLoad();
+                row.pluginKind = "morph";
+                row.load = { figures.average, figures.peak };
+            }
+            else if (dynamic_cast<te::SamplerPlugin*> (plugin) != nullptr
+                     || dynamic_cast<te::ExternalPlugin*> (plugin) != nullptr)
+            {
+                const double usage = plugin->getCpuUsage();
+                row.pluginKind = dynamic_cast<te::SamplerPlugin*> (plugin) != nullptr ? "sampler" : "external";
+                row.load = { usage, usage };
+            }
+            else
+            {
+                continue;
+            }
+
+            row.timeSeconds = now;
+            row.trackIndex  = trackIndex;
+            row.trackName   = track->getName();
+            row.pluginName  = plugin->getName();
+
+            pluginLoads[plugin->itemID] = row.load;
+            trackLoad.average += row.load.average;
+            trackLoad.peak    += row.load.peak;
+
+            history.push_back (std::move (row));
+        }
+
+        trackLoads[track->itemID] = trackLoad;
+    }
+
+    while (history.size() > maxHistoryRows)
+        history.pop_front();
+
+    if (onChange)
+        onChange();
+}
+
+DspLoadMonitor::Load DspLoadMonitor::getPluginLoad (const te::Plugin& plugin) const
+{
+    const auto it = pluginLoads.find (plugin.itemID);
+    return it != pluginLoads.end() ? it->second : Load {};
+}
+
+DspLoadMonitor::Load DspLoadMonitor::getTrackLoad (const te::Track& track) const
+{
+    const auto it = trackLoads.find (track.itemID);
+    return it != trackLoads.end() ? it->second : Load {};
+}
+
+//==============================================================================
+// CSV
+
+juce::String DspLoadMonitor::getCsvHeader()
+{
+    return "time_s,track_index,track,plugin,kind,avg_load_pct,peak_load_pct";
+}
+
+juce::String DspLoadMonitor::toCsvLine (const Row& row)
+{
+    return juce::String (row.timeSeconds, 3)
+         + "," + juce::String (row.trackIndex)
+         + "," + csvQuoted (row.trackName)
+         + "," + csvQuoted (row.pluginName)
+         + "," + row.pluginKind
+         + "," + percent (row.load.average)
+         + "," + percent (row.load.peak);
+}
+
+juce::Result DspLoadMonitor::writeCsv (const juce::File& file) const
+{
+    juce::FileOutputStream out (file);
+
+    if (! out.openedOk())
+        return juce::Result::fail ("Couldn't open " + file.getFullPathName() + " for writing");
+
+    out.setPosition (0);
+    out.truncate();
+    out << getCsvHeader() << "\n";
+
+    for (const auto& row : history)
+        out << toCsvLine (row) << "\n";
+
+    out.flush();
+
+    return out.getStatus();
+}
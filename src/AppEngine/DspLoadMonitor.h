@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../AudioEngine/DspLoadCounter.h"
+#include <tracktion_engine/tracktion_engine.h>
+#include <deque>
+#include <functional>
+#include <map>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Collects per-plugin and per-track DSP load for the mixer.
+ *
+ * Architecture:
+ *  - A message-thread timer polls every audio track's plugins a few times a
+ *    second. Nothing on the audio thread waits for it.
+ *  - MorphSynthPlugin times its own applyToBuffer() with a DspLoadCounter, so
+ *    it reports the average and the worst callback of each poll interval.
+ *  - The drum sampler (te::SamplerPlugin) and external plugins are owned by
+ *    Tracktion, which already times every plugin's processing; for those the
+ *    engine's smoothed per-plugin figure is used (average and peak are equal).
+ *  - A track's load is the sum of its measured plugins.
+ *
+ * Every poll is also kept in a bounded history that writeCsv() dumps, one row
+ * per plugin per poll.
+ */
+class DspLoadMonitor : private juce::Timer
+{
+public:
+    /** Fractions of the real-time budget (1.0 = a whole callback period). */
+    struct Load
+    {
+        double average = 0.0;
+        double peak    = 0.0;
+    };
+
+    /** One plugin's figures from one poll, as written to the CSV. */
+    struct Row
+    {
+        double timeSeconds = 0.0;      ///< Since the monitor started
+        int trackIndex = -1;
+        juce::String trackName;
+        juce::String pluginName;
+        juce::String pluginKind;       ///< "morph", "sampler" or "external"
+        Load load;
+    };
+
+    /** @param getEditToWatch returns the current edit (or nullptr); asked on every poll. */
+    explicit DspLoadMonitor (std::function<te::Edit*()> getEditToWatch);
+    ~DspLoadMonitor() override;
+
+    Load getPluginLoad (const te::Plugin& plugin) const;
+    Load getTrackLoad (const te::Track& track) const;
+
+    /** Writes the collected history (oldest first) to @p file, replacing it. */
+    juce::Result writeCsv (const juce::File& file) const;
+
+    /** Polls once now; normally the timer does this. */
+    void poll();
+
+    /** Called on the message thread after every poll. */
+    std::function<void()> onChange;
+
+    //==============================================================================
+    static constexpr int pollIntervalMs = 250;
+    static constexpr size_t maxHistoryRows = 100000;
+
+    static juce::String getCsvHeader();
+    static juce::String toCsvLine (const Row& row);
+
+private:
+    void timerCallback() override { poll(); }
+
+    std::function<te::Edit*()> getEdit;
+    const te::Edit* lastEdit = nullptr;
+    const double startTimeMs;
+
+    std::map<te::EditItemID, Load> pluginLoads;
+    std::map<te::EditItemID, Load> trackLoads;
+    std::deque<Row> history;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DspLoadMonitor)
+};
@@ -0,0 +1,193 @@
+#include "HeadlessRenderer.h"
+
+#include "AudioExporter.h"
+#include "GrooveKitUIBehaviour.h"
+#include "ProjectLoader.h"
+#include "../PluginManager/PluginScanCache.h"
+#include "../UI/Plugins/Synthesizer/MorphSynthRegistration.h"
+#include "MeterTapPlugin.h"
+#include <iostream>
+
+namespace t = tracktion;
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    juce::File resolvePath (const juce::String& path)
+    {
+        return juce::File::getCurrentWorkingDirectory().getChildFile (path.unquoted());
+    }
+
+    /** Makes plugins found by earlier scans in the GUI app loadable here too. */
+    void addKnownPlugins (te::Engine& engine)
+    {
+        auto& pm = engine.getPluginManager();
+
+       #if JUCE_PLUGINHOST_AU
+        pm.pluginFormatManager.addFormat (new juce::AudioUnitPluginFormat());
+       #endif
+       #if JUCE_PLUGINHOST_VST3
+        pm.pluginFormatManager.addFormat (new juce::VST3PluginFormat());
+       #endif
+
+        PluginScanCache cache (juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                                   .getChildFile ("GrooveKit")
+                                   .getChildFile ("PluginScanCache.xml"));
+
+        if (cache.load())
+            for (const auto& desc : cache.getAllTypes())
+                pm.knownPluginList.addType (desc);
+    }
+}
+
+//==============================================================================
+// Command line
+
+bool HeadlessRenderer::isRenderCommandLine (const juce::StringArray& args)
+{
+    return args.contains (commandLineSwitch);
+}
+
+juce::String HeadlessRenderer::getUsage()
+{
+    return "Usage: GrooveKit --render <in.tracktionedit|.gkproj> <out.wav> [--range start:end] [--sr 48000] [--bits 16|24|32]\n"
+           "  --range  seconds to render (default: the whole edit)\n"
+           "Exit codes: 0 ok, 2 bad arguments, 3 project couldn't be loaded, 4 render failed";
+}
+
+juce::Result HeadlessRenderer::parseCommandLine (const juce::StringArray& args, Options& options)
+{
+    const auto index = args.indexOf (commandLineSwitch);
+    if (index < 0 || index + 2 >= args.size())
+        return juce::Result::fail ("Expected an input and an output file after " + juce::String (commandLineSwitch));
+
+    options.input = resolvePath (args[index + 1]);
+    options.output = resolvePath (args[index + 2]);
+
+    for (int i = index + 3; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const auto value = args[i + 1];
+
+        if (arg == "--range")
+        {
+            if (! value.containsChar (':'))
+                return juce::Result::fail ("--range expects start:end in seconds, got '" + value + "'");
+
+            const auto a = value.upToFirstOccurrenceOf (":", false, false).trim();
+            const auto b = value.fromFirstOccurrenceOf (":", false, false).trim();
+
+            options.rangeStart = a.isEmpty() ? 0.0 : a.getDoubleValue();
+            options.rangeEnd   = b.isEmpty() ? -1.0 : b.getDoubleValue();
+
+            if (options.rangeStart < 0.0 || (options.rangeEnd >= 0.0 && options.rangeEnd <= options.rangeStart))
+                return juce::Result::fail ("Invalid --range '" + value + "'");
+        }
+        else if (arg == "--sr")
+        {
+            options.sampleRate = value.getDoubleValue();
+
+            if (options.sampleRate < 8000.0 || options.sampleRate > 384000.0)
+                return juce::Result::fail ("Invalid --sr '" + value + "'");
+        }
+        else if (arg == "--bits")
+        {
+            options.bitDepth = value.getIntValue();
+
+            if (options.bitDepth != 16 && options.bitDepth != 24 && options.bitDepth != 32)
+                return juce::Result::fail ("--bits must be 16, 24 or 32");
+        }
+        else
+        {
+            return juce::Result::fail ("Unknown option '" + arg + "'");
+        }
+
+        ++i;   // skip the value
+    }
+
+    return juce::Result::ok();
+}
+
+//==============================================================================
+// Rendering
+
+int HeadlessRenderer::run (const juce::StringArray& args)
+{
+    Options options;
+
+    if (const auto parsed = parseCommandLine (args, options); parsed.failed())
+    {
+        std::cerr << parsed.getErrorMessage() << "\n" << getUsage() << std::endl;
+        return usageError;
+    }
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+
+    juce::String error;
+    const auto code = render (options, error);
+
+    if (code != success)
+    {
+        std::cerr << "Render failed: " << error << std::endl;
+        return code;
+    }
+
+    std::cout << "Rendered " << options.input.getFileName() << " -> " << options.output.getFullPathName()
+              << " in " << juce::String ((juce::Time::getMillisecondCounterHiRes() - startMs) / 1000.0, 2) << " s"
+              << std::endl;
+    return success;
+}
+
+int HeadlessRenderer::render (const Options& options, juce::String& error)
+{
+    if (! options.input.existsAsFile())
+    {
+        error = "No such file: " + options.input.getFullPathName();
+        return loadError;
+    }
+
+    te::Engine engine ("GrooveKitRender", std::make_unique<GrooveKitUIBehaviour>(), nullptr);
+    registerMorphSynthCompat (engine);
+    registerMeterTap (engine);
+    addKnownPlugins (engine);
+
+    const auto loaded = ProjectLoader::load (options.input);
+    if (! loaded->state.isValid())
+    {
+        error = loaded->error.isNotEmpty() ? loaded->error : "Not a GrooveKit project: " + options.input.getFullPathName();
+        return loadError;
+    }
+
+    // One render at a time, driven from here rather than the message loop
+    AudioExporter exporter (engine, 1);
+    AudioExporter::Result result;
+
+    // An empty range at the start renders from there to the end of the edit
+    const auto start = t::TimePosition::fromSeconds (options.rangeStart);
+    const auto range = options.rangeEnd >= 0.0 ? t::TimeRange (start, t::TimePosition::fromSeconds (options.rangeEnd))
+                                               : t::TimeRange (start, start);
+
+    const bool started = exporter.startMixdown (loaded->state, options.input, options.output,
+                                                options.sampleRate, options.bitDepth, range, {},
+                                                [&result] (const AudioExporter::Result& r) { result = r; });
+
+    if (! started)
+    {
+        error = "Nothing to render in " + options.input.getFullPathName()
+              + ", or " + options.output.getParentDirectory().getFullPathName() + " can't be created";
+        return renderError;
+    }
+
+    exporter.waitForCompletion (-1);
+
+    if (! result.ok)
+    {
+        error = "Render to " + options.output.getFullPathName() + " failed"
+              + (result.error.isNotEmpty() ? ": " + result.error : juce::String());
+        return renderError;
+    }
+
+    return success;
+}
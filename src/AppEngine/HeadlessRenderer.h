@@ -0,0 +1,59 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Renders a project to an audio file from the command line, with no UI.
+ *
+ *     GrooveKit --render in.tracktionedit out.wav [--range a:b] [--sr 48000] [--bits 24]
+ *
+ * Creates its own te::Engine and loads the edit for rendering (no MainComponent,
+ * AppEngine or audio device), registers the built-in and scanned plugins, then
+ * renders offline with AudioExporter's mixdown as fast as the CPU allows. Any
+ * project format ProjectSaver can read is accepted. The range is in seconds
+ * and defaults to the whole edit.
+ *
+ * Exit codes (see ExitCode) let batch scripts tell bad arguments from broken
+ * projects and failed renders.
+ */
+class HeadlessRenderer
+{
+public:
+    //==============================================================================
+    enum ExitCode
+    {
+        success      = 0,
+        usageError   = 2,   ///< Bad or missing arguments.
+        loadError    = 3,   ///< Input missing or not a readable project.
+        renderError  = 4    ///< The render itself failed, or the output couldn't be written.
+    };
+
+    struct Options
+    {
+        juce::File input;
+        juce::File output;
+        double rangeStart = 0.0;           ///< Seconds.
+        double rangeEnd = -1.0;            ///< Seconds; negative means the end of the edit.
+        double sampleRate = 48000.0;
+        int bitDepth = 24;
+    };
+
+    static constexpr const char* commandLineSwitch = "--render";
+
+    //==============================================================================
+    /** Returns true if @p args ask for a headless render. */
+    static bool isRenderCommandLine (const juce::StringArray& args);
+
+    /** Parses `--render in out [--range a:b] [--sr n] [--bits n]` (paths relative to the working directory). */
+    static juce::Result parseCommandLine (const juce::StringArray& args, Options& options);
+
+    /** Parses, renders and reports to stdout/stderr; returns the process exit code. */
+    static int run (const juce::StringArray& args);
+
+    /** Renders with @p options; on failure @p error says why. Returns an ExitCode. */
+    static int render (const Options& options, juce::String& error);
+
+    static juce::String getUsage();
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "../AudioEngine/MeterTap.h"
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Pass-through plugin that feeds a track's (or the master's) audio to a MeterTap.
+ *
+ * One sits right after Tracktion's own LevelMeterPlugin on every audio track
+ * and at the end of the master plugin list (Tracktion applies the master
+ * fader after that list, so AppEngine adds the fader gain to its readings).
+ * TrackManager adds them; the Mix view reads them through AppEngine. The
+ * audio is never modified.
+ */
+class MeterTapPlugin final : public te::Plugin
+{
+public:
+    /** Stable XML/plugin type id (must match registration). */
+    static inline const juce::String pluginType { "groovekitmetertap" };
+
+    explicit MeterTapPlugin (const te::PluginCreationInfo& info) : te::Plugin (info) {}
+
+    //==============================================================================
+    juce::String getName() const override                   { return "Meter Tap"; }
+    juce::String getPluginType() override                   { return pluginType; }
+    juce::String getSelectableDescription() override        { return getName(); }
+
+    void initialise (const te::PluginInitialisationInfo& info) override    { meter.prepare (info.sampleRate); }
+    void deinitialise() override                                           {}
+
+    void applyToBuffer (const te::PluginRenderContext& rc) override
+    {
+        if (rc.destBuffer != nullptr)
+            meter.process (*rc.destBuffer, rc.bufferStartSample, rc.bufferNumSamples);
+    }
+
+    //==============================================================================
+    /** Any thread: see MeterTap::read(). */
+    MeterTap::Readings readMeter() noexcept                 { return meter.read(); }
+
+private:
+    MeterTap meter;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterTapPlugin)
+};
+
+/** Tracktion built-in type, so saved edits containing taps load again. */
+struct MeterTapBuiltIn : public te::PluginManager::BuiltInType
+{
+    MeterTapBuiltIn() : te::PluginManager::BuiltInType (MeterTapPlugin::pluginType) {}
+
+    te::Plugin::Ptr create (te::PluginCreationInfo info) override
+    {
+        return new MeterTapPlugin (info);
+    }
+};
+
+/** Call once after the Engine is constructed (next to registerMorphSynthCompat). */
+inline void registerMeterTap (te::Engine& engine)
+{
+    engine.getPluginManager().registerBuiltInType (std::make_unique<MeterTapBuiltIn>());
+}
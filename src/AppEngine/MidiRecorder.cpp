@@ -4,12 +4,72 @@ using namespace juce;
 namespace te = tracktion::engine;
 namespace t = tracktion;
 
+namespace
+{
+    /**
+     * Single-pass note pairing shared by both pairRecordedNotes() overloads.
+     * @p getMessage maps an element of @p recorded to its juce::MidiMessage.
+     */
+    template <typename Events, typename GetMessage>
+    std::vector<MidiRecorder::RecordedNote> pairNotes(const Events& recorded, size_t numEvents, GetMessage&& getMessage)
+    {
+        constexpr int numKeys = 16 * 128;
+        constexpr double defaultNoteLength = 0.1; // 100ms if no note-off found
+
+        std::vector<MidiRecorder::RecordedNote> notes;
+        notes.reserve(numEvents / 2 + 1);
+
+        // Open notes form one intrusive stack per (channel, note): top[key] is the most
+        // recent unmatched note-on, below[i] the one opened before notes[i].
+        std::array<int, numKeys> top;
+        top.fill(-1);
+        std::vector<int> below;
+        below.reserve(notes.capacity());
+
+        auto keyFor = [](const juce::MidiMessage& msg)
+        {
+            return (juce::jlimit(1, 16, msg.getChannel()) - 1) * 128 + msg.getNoteNumber();
+        };
+
+        for (const auto& event : recorded)
+        {
+            const juce::MidiMessage& msg = getMessage(event);
+
+            if (msg.isNoteOn())
+            {
+                const int key = keyFor(msg);
+                const double start = msg.getTimeStamp();
+
+                notes.push_back({msg.getNoteNumber(), msg.getChannel(), start, start + defaultNoteLength,
+                                 msg.getFloatVelocity()});
+                below.push_back(top[(size_t) key]);
+                top[(size_t) key] = (int) notes.size() - 1;
+            }
+            else if (msg.isNoteOff())
+            {
+                const int key = keyFor(msg);
+                const int open = top[(size_t) key];
+
+                if (open >= 0)
+                {
+                    notes[(size_t) open].endSeconds = msg.getTimeStamp();
+                    top[(size_t) key] = below[(size_t) open];
+                }
+            }
+        }
+
+        return notes;
+    }
+}
+
 //==============================================================================
 // Construction / Destruction
 
 MidiRecorder::MidiRecorder(te::Engine& eng)
     : engine(eng)
 {
+    drainScratch.reserve(1024);
+    engine.getDeviceManager().deviceManager.addAudioCallback(&audioClock);
 }
 
 MidiRecorder::~MidiRecorder()
@@ -18,6 +78,7 @@ MidiRecorder::~MidiRecorder()
         stopRecording(*currentEdit);
 
     detachFromAllSources();
+    engine.getDeviceManager().deviceManager.removeAudioCallback(&audioClock);
 }
 
 //==============================================================================
@@ -57,12 +118,20 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
                           " clip(s) on track during recording");
     }
 
-    // Clear previous recording buffer
-    {
-        const ScopedLock sl(recordingLock);
-        recordedSequence.clear();
-        activeNotes.clear();
-    }
+    // Clear previous take buffers (listeners are detached, so nothing else touches them).
+    // Buffers keep their capacity, so recording appends without reallocating.
+    if (takes.empty())
+        takes.emplace_back().reserve(takeCapacity);
+
+    for (auto& take : takes)
+        take.clear();
+
+    currentTake = 0;
+    activeNotes.clear();
+    captures.clear();
+    droppedEvents = 0;
+    anchored = false;
+    currentPass = 0;
 
     // Attach to hardware MIDI devices
     attachToHardwareMidiDevices(edit);
@@ -70,8 +139,7 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
     // Attach to QWERTY keyboard if provided
     if (qwertyKeyboardState != nullptr)
     {
-        qwertyKeyboardState->addListener(this);
-        attachedSources.push_back(qwertyKeyboardState);
+        attachSource(*qwertyKeyboardState);
         Logger::writeToLog("[MidiRecorder] Attached to QWERTY keyboard state");
     }
 
@@ -93,11 +161,16 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
                           String(recordingStartPosition.inSeconds()) + " seconds");
     }
 
-    // Initialize last recorded position for loop detection
-    lastRecordedPosition = recordingStartPosition;
+    loopRecording = transport.looping;
+    loopRange = transport.getLoopRange();
 
-    // Start transport if not already playing
-    if (!transport.isPlaying())
+    // Start transport if not already playing. The audio clock is anchored to the
+    // transport once it is running (here, or on the first drain after it starts).
+    if (transport.isPlaying())
+    {
+        anchorToTransport();
+    }
+    else
     {
         if (transport.looping)
             transport.setPosition(transport.getLoopRange().getStart());
@@ -122,56 +195,48 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
 
     recording = false;
 
+    // Stop listening first: once removeListener() returns no callback is still
+    // pushing, so the final drain below sees every captured event.
+    auto sources = attachedSources;
+    detachFromAllSources();
+    drainCapturedEvents();
+
     // Handle any notes that are still being held down
-    // Synthesize note-off events at the current transport position
-    std::set<int> heldNotes;
-    {
-        const ScopedLock sl(recordingLock);
-        heldNotes = activeNotes;  // Copy the set
-    }
+    // Synthesize note-off events at the current audio clock position
+    auto heldNotes = activeNotes;
 
     if (!heldNotes.empty())
     {
         Logger::writeToLog("[MidiRecorder] Synthesizing note-offs for " +
                           String(heldNotes.size()) + " held note(s)");
 
-        auto& transport = edit.getTransport();
-        auto currentPosition = transport.getPosition();
-        auto timeSinceRecordingStart = currentPosition - recordingStartPosition;
-        double relativeTime = timeSinceRecordingStart.inSeconds();
+        double relativeTime = placeSample(audioClock.getSamplePosition()).relativeSeconds;
 
-        for (int noteNumber : heldNotes)
+        for (auto [channel, noteNumber] : heldNotes)
         {
             // Add note-off to the recording sequence at current position
-            auto noteOffMessage = juce::MidiMessage::noteOff(1, noteNumber, 0.0f);
+            auto noteOffMessage = juce::MidiMessage::noteOff(channel, noteNumber, 0.0f);
             noteOffMessage.setTimeStamp(relativeTime);
-
-            {
-                const ScopedLock sl(recordingLock);
-                recordedSequence.addEvent(noteOffMessage);
-            }
+            takes[(size_t) currentTake].push_back(noteOffMessage);
 
             Logger::writeToLog("[MidiRecorder] Synthesized note-off for note " + String(noteNumber));
         }
     }
 
-    // Send note-offs to all attached keyboard states to stop any hanging notes in the synth
-    for (auto* keyboardState : attachedSources)
+    // Send note-offs to all previously attached keyboard states to stop any hanging notes in the synth
+    for (auto* keyboardState : sources)
     {
         if (keyboardState != nullptr)
         {
-            for (int noteNumber : heldNotes)
+            for (auto [channel, noteNumber] : heldNotes)
             {
-                keyboardState->noteOff(1, noteNumber, 0.0f);
+                keyboardState->noteOff(channel, noteNumber, 0.0f);
             }
         }
     }
 
     // Clear active notes tracking
-    {
-        const ScopedLock sl(recordingLock);
-        activeNotes.clear();
-    }
+    activeNotes.clear();
 
     // Restore clips' original mute states
     for (auto& [clip, wasMuted] : clipsToRestore)
@@ -182,18 +247,17 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
                       String(clipsToRestore.size()) + " clip(s)");
     clipsToRestore.clear();
 
-    // Detach from all sources
-    detachFromAllSources();
-
     // Check how many events we recorded
     int noteCount = 0;
-    {
-        const ScopedLock sl(recordingLock);
-        noteCount = recordedSequence.getNumEvents();
-    }
+    for (const auto& take : takes)
+        noteCount += (int) take.size();
 
     Logger::writeToLog("[MidiRecorder] Captured " + String(noteCount) + " MIDI events");
 
+    if (droppedEvents > 0)
+        Logger::writeToLog("[MidiRecorder] WARNING: " + String(droppedEvents.load()) +
+                          " MIDI event(s) dropped (capture FIFO full)");
+
     if (noteCount == 0)
     {
         Logger::writeToLog("[MidiRecorder] No MIDI events recorded - skipping clip creation");
@@ -219,25 +283,9 @@ tracktion::TimeRange MidiRecorder::getPreviewClipBounds() const
     auto& transport = currentEdit->getTransport();
     auto currentPos = transport.getPosition();
 
-    // Detect loop wraparound proactively (even if no MIDI is being played)
-    // This ensures the buffer clears when looping, even during silence
-    if (transport.looping)
-    {
-        auto loopRange = transport.getLoopRange();
-
-        // Check if we wrapped from near the end back to near the start
-        if (lastRecordedPosition > loopRange.getStart() &&
-            currentPos < lastRecordedPosition)
-        {
-            // Loop wraparound detected - clear the buffer
-            // Need to cast away const since we're modifying state, but this is
-            // called from UI thread at 30Hz so it's safe
-            const_cast<MidiRecorder*>(this)->handleLoopWraparound();
-        }
-    }
-
-    // Update last position (cast away const - safe because called from UI thread)
-    const_cast<MidiRecorder*>(this)->lastRecordedPosition = currentPos;
+    // Pull captured events and detect loop wraparound proactively (even if no
+    // MIDI is being played). Cast away const - safe because called from UI thread.
+    const_cast<MidiRecorder*>(this)->drainCapturedEvents();
 
     // Return range from recording start position to current transport position
     return tracktion::TimeRange(recordingStartPosition, currentPos);
@@ -252,18 +300,9 @@ void MidiRecorder::handleNoteOn(juce::MidiKeyboardState* source, int midiChannel
     if (!recording)
         return;
 
-    auto message = MidiMessage::noteOn(midiChannel, midiNoteNumber, velocity);
-    recordMidiMessage(message);
+    captureEvent(source, midiChannel, midiNoteNumber, velocity, true);
 
-    // Track this note as active (held down)
-    {
-        const ScopedLock sl(recordingLock);
-        activeNotes.insert(midiNoteNumber);
-    }
-
-    Logger::writeToLog("[MidiRecorder] NOTE ON:  Note=" + String(midiNoteNumber) +
-                      " Velocity=" + String(velocity, 2) +
-                      " Channel=" + String(midiChannel));
+    rtLog->log(RtLog::Level::debug, RtLog::Event::recorderNoteOn, midiChannel, midiNoteNumber, 0, velocity);
 }
 
 void MidiRecorder::handleNoteOff(juce::MidiKeyboardState* source, int midiChannel,
@@ -272,33 +311,11 @@ void MidiRecorder::handleNoteOff(juce::MidiKeyboardState* source, int midiChanne
     if (!recording)
         return;
 
-    // Check if this note-off has a corresponding note-on in the buffer
-    // If not, discard it (this happens when holding notes across loop boundary)
-    bool hasMatchingNoteOn = false;
-    {
-        const ScopedLock sl(recordingLock);
-        hasMatchingNoteOn = activeNotes.count(midiNoteNumber) > 0;
-    }
+    // Orphaned note-offs (notes held across a loop boundary) are discarded when
+    // the FIFO is drained on the message thread.
+    captureEvent(source, midiChannel, midiNoteNumber, velocity, false);
 
-    if (!hasMatchingNoteOn)
-    {
-        Logger::writeToLog("[MidiRecorder] Discarding orphaned NOTE OFF (no matching note-on): Note=" +
-                          String(midiNoteNumber));
-        return;
-    }
-
-    auto message = MidiMessage::noteOff(midiChannel, midiNoteNumber, velocity);
-    recordMidiMessage(message);
-
-    // Remove this note from active set
-    {
-        const ScopedLock sl(recordingLock);
-        activeNotes.erase(midiNoteNumber);
-    }
-
-    Logger::writeToLog("[MidiRecorder] NOTE OFF: Note=" + String(midiNoteNumber) +
-                      " Velocity=" + String(velocity, 2) +
-                      " Channel=" + String(midiChannel));
+    rtLog->log(RtLog::Level::debug, RtLog::Event::recorderNoteOff, midiChannel, midiNoteNumber, 0, velocity);
 }
 
 //==============================================================================
@@ -312,8 +329,7 @@ void MidiRecorder::attachToHardwareMidiDevices(te::Edit& edit)
     {
         if (midiIn->isEnabled())
         {
-            midiIn->keyboardState.addListener(this);
-            attachedSources.push_back(&midiIn->keyboardState);
+            attachSource(midiIn->keyboardState);
             deviceCount++;
 
             Logger::writeToLog("[MidiRecorder] Attached to MIDI device: " + midiIn->getName());
@@ -413,68 +429,91 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
         return false;
     }
 
-    // Populate clip with recorded MIDI events
-    auto& sequence = targetClip->getSequence();
-    auto& tempoSequence = edit.tempoSequence;
-
     int notesAdded = 0;
-    {
-        const ScopedLock sl(recordingLock);
 
-        for (int i = 0; i < recordedSequence.getNumEvents(); ++i)
-        {
-            auto* event = recordedSequence.getEventPointer(i);
-            const auto& msg = event->message;
+    std::vector<const std::vector<juce::MidiMessage>*> filledTakes;
+    for (const auto& take : takes)
+        if (!take.empty())
+            filledTakes.push_back(&take);
 
-            if (msg.isNoteOn())
-            {
-                // Find corresponding note-off
-                double noteStart = event->message.getTimeStamp();
-                double noteEnd = noteStart + 0.1; // Default 100ms if no note-off found
+    if (loopRecordMode == LoopRecordMode::takes && filledTakes.size() > 1)
+    {
+        // One take lane per loop pass; the last pass is the active take and the
+        // others stay available for comping.
+        for (auto* take : filledTakes)
+        {
+            juce::MidiMessageSequence takeSequence;
+            for (const auto& msg : *take)
+                takeSequence.addEvent(msg);
 
-                for (int j = i + 1; j < recordedSequence.getNumEvents(); ++j)
-                {
-                    auto* offEvent = recordedSequence.getEventPointer(j);
-                    if (offEvent->message.isNoteOff() &&
-                        offEvent->message.getNoteNumber() == msg.getNoteNumber())
-                    {
-                        noteEnd = offEvent->message.getTimeStamp();
-                        break;
-                    }
-                }
+            takeSequence.updateMatchedPairs();
+            targetClip->addTake(takeSequence, te::MidiList::NoteAutomationType::none);
+            notesAdded += (int) pairRecordedNotes(*take).size();
+        }
 
-                // Convert time to beat positions
-                auto noteStartTime = clipStart + t::TimeDuration::fromSeconds(noteStart);
-                auto noteEndTime = clipStart + t::TimeDuration::fromSeconds(noteEnd);
+        targetClip->setCurrentTake((int) filledTakes.size() - 1);
+        Logger::writeToLog("[MidiRecorder] Added " + String((int) filledTakes.size()) + " take lanes");
+    }
+    else
+    {
+        // Populate clip with recorded MIDI events. The notes go into a detached copy of
+        // the clip's state, which then replaces the empty clip in one step: adding them
+        // to the live list (MidiList::addNote() or its state) notifies the list's
+        // listeners and looks the new note up after every insert.
+        auto clipState = targetClip->state.createCopy();
+        auto sequenceState = clipState.getOrCreateChildWithName(te::IDs::SEQUENCE, nullptr);
+        auto& tempoSequence = edit.tempoSequence;
+        const auto clipStartBeat = tempoSequence.toBeats(clipStart);
+
+        // Everything that was recorded goes into the one clip: a single take (the
+        // current one may still be empty if recording stopped right after a wrap),
+        // or every pass if the mode changed to overdub while takes were running.
+        std::vector<RecordedNote> recordedNotes;
+        for (auto* take : filledTakes)
+        {
+            auto takeNotes = pairRecordedNotes(*take);
+            recordedNotes.insert(recordedNotes.end(), takeNotes.begin(), takeNotes.end());
+        }
 
-                auto noteStartBeat = tempoSequence.toBeats(noteStartTime);
-                auto noteEndBeat = tempoSequence.toBeats(noteEndTime);
+        // Overdubbed passes are appended one after another, so restore time order
+        std::stable_sort(recordedNotes.begin(), recordedNotes.end(),
+                         [](const RecordedNote& a, const RecordedNote& b)
+                         { return a.startSeconds < b.startSeconds; });
 
-                double noteLength = noteEndBeat.inBeats() - noteStartBeat.inBeats();
+        for (const auto& note : recordedNotes)
+        {
+            // Convert time to beat positions (relative to clip start)
+            auto noteStartBeat = tempoSequence.toBeats(clipStart + t::TimeDuration::fromSeconds(note.startSeconds));
+            auto noteEndBeat = tempoSequence.toBeats(clipStart + t::TimeDuration::fromSeconds(note.endSeconds));
+
+            // Same properties MidiList::addNote() writes: pitch, start beat, length, velocity, colour
+            juce::ValueTree noteState(te::IDs::NOTE);
+            noteState.setProperty(te::IDs::p, note.noteNumber, nullptr);
+            noteState.setProperty(te::IDs::b, noteStartBeat.inBeats() - clipStartBeat.inBeats(), nullptr);
+            noteState.setProperty(te::IDs::l, juce::jmax(0.0, noteEndBeat.inBeats() - noteStartBeat.inBeats()), nullptr);
+            noteState.setProperty(te::IDs::v, juce::jlimit(1, 127, juce::roundToInt(note.velocity * 127.0f)), nullptr);
+            noteState.setProperty(te::IDs::c, 0, nullptr);
+
+            sequenceState.appendChild(noteState, nullptr); // detached: no listeners
+        }
 
-                // Add note to clip (beat positions are relative to clip start)
-                auto clipStartBeat = tempoSequence.toBeats(clipStart);
-                double relativeBeatPosition = noteStartBeat.inBeats() - clipStartBeat.inBeats();
+        // Swap the filled clip in where the empty one was; a fresh ID so the two never coexist
+        auto trackState = targetClip->state.getParent();
+        const int clipIndex = trackState.indexOf(targetClip->state);
+        edit.createNewItemID().writeID(clipState, nullptr);
 
-                sequence.addNote(msg.getNoteNumber(),
-                                t::BeatPosition::fromBeats(relativeBeatPosition),
-                                t::BeatDuration::fromBeats(noteLength),
-                                static_cast<int>(msg.getFloatVelocity() * 127.0f), // Convert to 0-127
-                                0, // color index
-                                nullptr); // undo manager
+        targetClip->removeFromParent();
+        targetClip = nullptr;
+        trackState.addChild(clipState, clipIndex, nullptr);
 
-                notesAdded++;
-            }
-        }
+        notesAdded = (int) recordedNotes.size();
     }
 
     Logger::writeToLog("[MidiRecorder] Added " + String(notesAdded) + " notes to clip");
 
-    // Clear recorded sequence for next recording
-    {
-        const ScopedLock sl(recordingLock);
-        recordedSequence.clear();
-    }
+    // Clear take buffers for next recording (capacity is kept)
+    for (auto& take : takes)
+        take.clear();
 
     // Always return true if we created a clip (even if empty)
     // This matches the preview behavior - clip exists from first note position to end
@@ -483,49 +522,216 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
 
 void MidiRecorder::handleLoopWraparound()
 {
-    Logger::writeToLog("[MidiRecorder] Loop wraparound detected - clearing recording buffer");
+    if (loopRecordMode == LoopRecordMode::replace)
+    {
+        rtLog->log(RtLog::Level::info, RtLog::Event::recorderLoopReplace);
 
-    // Clear the buffer to start a fresh recording pass
-    const ScopedLock sl(recordingLock);
-    recordedSequence.clear();
-    activeNotes.clear();  // Clear held notes from previous loop pass
+        // Clear the buffer to start a fresh recording pass (message thread only)
+        takes[(size_t) currentTake].clear();
+        activeNotes.clear();  // Clear held notes from previous loop pass
+        return;
+    }
+
+    // Overdub / takes: keep the pass. Notes still held are closed at the loop end
+    // so every pass pairs on its own; their later note-offs are discarded as orphans.
+    const double loopEnd = (loopRange.getEnd() - recordingStartPosition).inSeconds();
+    auto& take = takes[(size_t) currentTake];
+
+    for (auto [channel, noteNumber] : activeNotes)
+        take.push_back(MidiMessage::noteOff(channel, noteNumber, 0.0f).withTimeStamp(loopEnd));
+
+    activeNotes.clear();
+
+    if (loopRecordMode == LoopRecordMode::takes)
+    {
+        rtLog->log(RtLog::Level::info, RtLog::Event::recorderLoopNewTake, 0, currentTake + 2);
+        startNewTake();
+    }
+    else
+    {
+        rtLog->log(RtLog::Level::info, RtLog::Event::recorderLoopOverdub);
+    }
 }
 
-void MidiRecorder::recordMidiMessage(const juce::MidiMessage& message)
+void MidiRecorder::startNewTake()
 {
-    if (!currentEdit)
+    ++currentTake;
+
+    if ((size_t) currentTake < takes.size())
+        takes[(size_t) currentTake].clear();
+    else
+        takes.emplace_back().reserve(takeCapacity);
+}
+
+void MidiRecorder::setLoopRecordMode(LoopRecordMode mode)
+{
+    loopRecordMode = mode;
+}
+
+std::vector<MidiRecorder::RecordedNote> MidiRecorder::pairRecordedNotes(const juce::MidiMessageSequence& recorded)
+{
+    return pairNotes(recorded, (size_t) recorded.getNumEvents(),
+                     [](const juce::MidiMessageSequence::MidiEventHolder* event) -> const juce::MidiMessage&
+                     { return event->message; });
+}
+
+std::vector<MidiRecorder::RecordedNote> MidiRecorder::pairRecordedNotes(const std::vector<juce::MidiMessage>& recorded)
+{
+    return pairNotes(recorded, recorded.size(),
+                     [](const juce::MidiMessage& msg) -> const juce::MidiMessage& { return msg; });
+}
+
+//==============================================================================
+// Capture Path
+
+void MidiRecorder::attachSource(juce::MidiKeyboardState& source)
+{
+    auto capture = std::make_unique<SourceCapture>();
+    capture->source = &source;
+    captures.push_back(std::move(capture));
+
+    attachedSources.push_back(&source);
+    source.addListener(this);
+}
+
+void MidiRecorder::captureEvent(juce::MidiKeyboardState* source, int midiChannel,
+                                int midiNoteNumber, float velocity, bool isNoteOn)
+{
+    // Stamp first, so queueing cost never shows up in the timing
+    const auto samplePosition = audioClock.getSamplePosition();
+
+    for (auto& capture : captures)
+    {
+        if (capture->source != source)
+            continue;
+
+        const auto scope = capture->fifo.write(1);
+
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+        {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto& event = capture->events[(size_t) (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+        event.samplePosition = samplePosition;
+        event.velocity = velocity;
+        event.channel = (juce::uint8) midiChannel;
+        event.noteNumber = (juce::uint8) midiNoteNumber;
+        event.isNoteOn = isNoteOn;
         return;
+    }
+}
 
-    auto& transport = currentEdit->getTransport();
-    auto currentPosition = transport.getPosition();
+void MidiRecorder::anchorToTransport()
+{
+    if (currentEdit == nullptr)
+        return;
 
-    // Detect loop wraparound: if looping is enabled and the position jumped backwards significantly
-    if (transport.looping)
+    // The transport position advances once per audio block, so pair it with the
+    // clock's block start rather than an interpolated "now".
+    anchorSample = audioClock.getBlockStartSample();
+    anchorPosition = currentEdit->getTransport().getPosition();
+    anchored = true;
+}
+
+MidiRecorder::Placement MidiRecorder::placeSample(juce::int64 samplePosition) const
+{
+    Placement placement;
+
+    const double seconds = juce::jmax(0.0, (double) (samplePosition - anchorSample) / audioClock.getSampleRate());
+    double position = anchorPosition.inSeconds() + seconds;
+
+    if (loopRecording)
     {
-        auto loopRange = transport.getLoopRange();
+        const double loopStart = loopRange.getStart().inSeconds();
+        const double loopLength = loopRange.getLength().inSeconds();
+        const double intoLoop = position - loopStart;
 
-        // Check if we wrapped from near the end back to near the start
-        if (lastRecordedPosition > loopRange.getStart() &&
-            currentPosition < lastRecordedPosition)
+        if (loopLength > 0.0 && intoLoop >= 0.0)
         {
-            handleLoopWraparound();
+            placement.pass = (int) std::floor(intoLoop / loopLength);
+            position = loopStart + (intoLoop - placement.pass * loopLength);
         }
     }
 
-    lastRecordedPosition = currentPosition;
+    placement.relativeSeconds = position - recordingStartPosition.inSeconds();
+    return placement;
+}
+
+void MidiRecorder::drainCapturedEvents()
+{
+    if (currentEdit == nullptr)
+        return;
+
+    // Events stay queued until the clock is tied to a running transport
+    if (!anchored)
+    {
+        if (!currentEdit->getTransport().isPlaying() && recording)
+            return;
+
+        anchorToTransport();
+    }
+
+    drainScratch.clear();
+
+    for (auto& capture : captures)
+    {
+        const auto scope = capture->fifo.read(capture->fifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            drainScratch.push_back(capture->events[(size_t) (scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            drainScratch.push_back(capture->events[(size_t) (scope.startIndex2 + i)]);
+    }
+
+    // Merge sources into arrival order
+    std::stable_sort(drainScratch.begin(), drainScratch.end(),
+                     [](const CapturedEvent& a, const CapturedEvent& b)
+                     { return a.samplePosition < b.samplePosition; });
+
+    for (const auto& event : drainScratch)
+    {
+        const auto placement = placeSample(event.samplePosition);
+
+        if (placement.pass < currentPass)
+            continue;  // Late event from a pass that has already been discarded
+
+        enterLoopPass(placement.pass);
+
+        addRecordedEvent(event.channel, event.noteNumber, event.velocity, event.isNoteOn, placement.relativeSeconds);
+    }
+
+    // Detect wraparound during silence too
+    if (recording)
+        enterLoopPass(placeSample(audioClock.getSamplePosition()).pass);
+}
 
-    // Calculate timestamp based on transport position, not wall-clock time
-    // This ensures notes are positioned correctly even after loop wraparound
-    auto timeSinceRecordingStart = currentPosition - recordingStartPosition;
-    double relativeTime = timeSinceRecordingStart.inSeconds();
+void MidiRecorder::enterLoopPass(int pass)
+{
+    if (pass <= currentPass)
+        return;
 
-    // Create timestamped message
-    auto timestampedMessage = message;
-    timestampedMessage.setTimeStamp(relativeTime);
+    handleLoopWraparound();
+    currentPass = pass;
+}
 
-    // Add to sequence (thread-safe)
+void MidiRecorder::addRecordedEvent(int midiChannel, int midiNoteNumber, float velocity, bool isNoteOn,
+                                    double relativeSeconds)
+{
+    if (isNoteOn)
     {
-        const ScopedLock sl(recordingLock);
-        recordedSequence.addEvent(timestampedMessage);
+        activeNotes.insert({midiChannel, midiNoteNumber});
     }
+    else if (activeNotes.erase({midiChannel, midiNoteNumber}) == 0)
+    {
+        rtLog->log(RtLog::Level::warning, RtLog::Event::recorderOrphanNoteOff, midiChannel, midiNoteNumber);
+        return;
+    }
+
+    auto message = isNoteOn ? MidiMessage::noteOn(midiChannel, midiNoteNumber, velocity)
+                            : MidiMessage::noteOff(midiChannel, midiNoteNumber, velocity);
+    message.setTimeStamp(relativeSeconds);
+    takes[(size_t) currentTake].push_back(message);
 }
@@ -3,6 +3,12 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include "AudioClock.h"
+#include "../AudioEngine/RtLog.h"
+#include <array>
+#include <memory>
+#include <set>
+#include <vector>
 
 namespace te = tracktion::engine;
 
@@ -14,10 +20,18 @@ namespace te = tracktion::engine;
  * recording sessions. It stores timestamped MIDI events and converts them to MIDI clips
  * when recording stops.
  *
+ * Threading:
+ *  - Listener callbacks (MIDI input threads, message thread for QWERTY) only stamp
+ *    each event with the AudioClock sample position and push it into a per-source
+ *    single-producer/single-consumer FIFO. No locks, no transport access.
+ *  - The message thread drains the FIFOs (getPreviewClipBounds() at UI rate and
+ *    stopRecording()), maps sample positions onto the timeline, handles loop passes
+ *    and pairs note-offs, then builds the clip.
+ *
  * Usage:
  *  1. Call startRecording() with target track and edit
  *  2. MidiRecorder attaches listeners to hardware and QWERTY keyboard states
- *  3. MIDI events are captured with accurate timestamps
+ *  3. MIDI events are captured with sample-accurate timestamps
  *  4. Call stopRecording() to create a MIDI clip from the recorded data
  *
  * This approach works around issues in Tracktion Engine's recording API where
@@ -82,10 +96,41 @@ public:
      * from when the first MIDI note was captured to the current transport position.
      * Returns an empty range if no notes have been recorded yet.
      *
+     * Must be called on the message thread; also drains captured events and
+     * detects loop wraparound.
+     *
      * @return TimeRange representing the preview clip bounds, or empty if no notes recorded.
      */
     tracktion::TimeRange getPreviewClipBounds() const;
 
+    //==============================================================================
+    // Loop Recording
+
+    /** What loop recording keeps when the transport wraps back to the loop start. */
+    enum class LoopRecordMode
+    {
+        replace,    ///< Keep only the last pass (each wrap clears the buffer).
+        overdub,    ///< Merge every pass into one take.
+        takes       ///< Keep each pass as its own take lane for comping.
+    };
+
+    /** Sets the loop recording mode (message thread; applies from the next wrap). */
+    void setLoopRecordMode(LoopRecordMode mode);
+
+    /** Returns the current loop recording mode. */
+    LoopRecordMode getLoopRecordMode() const { return loopRecordMode; }
+
+    /** Returns how many takes the current recording has started (1 unless recording takes). */
+    int getNumTakes() const { return currentTake + 1; }
+
+    /**
+     * @brief Moves on to loop pass @p pass (message thread).
+     *
+     * Called when the transport is found to have wrapped; passes already
+     * entered are ignored. Public so tests can drive loop recording.
+     */
+    void enterLoopPass(int pass);
+
     /**
      * @brief Returns the track index currently being recorded to.
      *
@@ -93,6 +138,50 @@ public:
      */
     int getRecordingTrackIndex() const { return targetTrackIndex; }
 
+    /**
+     * @brief Returns how many events were lost because a capture FIFO was full.
+     *
+     * Non-zero only if the message thread stalls for a long time while many events
+     * arrive. Reset by startRecording().
+     */
+    int getDroppedEventCount() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Adds a note event @p relativeSeconds after the recording start (message thread).
+     *
+     * Drained events end up here: held notes are tracked and note-offs without a
+     * note-on are dropped. Public so tests can record without an audio device.
+     */
+    void addRecordedEvent(int midiChannel, int midiNoteNumber, float velocity, bool isNoteOn, double relativeSeconds);
+
+    //==============================================================================
+    // Note Pairing
+
+    /** A note assembled from a recorded note-on and its note-off. */
+    struct RecordedNote
+    {
+        int noteNumber = 0;
+        int channel = 1;
+        double startSeconds = 0.0;          ///< Seconds from recording start.
+        double endSeconds = 0.0;            ///< Note-off time, or start + 100ms if none was recorded.
+        float velocity = 0.0f;              ///< 0.0-1.0.
+    };
+
+    /**
+     * @brief Pairs each note-on with its note-off in a single pass.
+     *
+     * Keeps a stack of open notes per (channel, note number), so a note-off
+     * closes the most recent unmatched note-on with the same key. Runs in
+     * O(n) for n events; notes are returned in note-on order.
+     *
+     * @param recorded Time-ordered sequence with timestamps in seconds.
+     * @return One entry per note-on.
+     */
+    static std::vector<RecordedNote> pairRecordedNotes(const juce::MidiMessageSequence& recorded);
+
+    /** Same as above for a take buffer (events in recording order). */
+    static std::vector<RecordedNote> pairRecordedNotes(const std::vector<juce::MidiMessage>& recorded);
+
     //==============================================================================
     // MidiKeyboardStateListener Implementation
 
@@ -100,7 +189,7 @@ public:
      * @brief Handles note-on events during recording.
      *
      * Called when a MIDI note-on is received from any attached keyboard state.
-     * Stores the note-on message with timestamp in the recording buffer.
+     * Pushes the note-on with its audio-clock sample position into the source's FIFO.
      *
      * @param source The keyboard state that triggered the event.
      * @param midiChannel MIDI channel (1-16).
@@ -114,7 +203,7 @@ public:
      * @brief Handles note-off events during recording.
      *
      * Called when a MIDI note-off is received from any attached keyboard state.
-     * Stores the note-off message with timestamp in the recording buffer.
+     * Pushes the note-off with its audio-clock sample position into the source's FIFO.
      *
      * @param source The keyboard state that triggered the event.
      * @param midiChannel MIDI channel (1-16).
@@ -148,21 +237,70 @@ private:
      */
     bool createClipFromRecording(te::Edit& edit);
 
+    /** A note event as captured on the delivering thread. */
+    struct CapturedEvent
+    {
+        juce::int64 samplePosition = 0;   ///< AudioClock position at arrival.
+        float velocity = 0.0f;
+        juce::uint8 channel = 1;
+        juce::uint8 noteNumber = 0;
+        bool isNoteOn = false;
+    };
+
+    /** Lock-free SPSC queue for one keyboard state (producer: its delivering thread). */
+    struct SourceCapture
+    {
+        static constexpr int capacity = 4096;
+
+        juce::MidiKeyboardState* source = nullptr;
+        juce::AbstractFifo fifo{capacity};
+        std::array<CapturedEvent, capacity> events{};
+    };
+
     /**
-     * @brief Records a MIDI message with the current timestamp.
+     * @brief Stamps a note event and pushes it into the FIFO for its source.
      *
-     * @param message The MIDI message to record.
+     * Called from listener callbacks. Lock-free; never touches the transport.
      */
-    void recordMidiMessage(const juce::MidiMessage& message);
+    void captureEvent(juce::MidiKeyboardState* source, int midiChannel,
+                      int midiNoteNumber, float velocity, bool isNoteOn);
+
+    /** Adds a FIFO for @p source and starts listening to it (message thread). */
+    void attachSource(juce::MidiKeyboardState& source);
+
+    /**
+     * @brief Moves captured events into the current take (message thread).
+     *
+     * Maps sample positions onto the timeline, starts a new pass when the loop
+     * wraps, drops events from earlier passes and note-offs without a note-on.
+     */
+    void drainCapturedEvents();
+
+    /** Ties the audio clock to the transport position (once the transport runs). */
+    void anchorToTransport();
+
+    /** Timeline placement of an audio-clock sample position. */
+    struct Placement
+    {
+        double relativeSeconds = 0.0;      ///< Seconds from recordingStartPosition.
+        int pass = 0;                      ///< Loop pass (0 when not loop recording).
+    };
+
+    Placement placeSample(juce::int64 samplePosition) const;
 
     /**
-     * @brief Handles loop wraparound by clearing the recording buffer.
+     * @brief Handles loop wraparound according to the loop recording mode.
      *
      * Called when the transport loops back to the start while recording.
-     * Clears the recorded sequence and active notes to start a fresh loop pass.
+     * Replace clears the current take; overdub keeps appending to it; takes
+     * moves on to the next take buffer. In the latter two, held notes are
+     * closed at the loop end.
      */
     void handleLoopWraparound();
 
+    /** Moves to the next take buffer, reusing a preallocated one if available. */
+    void startNewTake();
+
     //==============================================================================
     // Member Variables
 
@@ -173,15 +311,28 @@ private:
     int targetTrackIndex = -1;                               ///< Index of track being recorded to.
     std::vector<std::pair<te::Clip*, bool>> clipsToRestore;  ///< Clips and their original mute states to restore after recording.
 
-    juce::MidiMessageSequence recordedSequence;              ///< Buffer of recorded MIDI messages.
+    std::vector<std::vector<juce::MidiMessage>> takes;       ///< Recorded messages per take (message thread only; capacity kept between recordings).
+    int currentTake = 0;                                     ///< Take receiving new events.
+    LoopRecordMode loopRecordMode = LoopRecordMode::replace; ///< What happens to a pass when the loop wraps.
     double recordingStartTime = 0.0;                         ///< Time when recording started (in seconds).
     tracktion::TimePosition recordingStartPosition;          ///< Transport position when recording started.
-    tracktion::TimePosition lastRecordedPosition;            ///< Last transport position when MIDI was recorded (for loop detection).
     tracktion::TimePosition firstNotePosition;               ///< Transport position when first MIDI note was captured (for preview clip start).
     bool hasRecordedNotes = false;                           ///< Whether any MIDI notes have been captured yet.
 
     std::vector<juce::MidiKeyboardState*> attachedSources;   ///< Keyboard states we're listening to.
-    std::set<int> activeNotes;                               ///< Currently held notes (note numbers without matching note-offs).
+    std::set<std::pair<int, int>> activeNotes;               ///< (channel, note) of currently held notes (message thread only).
+
+    AudioClock audioClock;                                   ///< Sample clock driven by the audio device.
+    std::vector<std::unique_ptr<SourceCapture>> captures;    ///< One FIFO per attached source (fixed while recording).
+    std::vector<CapturedEvent> drainScratch;                 ///< Reused by drainCapturedEvents().
+    static constexpr size_t takeCapacity = 8192;             ///< Events reserved per take buffer.
+    std::atomic<int> droppedEvents{0};                       ///< Events lost to a full FIFO.
+    juce::SharedResourcePointer<RtLog> rtLog;                ///< Real-time-safe log for the note handlers.
 
-    juce::CriticalSection recordingLock;                     ///< Thread safety for recording buffer.
+    bool anchored = false;                                   ///< Whether anchorSample/anchorPosition are valid.
+    juce::int64 anchorSample = 0;                            ///< Audio clock position matching anchorPosition.
+    tracktion::TimePosition anchorPosition;                  ///< Transport position at anchorSample.
+    bool loopRecording = false;                              ///< Transport was looping when recording started.
+    tracktion::TimeRange loopRange;                          ///< Loop range captured at start.
+    int currentPass = 0;                                     ///< Loop pass currently being recorded.
 };
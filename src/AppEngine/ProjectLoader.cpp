@@ -0,0 +1,100 @@
+#include "ProjectLoader.h"
+#include "ProjectSaver.h"
+#include <juce_events/juce_events.h>
+
+//==============================================================================
+// Construction / Destruction
+
+ProjectLoader::ProjectLoader() = default;
+
+ProjectLoader::~ProjectLoader()
+{
+    cancel();
+    pool.removeAllJobs (true, 10000);
+}
+
+//==============================================================================
+// Loading
+
+void ProjectLoader::loadAsync (const juce::File& file, ProgressCallback onProgress, LoadedCallback onLoaded)
+{
+    cancel();
+
+    const int thisLoad = ++(*generation);
+    loading = true;
+
+    // Callbacks are dropped once another load starts or the loader is cancelled / destroyed
+    auto isCurrent = [gen = generation, thisLoad] { return gen->load() == thisLoad; };
+
+    pool.addJob ([this, file, isCurrent, onProgress = std::move (onProgress), onLoaded = std::move (onLoaded)]
+    {
+        auto lastPost = 0.0;
+
+        auto progress = [&] (double p, const juce::String& stage)
+        {
+            // Throttle to roughly display rate; the UI only needs to see movement
+            const auto now = juce::Time::getMillisecondCounterHiRes();
+            if (! onProgress || (now - lastPost < 30.0 && p < 1.0))
+                return;
+
+            lastPost = now;
+            juce::MessageManager::callAsync ([isCurrent, onProgress, p, stage]
+            {
+                if (isCurrent())
+                    onProgress (p, stage);
+            });
+        };
+
+        auto result = load (file, progress, [&isCurrent] { return ! isCurrent(); });
+
+        if (! isCurrent())
+            return;
+
+        loading = false;
+
+        juce::MessageManager::callAsync ([isCurrent, onLoaded, result]
+        {
+            if (isCurrent() && onLoaded)
+                onLoaded (result);
+        });
+    });
+}
+
+void ProjectLoader::cancel()
+{
+    ++(*generation);
+    loading = false;
+}
+
+std::shared_ptr<ProjectLoader::Result> ProjectLoader::load (const juce::File& file,
+                                                            const ProgressCallback& onProgress,
+                                                            const std::function<bool()>& shouldStop)
+{
+    auto result = std::make_shared<Result>();
+    result->file = file;
+
+    auto report = [&] (double p, const juce::String& stage) { if (onProgress) onProgress (p, stage); };
+
+    report (0.0, "Reading " + file.getFileName());
+
+    if (! file.existsAsFile())
+    {
+        result->error = "File not found: " + file.getFullPathName();
+        return result;
+    }
+
+    auto state = ProjectSaver::readProject (file);
+
+    if (! state.isValid())
+    {
+        result->error = "Could not read " + file.getFileName();
+        return result;
+    }
+
+    if (shouldStop && shouldStop())
+        return result;
+
+    result->state = state;
+    report (1.0, "Opening project");
+    return result;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+/**
+ * @brief Reads and parses a project file in the background, with progress.
+ *
+ * ProjectLoader does the part of opening a project that doesn't need the
+ * message thread: reading and parsing the file (XML or binary, see
+ * ProjectSaver::readProject), on a worker thread.
+ *
+ * The parsed state is handed back on the message thread, where AppEngine
+ * creates the Edit and swaps it in, in stages. The current Edit is left
+ * untouched until then, so a failed or cancelled load changes nothing.
+ *
+ * Usage:
+ *  - loadAsync(file, onProgress, onLoaded); callbacks arrive on the message thread
+ *  - cancel() to abandon a load (onLoaded is then not called)
+ */
+class ProjectLoader
+{
+public:
+    //==============================================================================
+    // Types
+
+    /** Everything read off the message thread. */
+    struct Result
+    {
+        juce::File file;
+        juce::ValueTree state;   ///< Parsed project (invalid on failure).
+        juce::String error;      ///< Set when state is invalid.
+    };
+
+    using ProgressCallback = std::function<void (double progress, const juce::String& stage)>;
+    using LoadedCallback   = std::function<void (std::shared_ptr<Result>)>;
+
+    //==============================================================================
+    // Construction / Destruction
+
+    ProjectLoader();
+
+    /** Cancels any load in progress and waits for the worker. */
+    ~ProjectLoader();
+
+    //==============================================================================
+    // Loading
+
+    /**
+     * @brief Starts loading @p file; cancels a load already in progress.
+     *
+     * @param onProgress Called with 0..1 and a stage name (message thread, optional).
+     * @param onLoaded   Called with the result (message thread).
+     */
+    void loadAsync (const juce::File& file, ProgressCallback onProgress, LoadedCallback onLoaded);
+
+    /** Abandons the current load; its callbacks will not be called. */
+    void cancel();
+
+    /** Returns whether a load is running. */
+    bool isLoading() const noexcept { return loading.load(); }
+
+    /**
+     * @brief Runs the worker stage synchronously on the calling thread.
+     *
+     * @param onProgress Called from the calling thread (optional).
+     * @param shouldStop Polled once the file has been read (optional).
+     */
+    static std::shared_ptr<Result> load (const juce::File& file,
+                                         const ProgressCallback& onProgress = {},
+                                         const std::function<bool()>& shouldStop = {});
+
+private:
+    //==============================================================================
+    juce::ThreadPool pool { 1 };                            ///< Runs the load job.
+    std::atomic<bool> loading { false };
+    std::shared_ptr<std::atomic<int>> generation = std::make_shared<std::atomic<int>> (0); ///< Bumped by cancel().
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProjectLoader)
+};
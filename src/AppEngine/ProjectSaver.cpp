@@ -0,0 +1,178 @@
+#include "ProjectSaver.h"
+#include <juce_events/juce_events.h>
+#include <limits>
+
+namespace
+{
+    constexpr int binaryMagic      = 0x42504b47; // "GKPB"
+    constexpr int binaryHeaderSize = 4 + 2 + 2 + 8;
+    constexpr int flagGzip         = 1;
+
+    // Speed matters more than the last few percent of size: projects are saved often
+    constexpr int compressionLevel = 3;
+}
+
+ProjectSaver::ProjectSaver() = default;
+
+ProjectSaver::~ProjectSaver()
+{
+    // Let queued saves reach the disk; ThreadPool's destructor would drop unstarted jobs.
+    waitForPendingSaves (10000);
+    alive->store (false);
+}
+
+void ProjectSaver::saveAsync (juce::ValueTree snapshot, const juce::File& target, Callback onDone)
+{
+    ++pending;
+
+    pool.addJob ([this, snapshot = std::move (snapshot), target, onDone = std::move (onDone), guard = alive]() mutable
+    {
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        const bool ok = writeSnapshot (snapshot, target);
+
+        DBG ("[ProjectSaver] " << (ok ? "Saved " : "FAILED to save ") << target.getFullPathName()
+             << " in " << juce::String (juce::Time::getMillisecondCounterHiRes() - startMs, 1) << " ms");
+
+        // Release the snapshot here rather than on whichever thread drops the job
+        snapshot = {};
+
+        if (onDone)
+        {
+            juce::MessageManager::callAsync ([guard, onDone = std::move (onDone), ok]
+            {
+                if (guard->load())
+                    onDone (ok);
+            });
+        }
+
+        --pending;
+    });
+}
+
+//==============================================================================
+// Formats
+
+ProjectSaver::Format ProjectSaver::getFormatForFile (const juce::File& file)
+{
+    return file.hasFileExtension (binaryExtension) ? Format::binary : Format::xml;
+}
+
+bool ProjectSaver::isBinaryProject (const juce::File& file)
+{
+    juce::FileInputStream in (file);
+    return in.openedOk() && in.readInt() == binaryMagic;
+}
+
+juce::MemoryBlock ProjectSaver::createBinaryProject (const juce::ValueTree& tree)
+{
+    juce::MemoryOutputStream raw;
+    tree.writeToStream (raw);
+
+    juce::MemoryOutputStream out (raw.getDataSize() / 4 + binaryHeaderSize);
+    out.writeInt (binaryMagic);
+    out.writeShort ((short) binaryFormatVersion);
+    out.writeShort ((short) flagGzip);
+    out.writeInt64 ((juce::int64) raw.getDataSize());
+
+    {
+        juce::GZIPCompressorOutputStream zip (out, compressionLevel);
+        zip.write (raw.getData(), raw.getDataSize());
+    }
+
+    return out.getMemoryBlock();
+}
+
+juce::ValueTree ProjectSaver::parseBinaryProject (const void* data, size_t size)
+{
+    juce::MemoryInputStream in (data, size, false);
+
+    if (size < (size_t) binaryHeaderSize || in.readInt() != binaryMagic)
+        return {};
+
+    const int version = in.readShort();
+    const int flags   = in.readShort();
+    const auto rawSize = in.readInt64();
+
+    if (version < 1 || version > binaryFormatVersion)
+    {
+        DBG ("[ProjectSaver] Unsupported binary project version " << version);
+        return {};
+    }
+
+    if (rawSize <= 0 || rawSize > (juce::int64) std::numeric_limits<int>::max())
+        return {};
+
+    juce::MemoryBlock raw ((size_t) rawSize);
+
+    if ((flags & flagGzip) != 0)
+    {
+        juce::GZIPDecompressorInputStream unzip (&in, false);
+
+        if (unzip.read (raw.getData(), (int) rawSize) != (int) rawSize)
+            return {};
+    }
+    else if (in.read (raw.getData(), (int) rawSize) != (int) rawSize)
+    {
+        return {};
+    }
+
+    return juce::ValueTree::readFromData (raw.getData(), raw.getSize());
+}
+
+juce::ValueTree ProjectSaver::readProject (const juce::File& file)
+{
+    juce::MemoryBlock data;
+    if (! file.loadFileAsData (data))
+        return {};
+
+    if (data.getSize() >= 4 && juce::ByteOrder::littleEndianInt (data.getData()) == (juce::uint32) binaryMagic)
+        return parseBinaryProject (data.getData(), data.getSize());
+
+    if (auto xml = juce::parseXML (data.toString()))
+        return juce::ValueTree::fromXml (*xml);
+
+    return {};
+}
+
+//==============================================================================
+// Saving
+
+bool ProjectSaver::writeSnapshot (const juce::ValueTree& snapshot, const juce::File& target)
+{
+    if (! snapshot.isValid())
+        return false;
+
+    if (getFormatForFile (target) == Format::binary)
+    {
+        const auto data = createBinaryProject (snapshot);
+        juce::TemporaryFile tf (target);
+
+        return tf.getFile().replaceWithData (data.getData(), data.getSize())
+            && tf.overwriteTargetFileWithTemporary();
+    }
+
+    if (auto xml = snapshot.createXml())
+    {
+        juce::TemporaryFile tf (target);
+
+        return tf.getFile().replaceWithText (xml->toString())
+            && tf.overwriteTargetFileWithTemporary();
+    }
+
+    return false;
+}
+
+bool ProjectSaver::waitForPendingSaves (int timeoutMs) const
+{
+    const auto start = juce::Time::getMillisecondCounter();
+
+    while (pending.load() > 0)
+    {
+        if (timeoutMs >= 0 && (int) (juce::Time::getMillisecondCounter() - start) >= timeoutMs)
+            return false;
+
+        juce::Thread::sleep (2);
+    }
+
+    return true;
+}
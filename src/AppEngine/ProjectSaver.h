@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+/**
+ * @brief Writes project snapshots to disk on a background thread.
+ *
+ * ProjectSaver takes a detached copy of an Edit's ValueTree (made on the message
+ * thread) and does the expensive part of saving - XML serialisation and the
+ * TemporaryFile write/swap - on its own worker thread, so saving never stalls
+ * the UI.
+ *
+ * Architecture:
+ *  - One worker thread: saves run one at a time in the order they were queued,
+ *    so an autosave can never overtake a manual save of the same file
+ *  - The snapshot passed in is owned by the job; nothing else may touch it
+ *  - Completion callbacks are posted back to the message thread
+ *  - Files are replaced atomically via juce::TemporaryFile, so a crash mid-save
+ *    leaves the previous file intact
+ *
+ * Formats (chosen by the target's extension):
+ *  - .tracktionedit / .xml: plain XML, as written by Tracktion itself
+ *  - .gkproj: binary container - versioned header followed by the gzip-compressed
+ *    ValueTree binary serialisation. Much smaller and much faster to load than XML
+ *    for sessions with many notes, since no text has to be parsed
+ *
+ * Usage:
+ *  - Flush plugin state into the Edit, then call saveAsync(edit.state.createCopy(), file, callback)
+ *  - Call waitForPendingSaves() before shutting down (the destructor also waits)
+ *  - readProject() loads either format
+ */
+class ProjectSaver
+{
+public:
+    //==============================================================================
+    // Construction / Destruction
+
+    ProjectSaver();
+
+    /** Waits for queued saves to finish; callbacks that have not run yet are dropped. */
+    ~ProjectSaver();
+
+    //==============================================================================
+    // Formats
+
+    enum class Format
+    {
+        xml,
+        binary
+    };
+
+    static constexpr const char* binaryExtension = ".gkproj";
+    static constexpr int binaryFormatVersion = 1;
+
+    /** Format a file will be written in, based on its extension. */
+    static Format getFormatForFile (const juce::File& file);
+
+    /** Returns true if @p file starts with the binary container header. */
+    static bool isBinaryProject (const juce::File& file);
+
+    /**
+     * @brief Reads a project written in either format.
+     *
+     * @return The project state, or an invalid tree if the file is unreadable,
+     *         corrupt, or was written by a newer binary format version.
+     */
+    static juce::ValueTree readProject (const juce::File& file);
+
+    /** Serialises @p tree into the binary container format. */
+    static juce::MemoryBlock createBinaryProject (const juce::ValueTree& tree);
+
+    /** Parses the binary container format (invalid tree on failure). */
+    static juce::ValueTree parseBinaryProject (const void* data, size_t size);
+
+    //==============================================================================
+    // Saving
+
+    using Callback = std::function<void (bool success)>;
+
+    /**
+     * @brief Queues a snapshot to be written to @p target on the worker thread.
+     *
+     * @param snapshot Detached copy of the project state (e.g. ValueTree::createCopy()).
+     * @param target   File to create or atomically replace.
+     * @param onDone   Called on the message thread with the result (optional).
+     */
+    void saveAsync (juce::ValueTree snapshot, const juce::File& target, Callback onDone = {});
+
+    /**
+     * @brief Serialises @p snapshot and atomically replaces @p target (blocking).
+     *
+     * The format follows @p target's extension (see getFormatForFile()).
+     *
+     * Used by the worker thread; also safe to call directly from any thread.
+     *
+     * @return True if the file was written and swapped into place.
+     */
+    static bool writeSnapshot (const juce::ValueTree& snapshot, const juce::File& target);
+
+    /** Number of saves queued or in progress. */
+    int getNumPendingSaves() const noexcept { return pending.load(); }
+
+    /** Returns whether any save is queued or in progress. */
+    bool isSaving() const noexcept { return getNumPendingSaves() > 0; }
+
+    /**
+     * @brief Blocks until every queued save has finished.
+     *
+     * @param timeoutMs Maximum time to wait, or -1 to wait indefinitely.
+     * @return True if no saves are pending.
+     */
+    bool waitForPendingSaves (int timeoutMs = -1) const;
+
+private:
+    //==============================================================================
+    juce::ThreadPool pool { 1 };                                              ///< Single save worker.
+    std::atomic<int> pending { 0 };                                           ///< Queued + running saves.
+    std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>> (true); ///< Guards posted callbacks.
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProjectSaver)
+};
@@ -0,0 +1,210 @@
+#include "StartupTrace.h"
+#include <juce_events/juce_events.h>
+
+//==============================================================================
+// ScopedPhase
+
+StartupTrace::ScopedPhase::ScopedPhase (const char* phaseName)
+    : name (phaseName),
+      start (getInstance().isRecording() ? getInstance().now() : -1)
+{
+}
+
+StartupTrace::ScopedPhase::~ScopedPhase()
+{
+    auto& trace = getInstance();
+
+    if (start >= 0 && trace.isRecording())
+        trace.addPhase (name, start, trace.now());
+}
+
+//==============================================================================
+// Construction
+
+StartupTrace& StartupTrace::getInstance()
+{
+    static StartupTrace instance;
+    return instance;
+}
+
+StartupTrace::StartupTrace()
+    : originTicks (juce::Time::getHighResolutionTicks())
+{
+    threads.add (juce::Thread::getCurrentThreadId());
+}
+
+juce::int64 StartupTrace::now() const noexcept
+{
+    const auto elapsed = juce::Time::getHighResolutionTicks() - originTicks;
+    return (juce::int64) (juce::Time::highResolutionTicksToSeconds (elapsed) * 1.0e6);
+}
+
+int StartupTrace::getThreadIndex()
+{
+    // Called with the lock held
+    const auto id = juce::Thread::getCurrentThreadId();
+    const auto index = threads.indexOf (id);
+
+    if (index >= 0)
+        return index;
+
+    threads.add (id);
+    return threads.size() - 1;
+}
+
+//==============================================================================
+// Recording
+
+void StartupTrace::addPhase (const juce::String& name, juce::int64 startMicros, juce::int64 endMicros)
+{
+    if (! isRecording())
+        return;
+
+    const juce::ScopedLock sl (lock);
+    events.push_back ({ name, startMicros, juce::jmax ((juce::int64) 0, endMicros - startMicros), getThreadIndex(), false, false });
+}
+
+void StartupTrace::addAsyncPhase (const juce::String& name, juce::int64 startMicros, juce::int64 endMicros)
+{
+    if (! isRecording())
+        return;
+
+    const juce::ScopedLock sl (lock);
+    events.push_back ({ name, startMicros, juce::jmax ((juce::int64) 0, endMicros - startMicros), getThreadIndex(), false, true });
+}
+
+void StartupTrace::addMarker (const juce::String& name)
+{
+    if (! isRecording())
+        return;
+
+    const auto t = now();
+
+    const juce::ScopedLock sl (lock);
+    events.push_back ({ name, t, 0, getThreadIndex(), true, false });
+}
+
+void StartupTrace::markFirstFrame()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (firstFrameMarked)
+        return;
+
+    firstFrameMarked = true;
+    addMarker ("first frame");
+
+    // Anything queued by startup runs before this, so it marks the first idle point
+    juce::MessageManager::callAsync ([this]
+    {
+        addMarker ("idle");
+        idleMicros = now();
+        recording = false;
+
+        if (onStartupFinished)
+            onStartupFinished();
+    });
+}
+
+double StartupTrace::getStartupMillis() const noexcept
+{
+    const auto t = idleMicros.load();
+    return t < 0 ? -1.0 : (double) t / 1000.0;
+}
+
+//==============================================================================
+// Output
+
+std::vector<StartupTrace::Event> StartupTrace::getEvents() const
+{
+    const juce::ScopedLock sl (lock);
+    return events;
+}
+
+juce::String StartupTrace::toChromeTraceJson() const
+{
+    juce::Array<juce::var> traceEvents;
+
+    auto makeEvent = [] (const juce::String& name, const char* phase, int tid)
+    {
+        auto* e = new juce::DynamicObject();
+        e->setProperty ("name", name);
+        e->setProperty ("ph", phase);
+        e->setProperty ("pid", 1);
+        e->setProperty ("tid", tid);
+        return e;
+    };
+
+    int numThreads = 0;
+    int asyncId = 0;
+
+    for (const auto& ev : getEvents())
+    {
+        numThreads = juce::jmax (numThreads, ev.threadIndex + 1);
+
+        if (ev.isAsync)
+        {
+            // Begin/end pair sharing an id
+            ++asyncId;
+
+            for (const auto* phase : { "b", "e" })
+            {
+                auto* e = makeEvent (ev.name, phase, ev.threadIndex);
+                e->setProperty ("cat", "startup");
+                e->setProperty ("id", asyncId);
+                e->setProperty ("ts", phase[0] == 'b' ? ev.startMicros : ev.startMicros + ev.durationMicros);
+                traceEvents.add (juce::var (e));
+            }
+
+            continue;
+        }
+
+        auto* e = makeEvent (ev.name, ev.isMarker ? "i" : "X", ev.threadIndex);
+        e->setProperty ("cat", "startup");
+        e->setProperty ("ts", ev.startMicros);
+
+        if (ev.isMarker)
+            e->setProperty ("s", "g");   // global marker: a line across every thread
+        else
+            e->setProperty ("dur", ev.durationMicros);
+
+        traceEvents.add (juce::var (e));
+    }
+
+    // Metadata so the viewer shows readable process/thread names
+    auto* process = makeEvent ("process_name", "M", 0);
+    auto* processArgs = new juce::DynamicObject();
+    processArgs->setProperty ("name", "GrooveKit");
+    process->setProperty ("args", juce::var (processArgs));
+    traceEvents.add (juce::var (process));
+
+    for (int i = 0; i < numThreads; ++i)
+    {
+        auto* thread = makeEvent ("thread_name", "M", i);
+        auto* threadArgs = new juce::DynamicObject();
+        threadArgs->setProperty ("name", i == 0 ? juce::String ("Main thread") : "Worker " + juce::String (i));
+        thread->setProperty ("args", juce::var (threadArgs));
+        traceEvents.add (juce::var (thread));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("traceEvents", traceEvents);
+    root->setProperty ("displayTimeUnit", "ms");
+
+    return juce::JSON::toString (juce::var (root));
+}
+
+bool StartupTrace::writeTo (const juce::File& file) const
+{
+    file.getParentDirectory().createDirectory();
+    return file.replaceWithText (toChromeTraceJson());
+}
+
+void StartupTrace::reset()
+{
+    const juce::ScopedLock sl (lock);
+    events.clear();
+    idleMicros = -1;
+    firstFrameMarked = false;
+    recording = true;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Records how long each startup phase takes, as Chrome trace events.
+ *
+ * Architecture:
+ *  - Phases are timed with GK_TRACE_SCOPE ("name") (or ScopedPhase) on any
+ *    thread; nested scopes show up nested in the trace viewer.
+ *  - Work that starts and finishes in different places (e.g. the background
+ *    plugin scan) is added with addAsyncPhase() from two now() timestamps; it
+ *    gets its own row in the viewer.
+ *  - MainComponent calls markFirstFrame() from its first paint. Once the
+ *    message loop has gone idle after that, recording stops and
+ *    onStartupFinished is called.
+ *  - toChromeTraceJson()/writeTo() produce Chrome trace-event JSON, which
+ *    opens in chrome://tracing or ui.perfetto.dev.
+ *
+ * Recording is a timestamp pair and a short locked append per phase and stops
+ * after startup, so the scopes can stay in release builds.
+ */
+class StartupTrace
+{
+public:
+    //==============================================================================
+    /** One completed phase ("X" event in the trace), or a marker ("i" event). */
+    struct Event
+    {
+        juce::String name;
+        juce::int64 startMicros = 0;      ///< Since the trace origin.
+        juce::int64 durationMicros = 0;
+        int threadIndex = 0;              ///< 0 is the thread that created the trace.
+        bool isMarker = false;
+        bool isAsync = false;             ///< Not tied to one thread's call stack.
+    };
+
+    /** Times the enclosing scope. */
+    class ScopedPhase
+    {
+    public:
+        explicit ScopedPhase (const char* phaseName);
+        ~ScopedPhase();
+
+    private:
+        const char* name;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedPhase)
+    };
+
+    //==============================================================================
+    static StartupTrace& getInstance();
+
+    /** Microseconds since the trace origin (the first call to getInstance()). */
+    juce::int64 now() const noexcept;
+
+    bool isRecording() const noexcept { return recording.load (std::memory_order_relaxed); }
+
+    /** Records a phase that ran on the calling thread. */
+    void addPhase (const juce::String& name, juce::int64 startMicros, juce::int64 endMicros);
+
+    /** Records a phase that may overlap others on the same thread (an async span). */
+    void addAsyncPhase (const juce::String& name, juce::int64 startMicros, juce::int64 endMicros);
+
+    /** Records a zero-length marker (e.g. "first frame"). */
+    void addMarker (const juce::String& name);
+
+    //==============================================================================
+    /** Call from the first paint; finishes the trace once the message loop is idle. Message thread. */
+    void markFirstFrame();
+
+    /** Called on the message thread when startup is over and recording has stopped. */
+    std::function<void()> onStartupFinished;
+
+    /** Time from the trace origin to the idle first frame, or -1 if not reached yet. */
+    double getStartupMillis() const noexcept;
+
+    //==============================================================================
+    std::vector<Event> getEvents() const;
+    juce::String toChromeTraceJson() const;
+    bool writeTo (const juce::File& file) const;
+
+    /** Clears the events and restarts recording (tests). */
+    void reset();
+
+private:
+    StartupTrace();
+
+    int getThreadIndex();
+
+    const juce::int64 originTicks;
+    std::atomic<bool> recording { true };
+    std::atomic<juce::int64> idleMicros { -1 };
+    bool firstFrameMarked = false;
+
+    mutable juce::CriticalSection lock;
+    std::vector<Event> events;
+    juce::Array<juce::Thread::ThreadID> threads;   ///< Index = Event::threadIndex.
+
+    JUCE_DECLARE_NON_COPYABLE (StartupTrace)
+};
+
+/** Times the rest of the enclosing scope as a startup phase. */
+#define GK_TRACE_SCOPE(phaseName) \
+    StartupTrace::ScopedPhase JUCE_JOIN_MACRO (gkTracePhase_, __LINE__) (phaseName)
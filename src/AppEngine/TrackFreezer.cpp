@@ -0,0 +1,277 @@
+#include "TrackFreezer.h"
+#include "MeterTapPlugin.h"
+#include <algorithm>
+
+namespace t = tracktion;
+
+namespace GKIDs {
+    static const juce::Identifier freezeClip ("gk_freezeClip");
+    static const juce::Identifier bypassedByFreeze ("gk_bypassedByFreeze");
+}
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    /** The fader and meters stay live on a frozen track; everything else is in the freeze file. */
+    bool staysLiveWhenFrozen (te::Plugin& plugin)
+    {
+        return dynamic_cast<te::VolumeAndPanPlugin*> (&plugin) != nullptr
+            || dynamic_cast<te::LevelMeterPlugin*> (&plugin) != nullptr
+            || dynamic_cast<MeterTapPlugin*> (&plugin) != nullptr;
+    }
+}
+
+//==============================================================================
+// Construction
+
+TrackFreezer::TrackFreezer (te::Engine& e)
+    : engine (e)
+{
+}
+
+TrackFreezer::~TrackFreezer()
+{
+    onChange = nullptr;
+    onFreezeFailed = nullptr;
+    cancelAll();
+}
+
+//==============================================================================
+// Helpers
+
+bool TrackFreezer::isFreezeClip (const te::Clip& clip)
+{
+    return clip.state.getProperty (GKIDs::freezeClip, false);
+}
+
+juce::File TrackFreezer::getFreezeDirectory (const juce::File& editFile)
+{
+    if (editFile == juce::File())
+        return juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("GrooveKit Freeze");
+
+    return editFile.getSiblingFile (editFile.getFileNameWithoutExtension() + " Freeze");
+}
+
+t::TimeDuration TrackFreezer::findAudibleLength (const juce::File& file, t::TimeDuration searchLength)
+{
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader (wav.createReaderFor (file.createInputStream().release(), true));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return {};
+
+    const auto total = reader->lengthInSamples;
+    const auto searchStart = juce::jmax ((juce::int64) 0, total - (juce::int64) (searchLength.inSeconds() * reader->sampleRate));
+
+    juce::AudioBuffer<float> tail ((int) reader->numChannels, (int) (total - searchStart));
+    reader->read (&tail, 0, tail.getNumSamples(), searchStart, true, true);
+
+    const auto threshold = juce::Decibels::decibelsToGain (-90.0f);
+    auto end = searchStart;
+
+    for (int i = tail.getNumSamples(); --i >= 0 && end == searchStart;)
+        for (int ch = 0; ch < tail.getNumChannels(); ++ch)
+            if (std::abs (tail.getSample (ch, i)) > threshold)
+                end = searchStart + i + 1;
+
+    return t::TimeDuration::fromSeconds ((double) end / reader->sampleRate);
+}
+
+TrackFreezer::Job* TrackFreezer::findRunningJob (const te::AudioTrack& track) const
+{
+    for (auto& job : jobs)
+        if (! job->finished && job->edit == &track.edit && job->trackId == track.itemID)
+            return job.get();
+
+    return nullptr;
+}
+
+void TrackFreezer::removeFinishedJobs()
+{
+    jobs.erase (std::remove_if (jobs.begin(), jobs.end(), [] (const auto& job) { return job->finished; }),
+                jobs.end());
+}
+
+void TrackFreezer::notifyChanged()
+{
+    if (onChange)
+        onChange();
+}
+
+//==============================================================================
+// State
+
+TrackFreezer::State TrackFreezer::getState (const te::AudioTrack& track) const
+{
+    if (findRunningJob (track) != nullptr)
+        return State::freezing;
+
+    for (auto* clip : track.getClips())
+        if (clip != nullptr && isFreezeClip (*clip))
+            return State::frozen;
+
+    return State::live;
+}
+
+double TrackFreezer::getProgress (const te::AudioTrack& track) const
+{
+    if (auto* job = findRunningJob (track))
+        return job->progress;
+
+    return 0.0;
+}
+
+//==============================================================================
+// Freeze / unfreeze
+
+bool TrackFreezer::freeze (te::AudioTrack& track, const juce::ValueTree& editState,
+                           const juce::File& editFile, double sampleRate)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    removeFinishedJobs();
+
+    if (getState (track) != State::live)
+        return false;
+
+    // A fresh name each time: the previous freeze file may still be cached by the audio file manager,
+    // and is kept so that undoing an unfreeze still finds it
+    const auto file = getFreezeDirectory (editFile)
+                          .getNonexistentChildFile (juce::File::createLegalFileName (track.getName() + " Freeze"), ".wav", false);
+
+    auto job = std::make_unique<Job>();
+    job->edit = &track.edit;
+    job->trackId = track.itemID;
+    job->exporter = std::make_unique<AudioExporter> (engine, 1);
+
+    auto* rawJob = job.get();
+    const auto trackName = track.getName();
+
+    const bool started = rawJob->exporter->startTrackRender (editState, editFile, track.itemID, file, sampleRate,
+                                                             t::TimeDuration::fromSeconds (renderTailSeconds),
+        [this, rawJob] (double progress, const juce::String&)
+        {
+            rawJob->progress = progress;
+            notifyChanged();
+        },
+        [this, rawJob, trackName] (const AudioExporter::Result& result)
+        {
+            rawJob->finished = true;
+
+            if (result.ok)
+            {
+                // The track may have been deleted while it rendered
+                if (auto* target = dynamic_cast<te::AudioTrack*> (te::findTrackForID (*rawJob->edit, rawJob->trackId)))
+                    applyFreeze (*target, result.files.getFirst());
+            }
+            else if (! result.cancelled && onFreezeFailed)
+            {
+                onFreezeFailed (trackName, result.error);
+            }
+
+            notifyChanged();
+        });
+
+    if (! started)
+        return false;
+
+    jobs.push_back (std::move (job));
+    notifyChanged();
+    return true;
+}
+
+void TrackFreezer::applyFreeze (te::AudioTrack& track, const juce::File& file)
+{
+    auto& um = track.edit.getUndoManager();
+    um.beginNewTransaction ("Freeze " + track.getName());
+
+    const auto length = findAudibleLength (file, t::TimeDuration::fromSeconds (renderTailSeconds));
+    if (length <= t::TimeDuration())
+        return;
+    const te::ClipPosition position { { t::TimePosition(), length }, t::TimeDuration() };
+
+    auto clip = track.insertWaveClip (file.getFileNameWithoutExtension(), file, position, false);
+    if (clip == nullptr)
+        return;
+
+    clip->state.setProperty (GKIDs::freezeClip, true, &um);
+
+    for (auto* plugin : track.pluginList)
+    {
+        if (staysLiveWhenFrozen (*plugin) || ! plugin->isEnabled())
+            continue;
+
+        plugin->setEnabled (false);
+        plugin->state.setProperty (GKIDs::bypassedByFreeze, true, &um);
+    }
+
+    um.beginNewTransaction();
+}
+
+void TrackFreezer::unfreeze (te::AudioTrack& track)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (auto* job = findRunningJob (track))
+    {
+        job->exporter->cancel();   // completion marks the job finished and notifies
+        return;
+    }
+
+    if (getState (track) != State::frozen)
+        return;
+
+    auto& um = track.edit.getUndoManager();
+    um.beginNewTransaction ("Unfreeze " + track.getName());
+
+    juce::Array<te::Clip*> freezeClips;
+
+    for (auto* clip : track.getClips())
+        if (clip != nullptr && isFreezeClip (*clip))
+            freezeClips.add (clip);
+
+    for (auto* clip : freezeClips)
+        clip->removeFromParent();
+
+    for (auto* plugin : track.pluginList)
+    {
+        if (! plugin->state.getProperty (GKIDs::bypassedByFreeze, false))
+            continue;
+
+        plugin->setEnabled (true);
+        plugin->state.removeProperty (GKIDs::bypassedByFreeze, &um);
+    }
+
+    um.beginNewTransaction();
+    notifyChanged();
+}
+
+void TrackFreezer::cancelAll()
+{
+    for (auto& job : jobs)
+        if (! job->finished)
+            job->exporter->cancel();
+}
+
+bool TrackFreezer::waitForPendingFreezes (int timeoutMs)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const auto deadline = juce::Time::getMillisecondCounterHiRes() + timeoutMs;
+
+    for (auto& job : jobs)
+    {
+        if (job->finished)
+            continue;
+
+        const auto remainingMs = timeoutMs < 0 ? -1
+                                               : juce::jmax (0, (int) (deadline - juce::Time::getMillisecondCounterHiRes()));
+
+        if (! job->exporter->waitForCompletion (remainingMs))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "AudioExporter.h"
+#include <tracktion_engine/tracktion_engine.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Freezes tracks: renders a track's clips through its instrument and
+ *        inserts to a WAV in the background, then plays that file instead.
+ *
+ * Architecture:
+ *  - freeze() renders a snapshot of the track pre-fader with an AudioExporter
+ *    (one render thread per track, so the UI and playback keep going).
+ *  - The render runs renderTailSeconds past the edit's end, so tails aren't
+ *    cut off; the clip ends where the file's audio does.
+ *  - When the render finishes, the file is placed on the track as an audio
+ *    clip marked gk_freezeClip, and every instrument/insert on the track is
+ *    disabled (marked gk_bypassedByFreeze). Disabled plugins drop out of the
+ *    playback graph, which is where the CPU is saved. The MIDI clips stay
+ *    where they are; with nothing to play them they're silent.
+ *  - unfreeze() re-enables exactly the plugins freezing disabled and removes
+ *    the freeze clip, or cancels a freeze that is still rendering.
+ *
+ * Frozen state lives in the edit (the marker properties), so it's saved and
+ * restored with the project. Freeze and unfreeze are each one undo step.
+ * Volume, pan and the level meter stay live. Freeze files go next to the
+ * project ("<project> Freeze/") or in the temp folder for untitled edits, and
+ * are kept after unfreezing so undo can bring the freeze back.
+ */
+class TrackFreezer
+{
+public:
+    //==============================================================================
+    enum class State
+    {
+        live,       ///< Plugins run normally.
+        freezing,   ///< Render in progress; still playing live.
+        frozen      ///< Playing the freeze file.
+    };
+
+    explicit TrackFreezer (te::Engine& engine);
+    ~TrackFreezer();
+
+    //==============================================================================
+    /**
+     * @brief Starts freezing @p track in the background.
+     *
+     * @param editState   Snapshot of the edit with current plugin state (AppEngine::createSaveSnapshot).
+     * @param editFile    The project file, for media paths and the freeze folder; may be empty.
+     * @return false if the track is already frozen/freezing or has nothing to render.
+     */
+    bool freeze (te::AudioTrack& track, const juce::ValueTree& editState,
+                 const juce::File& editFile, double sampleRate);
+
+    /** Returns a frozen track to its live plugins, or cancels a freeze in progress. */
+    void unfreeze (te::AudioTrack& track);
+
+    /** Cancels every freeze in progress (e.g. before the edit is replaced). */
+    void cancelAll();
+
+    /**
+     * @brief Blocks until every freeze in progress has finished and been applied.
+     *
+     * For callers without a running message loop (tests).
+     * @return false if @p timeoutMs (-1 = no limit) passed first; the renders carry on.
+     */
+    bool waitForPendingFreezes (int timeoutMs);
+
+    State getState (const te::AudioTrack& track) const;
+
+    /** Render progress (0..1) while freezing, otherwise 0. */
+    double getProgress (const te::AudioTrack& track) const;
+
+    //==============================================================================
+    /** Called on the message thread whenever a track's state or freeze progress changes. */
+    std::function<void()> onChange;
+
+    /** Called on the message thread when a freeze render fails (not when cancelled). */
+    std::function<void (const juce::String& trackName, const juce::String& error)> onFreezeFailed;
+
+    //==============================================================================
+    static bool isFreezeClip (const te::Clip& clip);
+
+    /** Where freeze files for @p editFile live; a temp folder when the edit has no file yet. */
+    static juce::File getFreezeDirectory (const juce::File& editFile);
+
+    /** Rendered past the end of the edit, so release, reverb and delay tails make it into the freeze file. */
+    static constexpr double renderTailSeconds = 8.0;
+
+    /**
+     * @brief Length of a WAV file up to its last sample above -90 dB.
+     *
+     * Only the last @p searchLength is scanned; if it is all silent, the file
+     * ends where that stretch starts. Sizes the freeze clip, so the silent
+     * rest of the tail allowance doesn't lengthen the edit. Public so tests
+     * can check it on a file of their own.
+     */
+    static tracktion::TimeDuration findAudibleLength (const juce::File& file, tracktion::TimeDuration searchLength);
+
+private:
+    //==============================================================================
+    struct Job
+    {
+        te::Edit* edit = nullptr;
+        te::EditItemID trackId;
+        std::unique_ptr<AudioExporter> exporter;
+        double progress = 0.0;
+        bool finished = false;   ///< Kept until the next freeze(); an exporter can't delete itself from its callback.
+    };
+
+    Job* findRunningJob (const te::AudioTrack& track) const;
+    void removeFinishedJobs();
+    void applyFreeze (te::AudioTrack& track, const juce::File& file);
+    void notifyChanged();
+
+    te::Engine& engine;
+    std::vector<std::unique_ptr<Job>> jobs;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackFreezer)
+};
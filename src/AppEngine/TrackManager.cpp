@@ -6,6 +6,15 @@
 
 namespace {
     static int asIndexChecked (int idx, int size) { return (idx >= 0 && idx < size) ? idx : -1; }
+
+    MeterTapPlugin* findMeterTap (te::PluginList& list)
+    {
+        for (auto* p : list)
+            if (auto* tap = dynamic_cast<MeterTapPlugin*> (p))
+                return tap;
+
+        return nullptr;
+    }
 }
 
 namespace GKIDs {
@@ -49,6 +58,54 @@ void TrackManager::syncBookkeepingToEngine()
             drumEngines[(size_t) i].reset();
         }
     }
+
+    ensureMeterTaps();
+}
+
+void TrackManager::ensureMeterTaps()
+{
+    for (auto* track : te::getAudioTracks (edit))
+    {
+        if (findMeterTap (track->pluginList) != nullptr)
+            continue;
+
+        auto tap = edit.getPluginCache().createNewPlugin (MeterTapPlugin::pluginType, {});
+        if (tap == nullptr)
+            continue;
+
+        // Right after Tracktion's meter, so the FX insert slots stay where they were
+        te::Plugin* meter = nullptr;
+        for (auto* p : track->pluginList)
+            if (auto* m = dynamic_cast<te::LevelMeterPlugin*> (p))
+                meter = m;
+
+        if (meter != nullptr)
+        {
+            auto parent = meter->state.getParent();
+            parent.addChild (tap->state, parent.indexOf (meter->state) + 1, nullptr);
+        }
+        else
+        {
+            track->state.appendChild (tap->state, nullptr);
+        }
+    }
+
+    if (findMeterTap (edit.getMasterPluginList()) == nullptr)
+        if (auto tap = edit.getPluginCache().createNewPlugin (MeterTapPlugin::pluginType, {}))
+            edit.state.getOrCreateChildWithName (te::IDs::MASTERPLUGINS, nullptr).appendChild (tap->state, nullptr);
+}
+
+MeterTapPlugin* TrackManager::getMeterTap (int trackIndex)
+{
+    if (auto* track = getTrack (trackIndex))
+        return findMeterTap (track->pluginList);
+
+    return nullptr;
+}
+
+MeterTapPlugin* TrackManager::getMasterMeterTap()
+{
+    return findMeterTap (edit.getMasterPluginList());
 }
 
 int TrackManager::getNumTracks() const {
@@ -388,5 +445,12 @@ int TrackManager::getFxInsertBaseIndex (int trackIndex) const
 
     // Instrument at [0] ⇒ [1]=volume, [2]=meter, inserts start at [3]
     // No instrument     ⇒ [0]=volume, [1]=meter, inserts start at [2]
-    return isInstrument ? 3 : 2;
+    // The meter tap follows Tracktion's meter, pushing the inserts along by one
+    const int base = isInstrument ? 3 : 2;
+
+    for (int i = base; i <= base + 1 && i < t->pluginList.size(); ++i)
+        if (dynamic_cast<MeterTapPlugin*> (t->pluginList[i]) != nullptr)
+            return i + 1;
+
+    return base;
 }
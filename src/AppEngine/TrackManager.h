@@ -3,6 +3,7 @@
 #include "../DrumSamplerEngine/DrumSamplerEngineAdapter.h"
 #include "../MIDIEngine/MIDIEngine.h"
 #include "../PluginManager/PluginManager.h"
+#include "MeterTapPlugin.h"
 namespace te = tracktion::engine;
 
 class PluginManager;
@@ -19,6 +20,7 @@ class PluginManager;
  *  - Maintains parallel bookkeeping vectors (types[], drumEngines[]) indexed by track position
  *  - Synchronizes with Tracktion Edit's track list via syncBookkeepingToEngine()
  *  - Uses Tracktion's ValueTree properties for persistent track metadata (`gk_isDrum`)
+ *  - Keeps a MeterTapPlugin on every track and the master for the Mix view meters
  *  - Owned by AppEngine for centralized track management
  *
  * Track Type System:
@@ -231,6 +233,14 @@ public:
     void clearFxInsertSlot (int trackIndex, int slotIndex);
     int getFxInsertBaseIndex (int trackIndex) const;
 
+    //==============================================================================
+    // Metering
+
+    /** The track's level-meter tap (added after Tracktion's meter), or nullptr. */
+    MeterTapPlugin* getMeterTap (int trackIndex);
+
+    /** The tap at the end of the master plugin list, or nullptr. */
+    MeterTapPlugin* getMasterMeterTap();
 
 private:
     //==============================================================================
@@ -252,4 +262,12 @@ private:
      * Called after track addition/deletion to maintain consistency.
      */
     void syncBookkeepingToEngine();
+
+    /**
+     * @brief Adds a MeterTapPlugin to every track and the master that lacks one.
+     *
+     * The taps go straight into the edit's ValueTree without the undo manager,
+     * so they can't be undone and don't mark a freshly opened project modified.
+     */
+    void ensureMeterTaps();
 };
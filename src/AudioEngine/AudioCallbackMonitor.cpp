@@ -0,0 +1,331 @@
+#include "AudioCallbackMonitor.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    /**
+     * CPU time used so far by the calling thread. On Windows the figure only
+     * moves in scheduler ticks, so short callbacks land in the lowest bin.
+     */
+    double getThreadCpuSeconds() noexcept
+    {
+       #if JUCE_WINDOWS
+        FILETIME creation, exit, kernel, user;
+        if (! GetThreadTimes (GetCurrentThread(), &creation, &exit, &kernel, &user))
+            return -1.0;
+
+        const auto toTicks = [] (const FILETIME& ft) { return ((juce::uint64) ft.dwHighDateTime << 32) | ft.dwLowDateTime; };
+        return (double) (toTicks (kernel) + toTicks (user)) * 1.0e-7;
+       #else
+        timespec ts;
+        if (clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+            return -1.0;
+
+        return (double) ts.tv_sec + (double) ts.tv_nsec * 1.0e-9;
+       #endif
+    }
+
+    juce::String formatTransportTime (double seconds)
+    {
+        const auto totalMs = juce::roundToInt (juce::jmax (0.0, seconds) * 1000.0);
+        return juce::String (totalMs / 60000) + ":"
+             + juce::String ((totalMs / 1000) % 60).paddedLeft ('0', 2) + "."
+             + juce::String (totalMs % 1000).paddedLeft ('0', 3);
+    }
+}
+
+//==============================================================================
+// Construction
+
+AudioCallbackMonitor::AudioCallbackMonitor (std::function<double (juce::int64)> transportSecondsAt, juce::File file)
+    : getTransportSecondsAt (std::move (transportSecondsAt)),
+      logFile (std::move (file))
+{
+    startTimer (pollIntervalMs);
+}
+
+AudioCallbackMonitor::~AudioCallbackMonitor()
+{
+    stopTimer();
+}
+
+//==============================================================================
+// Audio thread
+
+void AudioCallbackMonitor::audioDeviceIOCallbackWithContext (const float* const*, int,
+                                                             float* const* outputChannelData, int numOutputChannels,
+                                                             int numSamples, const juce::AudioIODeviceCallbackContext&)
+{
+    // Extra callbacks are mixed into the output, so contribute silence
+    for (int ch = 0; ch < numOutputChannels; ++ch)
+        if (outputChannelData[ch] != nullptr)
+            juce::FloatVectorOperations::clear (outputChannelData[ch], numSamples);
+
+    const double endSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks());
+    const double threadCpuSeconds = getThreadCpuSeconds();
+
+    // The thread sleeps between callbacks, so the CPU time since the previous one is this block's
+    const double cpuSeconds = lastThreadCpuSeconds >= 0.0 && threadCpuSeconds >= 0.0
+                                  ? threadCpuSeconds - lastThreadCpuSeconds : -1.0;
+    lastThreadCpuSeconds = threadCpuSeconds;
+
+    if (sampleRate > 0.0)
+        timeCallback (endSeconds, cpuSeconds, numSamples / sampleRate);
+}
+
+void AudioCallbackMonitor::timeCallback (double endSeconds, double cpuSeconds, double blockSeconds) noexcept
+{
+    if (blockSeconds <= 0.0)
+        return;
+
+    // The device can't have asked for this block later than its end minus the CPU it took
+    const double latestStart = endSeconds - juce::jmax (0.0, cpuSeconds) - streamSeconds;
+
+    scheduleStart = onSchedule ? juce::jmin (scheduleStart + blockSeconds * driftAllowance, latestStart)
+                               : latestStart;
+    onSchedule = true;
+
+    const double busySeconds = endSeconds - (scheduleStart + streamSeconds);
+    streamSeconds += blockSeconds;
+
+    // The first block has nothing to measure its CPU time from
+    if (cpuSeconds < 0.0)
+        return;
+
+    addCallback (busySeconds, blockSeconds, cpuSeconds);
+
+    // The device drops what it missed and carries on, so pick the schedule up again from the next block
+    if (busySeconds >= blockSeconds * xrunLoad)
+        onSchedule = false;
+}
+
+void AudioCallbackMonitor::addCallback (double busySeconds, double period, double cpuSeconds) noexcept
+{
+    if (period <= 0.0)
+        return;
+
+    const double load = juce::jmax (0.0, busySeconds) / period;
+
+    histogram[(size_t) getHistogramBin (load)].fetch_add (1, std::memory_order_relaxed);
+    numCallbacks.fetch_add (1, std::memory_order_relaxed);
+
+    auto worst = worstLoad.load (std::memory_order_relaxed);
+    while ((float) load > worst && ! worstLoad.compare_exchange_weak (worst, (float) load, std::memory_order_relaxed)) {}
+
+    if (load < nearMissLoad)
+        return;
+
+    Event event;
+    event.type = load >= xrunLoad ? EventType::xrun : EventType::nearMiss;
+    event.timeMs = juce::Time::currentTimeMillis();
+    event.load = load;
+    event.cpuLoad = cpuSeconds >= 0.0 ? cpuSeconds / period : -1.0;
+
+    (event.type == EventType::xrun ? numXruns : numNearMisses).fetch_add (1, std::memory_order_relaxed);
+    pushEvent (event);
+}
+
+void AudioCallbackMonitor::pushEvent (const Event& event) noexcept
+{
+    const auto write = eventWrite.load (std::memory_order_relaxed);
+
+    if (write - eventRead.load (std::memory_order_acquire) >= eventQueueSize)
+    {
+        droppedEvents.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    eventQueue[write % eventQueueSize] = event;
+    eventWrite.store (write + 1, std::memory_order_release);
+}
+
+//==============================================================================
+// Device changes
+
+void AudioCallbackMonitor::audioDeviceAboutToStart (juce::AudioIODevice* device)
+{
+    sampleRate = device->getCurrentSampleRate();
+    const auto bufferSize = device->getCurrentBufferSizeSamples();
+
+    periodSeconds = sampleRate > 0.0 ? bufferSize / sampleRate : 0.0;
+    lastThreadCpuSeconds = -1.0;
+    streamSeconds = 0.0;
+    onSchedule = false;
+    currentDevice = device;
+    lastDeviceXruns = device->getXRunCount();
+
+    writeToLog ("Device started: " + device->getName() + ", " + juce::String (bufferSize) + " samples @ "
+                + juce::String (sampleRate, 0) + " Hz (period " + juce::String (periodSeconds * 1000.0, 2) + " ms)");
+}
+
+void AudioCallbackMonitor::audioDeviceStopped()
+{
+    currentDevice = nullptr;
+    lastDeviceXruns = -1;
+}
+
+//==============================================================================
+// Message thread
+
+void AudioCallbackMonitor::processPendingEvents()
+{
+    std::vector<Event> newEvents;
+
+    auto read = eventRead.load (std::memory_order_relaxed);
+    const auto write = eventWrite.load (std::memory_order_acquire);
+
+    for (; read != write; ++read)
+        newEvents.push_back (eventQueue[read % eventQueueSize]);
+
+    eventRead.store (read, std::memory_order_release);
+
+    // Dropouts the driver noticed that weren't ours to time (e.g. another app hogging the device)
+    if (currentDevice != nullptr)
+    {
+        const int deviceXruns = currentDevice->getXRunCount();
+
+        if (deviceXruns > lastDeviceXruns && lastDeviceXruns >= 0)
+        {
+            Event event;
+            event.type = EventType::deviceXrun;
+            event.timeMs = juce::Time::currentTimeMillis();
+
+            for (int i = lastDeviceXruns; i < deviceXruns; ++i)
+                newEvents.push_back (event);
+
+            numXruns.fetch_add ((juce::uint64) (deviceXruns - lastDeviceXruns), std::memory_order_relaxed);
+        }
+
+        lastDeviceXruns = deviceXruns;
+    }
+
+    if (const auto dropped = droppedEvents.exchange (0, std::memory_order_relaxed); dropped > 0)
+        writeToLog (juce::String ((juce::int64) dropped) + " events dropped (queue full)");
+
+    for (auto& event : newEvents)
+    {
+        event.transportSeconds = getTransportSecondsAt ? getTransportSecondsAt (event.timeMs) : 0.0;
+        writeToLog (formatEvent (event), juce::Time (event.timeMs));
+        recentEvents.push_back (event);
+    }
+
+    while (recentEvents.size() > maxRecentEvents)
+        recentEvents.pop_front();
+}
+
+AudioCallbackMonitor::Stats AudioCallbackMonitor::getStats() const
+{
+    Stats s;
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        s.histogram[i] = histogram[i].load (std::memory_order_relaxed);
+
+    s.numCallbacks  = numCallbacks.load (std::memory_order_relaxed);
+    s.numNearMisses = numNearMisses.load (std::memory_order_relaxed);
+    s.numXruns      = numXruns.load (std::memory_order_relaxed);
+    s.worstLoad     = worstLoad.load (std::memory_order_relaxed);
+    s.periodMs      = periodSeconds.load (std::memory_order_relaxed) * 1000.0;
+    return s;
+}
+
+std::vector<AudioCallbackMonitor::Event> AudioCallbackMonitor::getRecentEvents() const
+{
+    return { recentEvents.begin(), recentEvents.end() };
+}
+
+void AudioCallbackMonitor::reset()
+{
+    for (auto& bin : histogram)
+        bin.store (0, std::memory_order_relaxed);
+
+    numCallbacks  = 0;
+    numNearMisses = 0;
+    numXruns      = 0;
+    worstLoad     = 0.0f;
+    recentEvents.clear();
+}
+
+void AudioCallbackMonitor::writeToLog (const juce::String& line, juce::Time time)
+{
+    if (logFile == juce::File())
+        return;
+
+    // Roll over: keep one previous file next to the current one
+    if (logFile.getSize() > maxLogBytes)
+    {
+        const auto previous = logFile.getSiblingFile (logFile.getFileNameWithoutExtension() + ".1" + logFile.getFileExtension());
+        previous.deleteFile();
+        logFile.moveFileTo (previous);
+    }
+
+    logFile.getParentDirectory().createDirectory();
+    logFile.appendText (time.formatted ("%Y-%m-%d %H:%M:%S.") + juce::String (time.getMilliseconds()).paddedLeft ('0', 3)
+                        + "  " + line + "\n", false, false, "\n");
+}
+
+//==============================================================================
+// Formatting
+
+int AudioCallbackMonitor::getHistogramBin (double load) noexcept
+{
+    if (load >= 1.5)
+        return numHistogramBins - 1;
+
+    if (load >= 1.0)
+        return numHistogramBins - 2;
+
+    return juce::jlimit (0, numHistogramBins - 3, (int) (load * 10.0));
+}
+
+juce::String AudioCallbackMonitor::getHistogramBinLabel (int bin)
+{
+    if (bin == numHistogramBins - 1)
+        return ">150%";
+
+    if (bin == numHistogramBins - 2)
+        return "100-150%";
+
+    return juce::String (bin * 10) + "-" + juce::String ((bin + 1) * 10) + "%";
+}
+
+juce::String AudioCallbackMonitor::formatEvent (const Event& event)
+{
+    const auto took = [&event]
+    {
+        auto text = "callback took " + juce::String (event.load * 100.0, 1) + "% of the period";
+
+        if (event.cpuLoad >= 0.0)
+            text << " (" << juce::String (event.cpuLoad * 100.0, 1) << "% on the CPU)";
+
+        return text + " at " + formatTransportTime (event.transportSeconds);
+    };
+
+    switch (event.type)
+    {
+        case EventType::deviceXrun:
+            return "XRUN (reported by device) at " + formatTransportTime (event.transportSeconds);
+
+        case EventType::xrun:
+            return "XRUN: " + took();
+
+        case EventType::nearMiss:
+        default:
+            return "Near miss: " + took();
+    }
+}
+
+juce::File AudioCallbackMonitor::getDefaultLogFile()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+        .getChildFile ("GrooveKit")
+        .getChildFile ("Logs")
+        .getChildFile ("audio-callback.log");
+}
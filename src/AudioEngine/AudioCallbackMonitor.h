@@ -0,0 +1,168 @@
+#pragma once
+
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Watches the audio device callback for overloads and dropouts.
+ *
+ * The monitor is added to the AudioDeviceManager as an extra callback, so it
+ * runs right after Tracktion has rendered each block (JUCE calls extra
+ * callbacks on the same thread, after the first one). It can't see when the
+ * block was asked for, so it times it by wall clock against the device's
+ * schedule: blocks are due one period apart, and a block can't have been due
+ * later than its end minus the CPU time it used. The earliest such bound gives
+ * the schedule (allowed to creep forward slowly to follow the device's clock);
+ * the time from a block being due to it being ready counts as its callback
+ * time. Unlike CPU time alone, that includes time spent blocked, waiting for
+ * worker threads or behind a late previous block. The CPU time is kept with
+ * each event as a second figure.
+ *
+ * Each callback's time, as a fraction of the buffer period, goes into a
+ * histogram. A callback using 80% of the period or more is a near miss; one
+ * that used the whole period (or a dropout the device itself reports) is an
+ * xrun. Near misses and xruns are queued lock-free with their time; a
+ * message-thread timer looks up their transport position, moves them into a
+ * short list for the UI and appends them to a rolling log file.
+ *
+ * Everything the audio thread touches is atomics or preallocated.
+ */
+class AudioCallbackMonitor : public juce::AudioIODeviceCallback,
+                             private juce::Timer
+{
+public:
+    //==============================================================================
+    /** 10% bins up to the full period, then 100–150% and above 150%. */
+    static constexpr int numHistogramBins = 12;
+    static constexpr double nearMissLoad  = 0.8;
+    static constexpr double xrunLoad      = 1.0;
+    static constexpr double driftAllowance = 0.001;   ///< How fast the schedule may creep forward, per second of audio
+
+    static constexpr int pollIntervalMs        = 250;
+    static constexpr size_t maxRecentEvents    = 100;
+    static constexpr juce::int64 maxLogBytes   = 1024 * 1024;   ///< Then rolled over to "<name>.1.log"
+
+    enum class EventType
+    {
+        nearMiss,
+        xrun,          ///< The callback overran its period.
+        deviceXrun     ///< Reported by the driver (counted by the device, not timed here).
+    };
+
+    struct Event
+    {
+        EventType type = EventType::nearMiss;
+        juce::int64 timeMs = 0;            ///< juce::Time::currentTimeMillis()
+        double load = 0.0;                 ///< Callback time / buffer period (0 for device xruns)
+        double cpuLoad = -1.0;             ///< CPU time / buffer period; < 0 when not measured
+        double transportSeconds = 0.0;
+    };
+
+    struct Stats
+    {
+        std::array<juce::uint64, numHistogramBins> histogram {};
+        juce::uint64 numCallbacks = 0;
+        juce::uint64 numNearMisses = 0;
+        juce::uint64 numXruns = 0;
+        double worstLoad = 0.0;
+        double periodMs = 0.0;
+    };
+
+    /**
+     * @param getTransportSecondsAt  called on the message thread with an event's juce::Time::currentTimeMillis(),
+     *                               to place it on the timeline.
+     * @param logFile                rolling log the events are appended to.
+     */
+    AudioCallbackMonitor (std::function<double (juce::int64)> getTransportSecondsAt, juce::File logFile);
+    ~AudioCallbackMonitor() override;
+
+    //==============================================================================
+    // Message thread
+
+    Stats getStats() const;
+
+    /** Most recent near misses and xruns, oldest first. */
+    std::vector<Event> getRecentEvents() const;
+
+    /** Clears the histogram, counters and recent events (not the log file). */
+    void reset();
+
+    const juce::File& getLogFile() const noexcept { return logFile; }
+
+    /** Moves queued events to the recent list and the log; normally the timer does this. */
+    void processPendingEvents();
+
+    //==============================================================================
+    // Audio thread
+
+    /**
+     * @brief Times a block of @p blockSeconds that was ready at @p endSeconds.
+     *
+     * @p endSeconds is on the high-resolution clock and @p cpuSeconds is the
+     * CPU time the audio thread used on the block (< 0 if unknown). Called by
+     * the device callback; public so tests can drive the schedule.
+     */
+    void timeCallback (double endSeconds, double cpuSeconds, double blockSeconds) noexcept;
+
+    /**
+     * Accounts one callback that took @p busySeconds of a @p periodSeconds buffer
+     * period, @p cpuSeconds of it on the CPU (< 0 if unknown).
+     */
+    void addCallback (double busySeconds, double periodSeconds, double cpuSeconds = -1.0) noexcept;
+
+    //==============================================================================
+    static int getHistogramBin (double load) noexcept;
+    static juce::String getHistogramBinLabel (int bin);
+    static juce::String formatEvent (const Event& event);
+
+    /** GrooveKit/Logs/audio-callback.log in the user's application data folder. */
+    static juce::File getDefaultLogFile();
+
+    //==============================================================================
+    // juce::AudioIODeviceCallback
+    void audioDeviceIOCallbackWithContext (const float* const* inputChannelData, int numInputChannels,
+                                           float* const* outputChannelData, int numOutputChannels,
+                                           int numSamples, const juce::AudioIODeviceCallbackContext& context) override;
+    void audioDeviceAboutToStart (juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+
+private:
+    void timerCallback() override { processPendingEvents(); }
+
+    void pushEvent (const Event& event) noexcept;
+    void writeToLog (const juce::String& line, juce::Time time = juce::Time::getCurrentTime());
+
+    std::function<double (juce::int64)> getTransportSecondsAt;
+    const juce::File logFile;
+
+    // Written by the audio thread
+    std::array<std::atomic<juce::uint64>, numHistogramBins> histogram {};
+    std::atomic<juce::uint64> numCallbacks { 0 }, numNearMisses { 0 }, numXruns { 0 };
+    std::atomic<float> worstLoad { 0.0f };
+
+    // Audio thread only
+    double lastThreadCpuSeconds = -1.0;    ///< < 0 until the first callback
+    double streamSeconds = 0.0;            ///< Audio handed to the device since it started
+    double scheduleStart = 0.0;            ///< When the device asked for its first block, on the high-resolution clock
+    bool onSchedule = false;               ///< scheduleStart is set
+
+    // Device details, set in audioDeviceAboutToStart
+    std::atomic<double> periodSeconds { 0.0 };
+    double sampleRate = 0.0;
+    juce::AudioIODevice* currentDevice = nullptr;
+    int lastDeviceXruns = -1;
+
+    // Single-producer/single-consumer event queue (audio thread → timer)
+    static constexpr juce::uint32 eventQueueSize = 256;
+    std::array<Event, eventQueueSize> eventQueue {};
+    std::atomic<juce::uint32> eventWrite { 0 }, eventRead { 0 };
+    std::atomic<juce::uint64> droppedEvents { 0 };
+
+    std::deque<Event> recentEvents;        ///< Message thread only
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioCallbackMonitor)
+};
@@ -11,12 +11,20 @@ using namespace t::literals;
 // Construction / Destruction
 
 AudioEngine::AudioEngine(te::Edit& editRef, te::Engine& engine)
-    : edit(editRef), engine(engine)
+    : edit(editRef), engine(engine),
+      callbackMonitor ([this] (juce::int64 timeMs) { return getTransportSecondsAt (timeMs); },
+                       AudioCallbackMonitor::getDefaultLogFile())
 {
     midiEngine = std::make_unique<MIDIEngine>(edit);
+
+    // Runs after Tracktion's own callback on the audio thread
+    adm().addAudioCallback (&callbackMonitor);
 }
 
-AudioEngine::~AudioEngine() = default;
+AudioEngine::~AudioEngine()
+{
+    adm().removeAudioCallback (&callbackMonitor);
+}
 
 //==============================================================================
 // Transport Control
@@ -46,6 +54,27 @@ void AudioEngine::stop() {
 
 bool AudioEngine::isPlaying() const { return edit.getTransport().isPlaying(); }
 
+double AudioEngine::getTransportSecondsAt (juce::int64 timeMs) const
+{
+    auto& transport = edit.getTransport();
+    auto seconds = transport.getPosition().inSeconds();
+
+    if (! transport.isPlaying())
+        return seconds;
+
+    // Wind back by the time since then, wrapping inside the loop the way playback did
+    seconds -= (double) (Time::currentTimeMillis() - timeMs) * 0.001;
+
+    const auto loop = transport.getLoopRange();
+    const auto loopStart = loop.getStart().inSeconds();
+    const auto loopLength = loop.getLength().inSeconds();
+
+    if (transport.looping && loopLength > 0.0 && seconds < loopStart)
+        seconds = loopStart + std::fmod (seconds - loopStart, loopLength) + loopLength;
+
+    return jmax (0.0, seconds);
+}
+
 //==============================================================================
 // Audio Device Management
 
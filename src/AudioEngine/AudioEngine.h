@@ -1,5 +1,7 @@
 #pragma once
 #include "../MIDIEngine/MIDIEngine.h"
+#include "AudioCallbackMonitor.h"
+#include "RtLog.h"
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <tracktion_engine/tracktion_engine.h>
 
@@ -14,6 +16,7 @@ namespace te = tracktion::engine;
  *  - Transport control (play, stop, recording)
  *  - MIDI input device management and routing
  *  - Default audio configuration (48kHz sample rate, 512 buffer size)
+ *  - Callback timing: a histogram of callback load and an xrun log (AudioCallbackMonitor)
  *
  * This class is owned by AppEngine and coordinates with MIDIEngine for clip management.
  */
@@ -154,6 +157,14 @@ public:
      */
     bool setSampleRate (double sampleRate);
 
+    /**
+     * @brief Returns the device callback monitor (timing histogram, near misses, xruns).
+     *
+     * Attached to the device for this AudioEngine's lifetime; statistics start
+     * again when the edit (and with it the AudioEngine) is replaced.
+     */
+    AudioCallbackMonitor& getCallbackMonitor() { return callbackMonitor; }
+
     //==============================================================================
     // MIDI Input Device Management
 
@@ -230,6 +241,14 @@ private:
      */
     bool applySetup (const juce::AudioDeviceManager::AudioDeviceSetup& setup);
 
+    /**
+     * @brief Transport position at an earlier juce::Time::currentTimeMillis().
+     *
+     * Worked back from the current position on the message thread, so the
+     * callback monitor never reads the transport from the audio thread.
+     */
+    double getTransportSecondsAt (juce::int64 timeMs) const;
+
     //==============================================================================
     // Internal Classes
 
@@ -237,7 +256,8 @@ private:
      * @brief MIDI event logger for debugging recording issues.
      *
      * Attached to the engine's MIDI device manager to intercept and log all
-     * incoming MIDI messages during recording sessions.
+     * incoming MIDI messages during recording sessions. Runs on the MIDI
+     * thread, so it only queues RtLog records.
      */
     class MidiEventLogger : public juce::MidiInputCallback
     {
@@ -250,31 +270,40 @@ private:
             if (!enabled)
                 return;
 
-            juce::String desc;
+            // MIDI thread: queue a fixed-size record, the RtLog writer formats it
+            const auto channel = message.getChannel();
+            const auto time = message.getTimeStamp();
 
             if (message.isNoteOn())
-                desc = "NOTE ON:  Note=" + juce::String(message.getNoteNumber()) +
-                       " Velocity=" + juce::String(message.getVelocity());
+                rtLog->log (RtLog::Level::info, RtLog::Event::midiNoteOn, channel,
+                            message.getNoteNumber(), message.getVelocity(), time);
             else if (message.isNoteOff())
-                desc = "NOTE OFF: Note=" + juce::String(message.getNoteNumber()) +
-                       " Velocity=" + juce::String(message.getVelocity());
+                rtLog->log (RtLog::Level::info, RtLog::Event::midiNoteOff, channel,
+                            message.getNoteNumber(), message.getVelocity(), time);
             else if (message.isController())
-                desc = "CC:       Controller=" + juce::String(message.getControllerNumber()) +
-                       " Value=" + juce::String(message.getControllerValue());
+                rtLog->log (RtLog::Level::info, RtLog::Event::midiController, channel,
+                            message.getControllerNumber(), message.getControllerValue(), time);
             else if (message.isPitchWheel())
-                desc = "PITCH BEND: " + juce::String(message.getPitchWheelValue());
+                rtLog->log (RtLog::Level::info, RtLog::Event::midiPitchBend, channel,
+                            message.getPitchWheelValue(), 0, time);
             else
-                desc = message.getDescription();
-
-            juce::Logger::writeToLog("[MIDI EVENT] " + desc +
-                                    " | Time=" + juce::String(message.getTimeStamp(), 3) + "s" +
-                                    " | Channel=" + juce::String(message.getChannel()));
+                rtLog->log (RtLog::Level::info, RtLog::Event::midiOther, channel,
+                            packFirstBytes (message), message.getRawDataSize(), time);
         }
 
         void setEnabled(bool shouldEnable) { enabled = shouldEnable; }
 
     private:
+        static int packFirstBytes (const juce::MidiMessage& message) noexcept
+        {
+            int packed = 0;
+            for (int i = 0; i < juce::jmin (3, message.getRawDataSize()); ++i)
+                packed |= message.getRawData()[i] << (8 * i);
+            return packed;
+        }
+
         std::atomic<bool> enabled{false};
+        juce::SharedResourcePointer<RtLog> rtLog;
     };
 
     //==============================================================================
@@ -284,4 +313,5 @@ private:
     std::unique_ptr<MIDIEngine> midiEngine;    ///< MIDI clip management engine.
     te::Engine& engine;                        ///< Reference to the Tracktion Engine (not owned).
     MidiEventLogger midiEventLogger;           ///< MIDI event logger for debugging.
+    AudioCallbackMonitor callbackMonitor;      ///< Device callback timing; registered with the device manager.
 };
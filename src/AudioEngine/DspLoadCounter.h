@@ -0,0 +1,91 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+/**
+ * @brief Lock-free accumulator for the CPU time a plugin spends per audio callback.
+ *
+ * The audio thread adds one entry per processed block (time spent vs. the
+ * block's real-time duration); a reader on another thread periodically takes
+ * the figures, which also starts a new measuring interval. Only relaxed
+ * atomics are used, so the audio thread never blocks. A block that finishes
+ * while take() runs may be counted in either interval.
+ *
+ * Loads are fractions of the real-time budget: 1.0 means the plugin alone used
+ * the whole callback period.
+ */
+class DspLoadCounter
+{
+public:
+    struct Figures
+    {
+        double average = 0.0;          ///< Busy time / audio time over the interval
+        double peak    = 0.0;          ///< Worst single callback in the interval
+        juce::int64 numCallbacks = 0;
+    };
+
+    /** Audio thread: accounts one callback that took @p busySeconds to process @p numSamples. */
+    void addCallback (double busySeconds, int numSamples, double sampleRate) noexcept
+    {
+        if (numSamples <= 0 || sampleRate <= 0.0)
+            return;
+
+        const double budgetSeconds = numSamples / sampleRate;
+
+        busyNanos.fetch_add (toNanos (busySeconds), std::memory_order_relaxed);
+        budgetNanos.fetch_add (toNanos (budgetSeconds), std::memory_order_relaxed);
+        callbacks.fetch_add (1, std::memory_order_relaxed);
+
+        const auto ratio = (float) (busySeconds / budgetSeconds);
+        auto previous = peak.load (std::memory_order_relaxed);
+
+        while (ratio > previous && ! peak.compare_exchange_weak (previous, ratio, std::memory_order_relaxed)) {}
+    }
+
+    /** Any thread: returns the figures since the last call and resets them. */
+    Figures take() noexcept
+    {
+        Figures f;
+        const auto busy   = busyNanos.exchange (0, std::memory_order_relaxed);
+        const auto budget = budgetNanos.exchange (0, std::memory_order_relaxed);
+
+        f.numCallbacks = callbacks.exchange (0, std::memory_order_relaxed);
+        f.peak         = peak.exchange (0.0f, std::memory_order_relaxed);
+        f.average      = budget > 0 ? (double) busy / (double) budget : 0.0;
+        return f;
+    }
+
+    /** Times the enclosing scope and adds it to the counter on exit. */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer (DspLoadCounter& c, int numSamplesToProcess, double rate) noexcept
+            : counter (c), numSamples (numSamplesToProcess), sampleRate (rate),
+              startTicks (juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            const auto elapsed = juce::Time::getHighResolutionTicks() - startTicks;
+            counter.addCallback (juce::Time::highResolutionTicksToSeconds (elapsed), numSamples, sampleRate);
+        }
+
+    private:
+        DspLoadCounter& counter;
+        const int numSamples;
+        const double sampleRate;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+private:
+    static juce::int64 toNanos (double seconds) noexcept { return (juce::int64) (seconds * 1.0e9); }
+
+    std::atomic<juce::int64> busyNanos { 0 };
+    std::atomic<juce::int64> budgetNanos { 0 };
+    std::atomic<juce::int64> callbacks { 0 };
+    std::atomic<float> peak { 0.0f };
+};
@@ -0,0 +1,160 @@
+#include "MeterTap.h"
+#include <cmath>
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    /** BS.1770 stage 1: high shelf modelling the head, as { b0, b1, b2, a1, a2 } for @p sampleRate. */
+    std::array<double, 5> shelfCoefficients (double sampleRate)
+    {
+        constexpr double f0 = 1681.974450955533;
+        constexpr double gainDb = 3.999843853973347;
+        constexpr double q = 0.7071752369554196;
+
+        const double k  = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow (10.0, gainDb / 20.0);
+        const double vb = std::pow (vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        return { (vh + vb * k / q + k * k) / a0,
+                 2.0 * (k * k - vh) / a0,
+                 (vh - vb * k / q + k * k) / a0,
+                 2.0 * (k * k - 1.0) / a0,
+                 (1.0 - k / q + k * k) / a0 };
+    }
+
+    /** BS.1770 stage 2: the RLB high-pass. */
+    std::array<double, 5> highPassCoefficients (double sampleRate)
+    {
+        constexpr double f0 = 38.13547087602444;
+        constexpr double q = 0.5003270373238773;
+
+        const double k  = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        return { 1.0, -2.0, 1.0,
+                 2.0 * (k * k - 1.0) / a0,
+                 (1.0 - k / q + k * k) / a0 };
+    }
+}
+
+//==============================================================================
+// Setup
+
+MeterTap::MeterTap()
+{
+    for (auto& p : peak) p.store (0.0f);
+    for (auto& r : rms)  r.store (0.0f);
+
+    prepare (48000.0);
+}
+
+void MeterTap::prepare (double sampleRate)
+{
+    if (sampleRate <= 0.0)
+        sampleRate = 48000.0;
+
+    for (auto& ch : channels)
+    {
+        ch = {};
+        ch.shelf.setCoefficients (shelfCoefficients (sampleRate));
+        ch.highPass.setCoefficients (highPassCoefficients (sampleRate));
+    }
+
+    rmsCoefficient  = 1.0 - std::exp (-1.0 / (rmsTimeConstantSeconds * sampleRate));
+    samplesPerBlock = juce::jmax (1, juce::roundToInt (loudnessBlockSeconds * sampleRate));
+    samplesInBlock  = 0;
+    blockEnergy     = 0.0;
+    blockLoudness.fill (0.0);
+    nextBlock       = 0;
+
+    for (auto& p : peak) p.store (0.0f, std::memory_order_relaxed);
+    for (auto& r : rms)  r.store (0.0f, std::memory_order_relaxed);
+    shortTermLufs.store (minLufs, std::memory_order_relaxed);
+    processed.store (false, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Audio thread
+
+void MeterTap::process (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    const int numInputs = juce::jmin (numChannels, buffer.getNumChannels());
+
+    if (numInputs == 0 || numSamples <= 0)
+        return;
+
+    std::array<const float*, numChannels> data {};
+    std::array<float, numChannels> blockPeak {};
+
+    for (int ch = 0; ch < numInputs; ++ch)
+        data[(size_t) ch] = buffer.getReadPointer (ch, startSample);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int ch = 0; ch < numInputs; ++ch)
+        {
+            auto& state = channels[(size_t) ch];
+            const double x = data[(size_t) ch][i];
+
+            blockPeak[(size_t) ch] = juce::jmax (blockPeak[(size_t) ch], (float) std::abs (x));
+            state.meanSquare += rmsCoefficient * (x * x - state.meanSquare);
+
+            const double weighted = state.highPass.process (state.shelf.process (x));
+            blockEnergy += weighted * weighted;
+        }
+
+        if (++samplesInBlock == samplesPerBlock)
+        {
+            blockLoudness[(size_t) nextBlock] = blockEnergy / samplesPerBlock;
+            nextBlock = (nextBlock + 1) % numLoudnessBlocks;
+            samplesInBlock = 0;
+            blockEnergy = 0.0;
+
+            double sum = 0.0;
+            for (auto e : blockLoudness)
+                sum += e;
+
+            const double meanEnergy = sum / numLoudnessBlocks;
+            const auto lufs = meanEnergy > 0.0 ? (float) (-0.691 + 10.0 * std::log10 (meanEnergy)) : minLufs;
+            shortTermLufs.store (juce::jmax (minLufs, lufs), std::memory_order_relaxed);
+        }
+    }
+
+    // A mono signal shows on both meters
+    if (numInputs == 1)
+    {
+        blockPeak[1] = blockPeak[0];
+        channels[1].meanSquare = channels[0].meanSquare;
+    }
+
+    for (size_t ch = 0; ch < (size_t) numChannels; ++ch)
+    {
+        auto previous = peak[ch].load (std::memory_order_relaxed);
+        while (blockPeak[ch] > previous && ! peak[ch].compare_exchange_weak (previous, blockPeak[ch], std::memory_order_relaxed)) {}
+
+        rms[ch].store ((float) std::sqrt (channels[ch].meanSquare), std::memory_order_relaxed);
+    }
+
+    processed.store (true, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Reader
+
+MeterTap::Readings MeterTap::read() noexcept
+{
+    Readings r;
+
+    for (size_t ch = 0; ch < (size_t) numChannels; ++ch)
+    {
+        r.peak[ch] = peak[ch].exchange (0.0f, std::memory_order_relaxed);
+        r.rms[ch]  = rms[ch].load (std::memory_order_relaxed);
+    }
+
+    r.shortTermLufs = shortTermLufs.load (std::memory_order_relaxed);
+    r.fresh = processed.exchange (false, std::memory_order_relaxed);
+    return r;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Lock-free peak, RMS and short-term loudness meter for one stereo signal.
+ *
+ * The audio thread calls process() for every block; the UI calls read() at
+ * display rate. All state the audio thread touches is preallocated, and the
+ * results are handed over through relaxed atomics, so neither side blocks.
+ *
+ *  - Peak: the largest sample per channel since the previous read().
+ *  - RMS: per channel, exponentially averaged with a 300 ms time constant.
+ *  - Short-term loudness: ITU-R BS.1770 K-weighting, channel energies summed,
+ *    averaged over the last 3 s in 100 ms steps (EBU R128 "short-term").
+ *
+ * Mono signals feed both channels but count once towards the loudness.
+ * When nothing is processed (e.g. the graph is being rebuilt) the readings
+ * are marked stale, so a meter can fall back instead of freezing.
+ */
+class MeterTap
+{
+public:
+    static constexpr int numChannels = 2;
+    static constexpr double rmsTimeConstantSeconds = 0.3;
+    static constexpr double loudnessBlockSeconds   = 0.1;
+    static constexpr int numLoudnessBlocks         = 30;     ///< 3 s window
+    static constexpr float minLufs                 = -70.0f; ///< Reported for silence (the BS.1770 absolute gate)
+
+    struct Readings
+    {
+        std::array<float, numChannels> peak {};    ///< Linear; largest |sample| since the previous read
+        std::array<float, numChannels> rms {};     ///< Linear
+        float shortTermLufs = minLufs;
+        bool fresh = false;                        ///< process() ran since the previous read
+    };
+
+    MeterTap();
+
+    /** Sets the sample rate and clears all state. Not for the audio thread. */
+    void prepare (double sampleRate);
+
+    /** Audio thread: meters @p numSamples of @p buffer from @p startSample. */
+    void process (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+
+    /** Any thread: current figures; also starts a new peak interval. */
+    Readings read() noexcept;
+
+private:
+    /** Transposed direct form II biquad (one channel). */
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1 = 0.0, z2 = 0.0;
+
+        /** { b0, b1, b2, a1, a2 }, normalised so a0 == 1. */
+        void setCoefficients (const std::array<double, 5>& c) noexcept
+        {
+            b0 = c[0]; b1 = c[1]; b2 = c[2]; a1 = c[3]; a2 = c[4];
+        }
+
+        double process (double x) noexcept
+        {
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
+
+    struct ChannelState
+    {
+        Biquad shelf, highPass;        ///< K-weighting stages 1 and 2
+        double meanSquare = 0.0;       ///< RMS smoother state
+    };
+
+    // Audio thread only (besides prepare)
+    std::array<ChannelState, numChannels> channels;
+    double rmsCoefficient = 0.0;
+    int samplesPerBlock = 4800;
+    int samplesInBlock = 0;
+    double blockEnergy = 0.0;
+    std::array<double, numLoudnessBlocks> blockLoudness {};
+    int nextBlock = 0;
+
+    // Handed to the reader
+    std::array<std::atomic<float>, numChannels> peak;
+    std::array<std::atomic<float>, numChannels> rms;
+    std::atomic<float> shortTermLufs { minLufs };
+    std::atomic<bool> processed { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterTap)
+};
@@ -0,0 +1,299 @@
+#include "RtLog.h"
+#include <cmath>
+
+namespace
+{
+    constexpr juce::int64 maxLogBytesAtOpen = 4 * 1024 * 1024;   ///< Larger files are moved to "<name>.1.log" first
+}
+
+//==============================================================================
+// Writer thread
+
+class RtLog::Writer : public juce::Thread
+{
+public:
+    explicit Writer (RtLog& o) : juce::Thread ("RtLog writer"), owner (o) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            owner.writePending();
+            wait (writerIntervalMs);
+        }
+
+        owner.writePending();
+    }
+
+private:
+    RtLog& owner;
+};
+
+//==============================================================================
+// Construction
+
+RtLog::RtLog()
+    : slots (std::make_unique<Slot[]> (queueCapacity)),
+      startTicks (juce::Time::getHighResolutionTicks()),
+      startMs (juce::Time::currentTimeMillis())
+{
+    static_assert ((queueCapacity & (queueCapacity - 1)) == 0, "queueCapacity must be a power of two");
+
+    for (size_t i = 0; i < queueCapacity; ++i)
+        slots[i].sequence.store (i, std::memory_order_relaxed);
+
+    setLogFile (getDefaultLogFile());
+
+    writer = std::make_unique<Writer> (*this);
+    writer->startThread (juce::Thread::Priority::low);
+}
+
+RtLog::~RtLog()
+{
+    writer->stopThread (2000);
+}
+
+//==============================================================================
+// Producers
+
+void RtLog::log (Level l, Event event, int channel, int a, int b, double value) noexcept
+{
+    if (! isEnabled (l))
+        return;
+
+    Record record;
+    record.ticks   = juce::Time::getHighResolutionTicks();
+    record.value   = value;
+    record.a       = a;
+    record.b       = b;
+    record.level   = l;
+    record.event   = event;
+    record.channel = (juce::uint8) channel;
+
+    if (tryPush (record))
+    {
+        numQueued.fetch_add (1, std::memory_order_relaxed);
+    }
+    else
+    {
+        pendingDropped.fetch_add (1, std::memory_order_relaxed);
+        totalDropped.fetch_add (1, std::memory_order_relaxed);
+    }
+}
+
+bool RtLog::tryPush (const Record& record) noexcept
+{
+    // Bounded multi-producer queue: each slot's sequence says whose turn it is
+    auto pos = enqueuePos.load (std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& slot = slots[pos & (queueCapacity - 1)];
+        const auto seq = slot.sequence.load (std::memory_order_acquire);
+        const auto diff = (std::ptrdiff_t) seq - (std::ptrdiff_t) pos;
+
+        if (diff == 0)
+        {
+            if (enqueuePos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot.record = record;
+                slot.sequence.store (pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;   // full
+        }
+        else
+        {
+            pos = enqueuePos.load (std::memory_order_relaxed);
+        }
+    }
+}
+
+//==============================================================================
+// Consumer
+
+bool RtLog::tryPop (Record& record) noexcept
+{
+    auto& slot = slots[dequeuePos & (queueCapacity - 1)];
+
+    if (slot.sequence.load (std::memory_order_acquire) != dequeuePos + 1)
+        return false;
+
+    record = slot.record;
+    slot.sequence.store (dequeuePos + queueCapacity, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void RtLog::writePending()
+{
+    juce::String text;
+    juce::uint64 count = 0;
+    Record record;
+
+    if (const auto dropped = pendingDropped.exchange (0, std::memory_order_relaxed); dropped > 0)
+        text << "[RtLog] " << juce::String ((juce::int64) dropped) << " records dropped (ring full)\n";
+
+    while (tryPop (record))
+    {
+        const auto ms = startMs + (juce::int64) std::llround (juce::Time::highResolutionTicksToSeconds (record.ticks - startTicks) * 1000.0);
+        const juce::Time time (ms);
+
+        text << time.formatted ("%Y-%m-%d %H:%M:%S.") << juce::String (time.getMilliseconds()).paddedLeft ('0', 3)
+             << " " << getLevelName (record.level).paddedRight (' ', 7) << formatRecord (record) << "\n";
+        ++count;
+    }
+
+    if (text.isEmpty())
+        return;
+
+    {
+        const juce::ScopedLock sl (fileLock);
+
+        if (stream != nullptr)
+        {
+            stream->writeText (text, false, false, "\n");
+            stream->flush();
+        }
+    }
+
+    juce::Logger::writeToLog (text.trimEnd());
+    numWritten.fetch_add (count, std::memory_order_release);
+}
+
+bool RtLog::flush (int timeoutMs)
+{
+    const auto target = numQueued.load (std::memory_order_relaxed);
+    const auto deadline = juce::Time::getMillisecondCounter() + (juce::uint32) timeoutMs;
+
+    while (numWritten.load (std::memory_order_acquire) < target)
+    {
+        if (juce::Time::getMillisecondCounter() > deadline)
+            return false;
+
+        writer->notify();
+        juce::Thread::sleep (1);
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Log file
+
+void RtLog::setLogFile (const juce::File& file)
+{
+    std::unique_ptr<juce::FileOutputStream> newStream;
+
+    if (file != juce::File())
+    {
+        file.getParentDirectory().createDirectory();
+
+        if (file.getSize() > maxLogBytesAtOpen)
+        {
+            const auto previous = file.getSiblingFile (file.getFileNameWithoutExtension() + ".1" + file.getFileExtension());
+            previous.deleteFile();
+            file.moveFileTo (previous);
+        }
+
+        newStream = std::make_unique<juce::FileOutputStream> (file);
+
+        if (! newStream->openedOk())
+            newStream.reset();
+    }
+
+    const juce::ScopedLock sl (fileLock);
+    logFile = file;
+    stream = std::move (newStream);
+}
+
+juce::File RtLog::getLogFile() const
+{
+    const juce::ScopedLock sl (fileLock);
+    return logFile;
+}
+
+juce::File RtLog::getDefaultLogFile()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+        .getChildFile ("GrooveKit")
+        .getChildFile ("Logs")
+        .getChildFile ("realtime.log");
+}
+
+//==============================================================================
+// Formatting
+
+juce::String RtLog::getLevelName (Level l)
+{
+    switch (l)
+    {
+        case Level::debug:   return "DEBUG";
+        case Level::info:    return "INFO";
+        case Level::warning: return "WARNING";
+        case Level::error:   return "ERROR";
+        case Level::off:
+        default:             return "OFF";
+    }
+}
+
+juce::String RtLog::formatRecord (const Record& r)
+{
+    using juce::String;
+
+    const auto midiSuffix = [&r]
+    {
+        return " | Time=" + String (r.value, 3) + "s | Channel=" + String (r.channel);
+    };
+
+    switch (r.event)
+    {
+        case Event::midiNoteOn:
+            return "[MIDI EVENT] NOTE ON:  Note=" + String (r.a) + " Velocity=" + String (r.b) + midiSuffix();
+
+        case Event::midiNoteOff:
+            return "[MIDI EVENT] NOTE OFF: Note=" + String (r.a) + " Velocity=" + String (r.b) + midiSuffix();
+
+        case Event::midiController:
+            return "[MIDI EVENT] CC:       Controller=" + String (r.a) + " Value=" + String (r.b) + midiSuffix();
+
+        case Event::midiPitchBend:
+            return "[MIDI EVENT] PITCH BEND: " + String (r.a) + midiSuffix();
+
+        case Event::midiOther:
+        {
+            juce::StringArray bytes;
+            for (int i = 0; i < juce::jmin (3, r.b); ++i)
+                bytes.add (String::toHexString ((r.a >> (8 * i)) & 0xff).paddedLeft ('0', 2).toUpperCase());
+
+            if (r.b > 3)
+                bytes.add ("... (" + String (r.b) + " bytes)");
+
+            return "[MIDI EVENT] " + bytes.joinIntoString (" ") + midiSuffix();
+        }
+
+        case Event::recorderNoteOn:
+            return "[MidiRecorder] NOTE ON:  Note=" + String (r.a) + " Velocity=" + String (r.value, 2) + " Channel=" + String (r.channel);
+
+        case Event::recorderNoteOff:
+            return "[MidiRecorder] NOTE OFF: Note=" + String (r.a) + " Velocity=" + String (r.value, 2) + " Channel=" + String (r.channel);
+
+        case Event::recorderOrphanNoteOff:
+            return "[MidiRecorder] Discarding orphaned NOTE OFF (no matching note-on): Note=" + String (r.a);
+
+        case Event::recorderLoopReplace:
+            return "[MidiRecorder] Loop wraparound detected - clearing recording buffer";
+
+        case Event::recorderLoopNewTake:
+            return "[MidiRecorder] Loop wraparound detected - starting take " + String (r.a);
+
+        case Event::recorderLoopOverdub:
+            return "[MidiRecorder] Loop wraparound detected - overdubbing next pass";
+
+        default:
+            return "[RtLog] Unknown event " + String ((int) r.event);
+    }
+}
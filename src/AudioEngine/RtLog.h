@@ -0,0 +1,132 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Logging that is safe to call from the audio and MIDI threads.
+ *
+ * Callers log an event ID plus a few numbers; nothing is formatted, allocated
+ * or locked on the calling thread. Each call becomes a fixed-size Record in a
+ * preallocated lock-free ring (bounded multi-producer queue, so several MIDI
+ * devices can log at once). A background thread formats the records, appends
+ * them to a log file and echoes them to juce::Logger.
+ *
+ * When the ring is full, records are dropped and counted; the writer notes
+ * how many were lost. The level can be changed at any time from any thread.
+ *
+ * Share one instance with juce::SharedResourcePointer<RtLog>; it lives as
+ * long as something holds it.
+ */
+class RtLog
+{
+public:
+    //==============================================================================
+    enum class Level : juce::uint8
+    {
+        debug,
+        info,
+        warning,
+        error,
+        off
+    };
+
+    /** What happened; each ID has its own message template (see formatRecord). */
+    enum class Event : juce::uint8
+    {
+        midiNoteOn,                ///< a = note, b = velocity, value = timestamp (s)
+        midiNoteOff,               ///< a = note, b = velocity, value = timestamp (s)
+        midiController,            ///< a = controller, b = value, value = timestamp (s)
+        midiPitchBend,             ///< a = pitch wheel value, value = timestamp (s)
+        midiOther,                 ///< a = first three raw bytes, b = raw size, value = timestamp (s)
+
+        recorderNoteOn,            ///< a = note, value = velocity
+        recorderNoteOff,           ///< a = note, value = velocity
+        recorderOrphanNoteOff,     ///< a = note
+        recorderLoopReplace,
+        recorderLoopNewTake,       ///< a = take number (1-based)
+        recorderLoopOverdub
+    };
+
+    /** One log call. Trivially copyable and the same size for every event. */
+    struct Record
+    {
+        juce::int64 ticks = 0;     ///< juce::Time::getHighResolutionTicks() at the call
+        double value = 0.0;
+        juce::int32 a = 0, b = 0;
+        Level level = Level::info;
+        Event event = Event::midiOther;
+        juce::uint8 channel = 0;
+    };
+
+    static constexpr size_t queueCapacity = 4096;   ///< Records; power of two
+    static constexpr int writerIntervalMs = 50;
+
+    RtLog();
+    ~RtLog();
+
+    //==============================================================================
+    // Any thread, including the audio and MIDI threads
+
+    void setLevel (Level newLevel) noexcept           { level.store (newLevel, std::memory_order_relaxed); }
+    Level getLevel() const noexcept                   { return level.load (std::memory_order_relaxed); }
+    bool isEnabled (Level l) const noexcept           { return l >= getLevel() && l != Level::off; }
+
+    /** Queues a record if @p l is enabled. Never blocks; drops the record if the ring is full. */
+    void log (Level l, Event event, int channel = 0, int a = 0, int b = 0, double value = 0.0) noexcept;
+
+    //==============================================================================
+    // Message thread
+
+    /** Where the writer appends; defaults to getDefaultLogFile(). An empty file just echoes to juce::Logger. */
+    void setLogFile (const juce::File& file);
+    juce::File getLogFile() const;
+
+    /** Waits until everything queued so far has been written (for tests and shutdown). */
+    bool flush (int timeoutMs = 2000);
+
+    juce::uint64 getNumDropped() const noexcept       { return totalDropped.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    static juce::String formatRecord (const Record& record);
+    static juce::String getLevelName (Level l);
+
+    /** GrooveKit/Logs/realtime.log in the user's application data folder. */
+    static juce::File getDefaultLogFile();
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        std::atomic<size_t> sequence { 0 };
+        Record record;
+    };
+
+    class Writer;
+
+    bool tryPush (const Record& record) noexcept;
+    bool tryPop (Record& record) noexcept;     ///< Writer thread only
+    void writePending();                       ///< Writer thread only
+
+    std::atomic<Level> level { Level::info };
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<size_t> enqueuePos { 0 };
+    size_t dequeuePos = 0;
+
+    std::atomic<juce::uint64> numQueued { 0 }, numWritten { 0 };
+    std::atomic<juce::uint64> pendingDropped { 0 }, totalDropped { 0 };
+
+    mutable juce::CriticalSection fileLock;    ///< Guards the file between the writer and setLogFile
+    juce::File logFile;
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    // Converts record ticks to wall-clock time
+    const juce::int64 startTicks;
+    const juce::int64 startMs;
+
+    std::unique_ptr<Writer> writer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RtLog)
+};
@@ -0,0 +1,259 @@
+#include "OutOfProcessPluginScanner.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Shared state
+
+/** The files still to scan, shared by every worker slot of one scan() call. */
+struct OutOfProcessPluginScanner::Job
+{
+    juce::String formatName;
+    ResultCallback onResult;
+    int batchSize = 1;
+
+    juce::CriticalSection queueLock;
+    juce::StringArray pending;
+
+    juce::CriticalSection resultLock;
+    std::atomic<bool> stop { false };
+    std::atomic<bool> workerUnusable { false };
+
+    juce::StringArray takeBatch (int maxFiles)
+    {
+        const juce::ScopedLock sl (queueLock);
+
+        juce::StringArray batch;
+        for (int i = 0; i < maxFiles && ! pending.isEmpty(); ++i)
+        {
+            batch.add (pending[0]);
+            pending.remove (0);
+        }
+
+        return batch;
+    }
+
+    void requeue (const juce::StringArray& files)
+    {
+        const juce::ScopedLock sl (queueLock);
+
+        for (int i = files.size(); --i >= 0;)
+            pending.insert (0, files[i]);
+    }
+
+    void report (const Result& result)
+    {
+        const juce::ScopedLock sl (resultLock);
+
+        if (onResult)
+            onResult (result);
+    }
+};
+
+/** One worker process at a time, watched by the thread that called scan(). */
+struct OutOfProcessPluginScanner::Slot
+{
+    juce::CriticalSection lock;
+    juce::ChildProcess* process = nullptr;   ///< Set while a worker is running.
+    juce::String currentFile;                ///< Begun but not yet reported.
+    juce::uint32 lastActivityMs = 0;
+    bool timedOut = false;
+    std::atomic<bool> finished { false };
+
+    void setActivity (const juce::String& file)
+    {
+        const juce::ScopedLock sl (lock);
+        currentFile = file;
+        lastActivityMs = juce::Time::getMillisecondCounter();
+    }
+};
+
+//==============================================================================
+// Construction
+
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (Options o)
+    : options (std::move (o))
+{
+    jassert (! options.workerCommand.isEmpty());
+}
+
+//==============================================================================
+// Scanning
+
+bool OutOfProcessPluginScanner::scan (const juce::String& formatName,
+                                      const juce::StringArray& files,
+                                      const ResultCallback& onResult,
+                                      const std::function<bool()>& shouldExit)
+{
+    if (files.isEmpty())
+        return true;
+
+    Job job;
+    job.formatName = formatName;
+    job.onResult = onResult;
+    job.pending = files;
+
+    const int numSlots = juce::jlimit (1, files.size(), options.numWorkers);
+
+    // Spread the files over every worker rather than filling the first ones
+    job.batchSize = juce::jlimit (1, juce::jmax (1, options.batchSize), (files.size() + numSlots - 1) / numSlots);
+    std::vector<std::unique_ptr<Slot>> slots;
+
+    {
+        juce::ThreadPool pool (numSlots);
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            auto* slot = slots.emplace_back (std::make_unique<Slot>()).get();
+
+            pool.addJob ([this, &job, slot]
+            {
+                runSlot (job, *slot);
+                slot->finished = true;
+            });
+        }
+
+        // Watchdog: kill any worker stuck on one plugin for longer than the timeout
+        for (;;)
+        {
+            const bool allFinished = std::all_of (slots.begin(), slots.end(),
+                                                  [] (const auto& s) { return s->finished.load(); });
+            if (allFinished)
+                break;
+
+            if (shouldExit && shouldExit())
+                job.stop = true;
+
+            const auto now = juce::Time::getMillisecondCounter();
+
+            for (auto& slot : slots)
+            {
+                const juce::ScopedLock sl (slot->lock);
+
+                if (slot->process == nullptr)
+                    continue;
+
+                if (job.stop)
+                {
+                    slot->process->kill();
+                }
+                else if (now - slot->lastActivityMs > (juce::uint32) options.timeoutMs)
+                {
+                    slot->timedOut = true;
+                    slot->process->kill();
+                }
+            }
+
+            juce::Thread::sleep (50);
+        }
+    }
+
+    return ! job.workerUnusable;
+}
+
+void OutOfProcessPluginScanner::runSlot (Job& job, Slot& slot)
+{
+    while (! job.stop)
+    {
+        auto remaining = job.takeBatch (job.batchSize);
+        if (remaining.isEmpty())
+            break;
+
+        juce::TemporaryFile jobFile (".xml");
+        juce::ChildProcess process;
+
+        auto args = options.workerCommand;
+        args.add (PluginScanWorker::commandLineSwitch);
+        args.add (jobFile.getFile().getFullPathName());
+
+        if (! PluginScanWorker::writeJobFile (jobFile.getFile(), job.formatName, remaining)
+            || ! process.start (args, juce::ChildProcess::wantStdOut))
+        {
+            job.requeue (remaining);
+            job.workerUnusable = true;
+            job.stop = true;
+            break;
+        }
+
+        {
+            const juce::ScopedLock sl (slot.lock);
+            slot.process = &process;
+            slot.timedOut = false;
+        }
+
+        slot.setActivity ({});
+
+        int numBegun = 0;
+        std::string lineBytes;
+
+        // The pipe is read a byte at a time: ChildProcess reads block until the
+        // requested size arrives, and results must be seen as they're written
+        for (char c; process.readProcessOutput (&c, 1) == 1;)
+        {
+            if (c != '\n')
+            {
+                lineBytes += c;
+                continue;
+            }
+
+            PluginScanWorker::Message message;
+            const auto line = juce::String::fromUTF8 (lineBytes.data(), (int) lineBytes.size());
+            lineBytes.clear();
+
+            if (! PluginScanWorker::parseLine (line, message))
+                continue;
+
+            if (message.type == PluginScanWorker::Message::Type::begin)
+            {
+                ++numBegun;
+                slot.setActivity (message.fileOrIdentifier);
+                continue;
+            }
+
+            slot.setActivity ({});
+            remaining.removeString (message.fileOrIdentifier);
+
+            Result result;
+            result.fileOrIdentifier = message.fileOrIdentifier;
+            result.types = message.types;
+            result.outcome = message.types.isEmpty() ? Result::Outcome::failed : Result::Outcome::ok;
+            job.report (result);
+        }
+
+        if (! process.waitForProcessToFinish (1000))
+            process.kill();
+
+        juce::String stuckFile;
+        bool timedOut = false;
+
+        {
+            const juce::ScopedLock sl (slot.lock);
+            slot.process = nullptr;
+            stuckFile = slot.currentFile;
+            timedOut = slot.timedOut;
+        }
+
+        if (stuckFile.isNotEmpty() && ! (job.stop && ! timedOut))
+        {
+            remaining.removeString (stuckFile);
+
+            Result result;
+            result.fileOrIdentifier = stuckFile;
+            result.outcome = timedOut ? Result::Outcome::timedOut : Result::Outcome::crashed;
+            job.report (result);
+        }
+        else if (numBegun == 0 && ! job.stop)
+        {
+            // Exited (or hung) before touching a plugin: the worker itself is broken
+            job.requeue (remaining);
+            job.workerUnusable = true;
+            job.stop = true;
+            break;
+        }
+
+        // Whatever the worker didn't get to goes to the next one
+        if (! remaining.isEmpty())
+            job.requeue (remaining);
+    }
+}
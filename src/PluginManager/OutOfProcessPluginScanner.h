@@ -0,0 +1,78 @@
+#pragma once
+
+#include "PluginScanWorker.h"
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief Scans plugins in child worker processes, with a per-plugin timeout.
+ *
+ * A plugin that hangs or crashes while being instantiated only takes down its
+ * worker, never the app. Architecture:
+ *  - Files are handed out in small batches to up to Options::numWorkers
+ *    concurrent workers (each a PluginScanWorker child process).
+ *  - Workers stream `begin`/`result` lines back over their stdout pipe, so
+ *    results arrive as each plugin finishes.
+ *  - The calling thread watches every worker; one stuck on a plugin for longer
+ *    than Options::timeoutMs is killed and that plugin reported as timedOut.
+ *  - A worker that dies mid-plugin reports it as crashed. Either way the rest
+ *    of its batch is re-queued for a fresh worker.
+ *
+ * Usage:
+ *  - Call scan() from a background thread; it blocks until every file has a
+ *    result, shouldExit returns true, or the worker can't be launched.
+ */
+class OutOfProcessPluginScanner
+{
+public:
+    //==============================================================================
+    struct Options
+    {
+        juce::StringArray workerCommand;   ///< Executable (plus any leading args) that understands PluginScanWorker's switch.
+        int numWorkers = juce::SystemStats::getNumCpus();
+        int timeoutMs = 30000;             ///< Per plugin.
+        int batchSize = 8;                 ///< Files per worker process.
+    };
+
+    /** Result for one plugin file / identifier. */
+    struct Result
+    {
+        enum class Outcome { ok, failed, timedOut, crashed };
+
+        juce::String fileOrIdentifier;
+        juce::Array<juce::PluginDescription> types;
+        Outcome outcome = Outcome::failed;
+
+        /** True if the plugin took its worker down and should be blacklisted. */
+        bool shouldBlacklist() const noexcept { return outcome == Outcome::timedOut || outcome == Outcome::crashed; }
+    };
+
+    /** Called once per file, from a worker thread (calls are serialised). */
+    using ResultCallback = std::function<void (const Result&)>;
+
+    explicit OutOfProcessPluginScanner (Options options);
+
+    //==============================================================================
+    /**
+     * @brief Scans @p files of the named format. Blocks until finished.
+     *
+     * @return false if no worker could be started (or a worker exited without
+     *         scanning anything); files without a result should then be scanned
+     *         some other way.
+     */
+    bool scan (const juce::String& formatName,
+               const juce::StringArray& files,
+               const ResultCallback& onResult,
+               const std::function<bool()>& shouldExit = {});
+
+private:
+    //==============================================================================
+    struct Job;
+    struct Slot;
+
+    void runSlot (Job&, Slot&);
+
+    Options options;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
@@ -17,7 +17,8 @@ namespace
 // Construction
 
 PluginManager::PluginManager (te::Edit& e, const Settings& s)
-    : edit (e), settings (s)
+    : edit (e), settings (s),
+      scanCache (ensureDir (s.appDataDir).getChildFile ("PluginScanCache.xml"))
 {
     auto base = ensureDir (settings.appDataDir);
     knownListFile = base.getChildFile ("KnownPlugins.xml");
@@ -28,6 +29,12 @@ PluginManager::PluginManager (te::Edit& e, const Settings& s)
     loadKnownListFromDisk();
 }
 
+PluginManager::~PluginManager()
+{
+    cancelScan = true;
+    scanPool.removeAllJobs (true, 30000);
+}
+
 //==============================================================================
 // Format initialisation
 
@@ -59,9 +66,12 @@ void PluginManager::saveKnownListToDisk() const
 
 void PluginManager::loadKnownListFromDisk()
 {
-    if (knownListFile.existsAsFile())
+    if (! scanCache.load() && knownListFile.existsAsFile())
+    {
+        // No cache yet: start from the last known list (it gets re-keyed by the next scan)
         if (auto xml = juce::XmlDocument::parse (knownListFile))
             knownPlugins.recreateFromXml (*xml);
+    }
 
     if (blacklistFile.existsAsFile())
     {
@@ -71,6 +81,23 @@ void PluginManager::loadKnownListFromDisk()
         for (auto& s : lines)
             knownPlugins.addToBlacklist (s);
     }
+
+    // A plugin still named here crashed the app while it was being scanned
+    juce::PluginDirectoryScanner::applyBlacklistingsFromDeadMansPedal (knownPlugins, deadMansFile);
+    deadMansFile.deleteFile();
+
+    populateFromCache();
+}
+
+void PluginManager::populateFromCache()
+{
+    for (const auto& desc : scanCache.getAllTypes())
+    {
+        knownPlugins.addType (desc);
+
+        if (settings.mirrorList != nullptr)
+            settings.mirrorList->addType (desc);
+    }
 }
 
 //==============================================================================
@@ -111,115 +138,99 @@ juce::FileSearchPath PluginManager::buildSearchPaths() const
 }
 
 //==============================================================================
-// Scanning control
+// Scanning
 
-void PluginManager::startNextFormatScan (bool reset)
+void PluginManager::runIncrementalScan (const juce::StringArray& blacklisted,
+                                        const PluginScanCache::FoundCallback& onFound,
+                                        const std::function<void (const juce::String&)>& onBlacklist,
+                                        const std::function<void (const juce::String&)>& onRemoved)
 {
-    juce::ignoreUnused (reset);
+    const auto searchPaths = buildSearchPaths();
+    const auto shouldExit = [this] { return cancelScan.load(); };
 
-    if (currentFormatIndex >= formatManager.getNumFormats())
+    for (int i = 0; i < formatManager.getNumFormats() && ! cancelScan; ++i)
     {
-        scanner.reset();
-        saveKnownListToDisk();
-        stopTimer();
-        return;
-    }
+        auto* format = formatManager.getFormat (i);
+        PluginScanCache::ScanStats stats;
+        bool scannedOutOfProcess = false;
 
-    auto* format = formatManager.getFormat (currentFormatIndex++);
+        if (! settings.scanWorkerCommand.isEmpty())
+        {
+            const auto toScan = scanCache.findFilesToScan (*format, searchPaths, blacklisted, stats);
 
-    scanner = std::make_unique<juce::PluginDirectoryScanner> (
-        knownPlugins,
-        *format,
-        buildSearchPaths(),
-        /* searchRecursively */ true,
-        deadMansFile,
-        /* allowAsyncInstantiation */ true);
+            OutOfProcessPluginScanner::Options options;
+            options.workerCommand = settings.scanWorkerCommand;
+            options.timeoutMs = settings.scanTimeoutMs;
 
-    startTimerHz (30); // Pump scanner in timerCallback.
-}
+            OutOfProcessPluginScanner scanner (options);
 
-void PluginManager::startScanner (bool reset)
-{
-    currentFormatIndex = 0;
-    startNextFormatScan (reset);
+            scannedOutOfProcess = scanner.scan (format->getName(), toScan,
+                                                [&] (const OutOfProcessPluginScanner::Result& result)
+            {
+                const auto entry = scanCache.storeResult (format->getName(), result.fileOrIdentifier, result.types);
+                ++stats.scanned;
 
-    if (scanner != nullptr)
-        return;
+                if (result.shouldBlacklist())
+                {
+                    DBG ("[PluginManager] Blacklisting " << result.fileOrIdentifier
+                         << (result.outcome == OutOfProcessPluginScanner::Result::Outcome::timedOut ? " (timed out)" : " (crashed)"));
+                    onBlacklist (result.fileOrIdentifier);
+                }
 
-    // Fallback path: only executes if startNextFormatScan did not create a scanner.
-    auto searchPaths = buildSearchPaths();
+                onFound (entry);
+            }, shouldExit);
 
-    if (! scannerThread)
-        scannerThread = std::make_unique<juce::TimeSliceThread> ("PluginScanThread");
+            if (! scannedOutOfProcess)
+                DBG ("[PluginManager] Scan worker unavailable, scanning " << format->getName() << " in-process");
+        }
 
-    if (! scannerThread->isThreadRunning())
-        scannerThread->startThread();
+        // In-process pass: picks up whatever the workers didn't get to
+        if (! scannedOutOfProcess)
+        {
+            const auto inProcess = scanCache.scan (*format, searchPaths, blacklisted, deadMansFile, shouldExit, onFound);
+            stats.scanned += inProcess.scanned;
+            stats.removed += inProcess.removed;
+            stats.removedFiles.addArray (inProcess.removedFiles);
 
-    if (formatManager.getNumFormats() > 0)
-    {
-        auto* format = formatManager.getFormat (0);
+            if (settings.scanWorkerCommand.isEmpty())
+                stats.skipped = inProcess.skipped;
+        }
 
-        scanner = std::make_unique<juce::PluginDirectoryScanner> (
-            knownPlugins,
-            *format,
-            searchPaths,
-            /* searchRecursively */ true,
-            /* deadMansPedalFile */ deadMansFile,
-            /* allowAsyncInstantiation */ true);
+        for (const auto& fileOrIdentifier : stats.removedFiles)
+            onRemoved (fileOrIdentifier);
 
-        startTimerHz (30);
+        DBG ("[PluginManager] " << format->getName() << ": scanned " << stats.scanned
+             << ", unchanged " << stats.skipped << ", removed " << stats.removed);
     }
+
+    scanCache.save();
 }
 
-void PluginManager::timerCallback()
+void PluginManager::applyScanResult (const PluginScanCache::Entry& entry)
 {
-    if (! scanner)
-    {
-        stopTimer();
-        return;
-    }
+    // A changed plugin may have dropped or renamed types; replace rather than merge
+    removeTypesForFile (entry.fileOrIdentifier);
 
-    juce::String discovered;
-    int pumped = 0;
-    constexpr int maxPerTick = 8;
-
-    // Pump a limited number of files per timer tick to keep the UI responsive.
-    while (pumped++ < maxPerTick && scanner->scanNextFile (true, discovered))
-    {
-        // `discovered` is intentionally unused here; we only care about
-        // progressing the scanner.
-    }
-
-    // Check if scanning is finished (using a non-advancing call).
-    if (! scanner->scanNextFile (false, discovered))
-    {
-        stopTimer();
-        scanner.reset();
-
-        startNextFormatScan (/* reset */ false);
-        saveKnownListToDisk();
-    }
+    for (auto* list : { &knownPlugins, settings.mirrorList })
+        if (list != nullptr)
+            for (const auto& desc : entry.types)
+                list->addType (desc);
 }
 
-void PluginManager::pumpScannerUntilDone (juce::String progressPrefix)
+void PluginManager::removeTypesForFile (const juce::String& fileOrIdentifier)
 {
-    juce::ignoreUnused (progressPrefix);
-    jassert (scanner != nullptr);
-
-    juce::String pluginName;
-
-    // Simple loop for blocking mode; async callers should not use this.
-    while (scanner && scanner->scanNextFile (true, pluginName))
-    {
-        // `pluginName` and `progressPrefix` could be used for logging or
-        // progress reporting if needed.
-    }
+    for (auto* list : { &knownPlugins, settings.mirrorList })
+        if (list != nullptr)
+            for (const auto& old : list->getTypes())
+                if (old.fileOrIdentifier == fileOrIdentifier)
+                    list->removeType (old);
+}
 
-    if (scanner)
-    {
-        scanner.reset();
-        saveKnownListToDisk();
-    }
+void PluginManager::addToBlacklist (const juce::String& fileOrIdentifier)
+{
+    for (auto* list : { &knownPlugins, settings.mirrorList })
+        if (list != nullptr)
+            list->addToBlacklist (fileOrIdentifier);
 }
 
 //==============================================================================
@@ -227,31 +238,84 @@ void PluginManager::pumpScannerUntilDone (juce::String progressPrefix)
 
 void PluginManager::scanForPluginsAsync()
 {
-    startScanner (/* reset */ false);
-}
+    if (scanRunning.exchange (true))
+        return;
 
-void PluginManager::scanForPluginsBlocking()
-{
-    auto searchPaths = buildSearchPaths();
+    cancelScan = false;
 
-    for (int i = 0; i < formatManager.getNumFormats(); ++i)
+    // Anything a cancelled scan still has queued on the message thread is ignored once a new one starts
+    const auto generation = ++scanGeneration;
+    const auto isCurrent = [safeThis = juce::WeakReference<PluginManager> (this), generation]
     {
-        auto* format = formatManager.getFormat (i);
-        juce::String discovered;
+        return safeThis != nullptr && safeThis->scanGeneration == generation;
+    };
 
-        juce::PluginDirectoryScanner scannerInstance (
-            knownPlugins,
-            *format,
-            searchPaths,
-            /* searchRecursively */ true,
-            /* deadMansPedalFile */ deadMansFile,
-            /* allowAsyncInstantiation */ true);
-
-        while (scannerInstance.scanNextFile (true, discovered))
+    scanPool.addJob ([this, blacklisted = knownPlugins.getBlacklistedFiles(), isCurrent]
+    {
+        runIncrementalScan (blacklisted,
+                            [this, isCurrent] (const PluginScanCache::Entry& entry)
+                            {
+                                juce::MessageManager::callAsync ([this, isCurrent, entry]
+                                {
+                                    if (isCurrent())
+                                        applyScanResult (entry);
+                                });
+                            },
+                            [this, isCurrent] (const juce::String& fileOrIdentifier)
+                            {
+                                juce::MessageManager::callAsync ([this, isCurrent, fileOrIdentifier]
+                                {
+                                    if (isCurrent())
+                                        addToBlacklist (fileOrIdentifier);
+                                });
+                            },
+                            [this, isCurrent] (const juce::String& fileOrIdentifier)
+                            {
+                                juce::MessageManager::callAsync ([this, isCurrent, fileOrIdentifier]
+                                {
+                                    if (isCurrent())
+                                        removeTypesForFile (fileOrIdentifier);
+                                });
+                            });
+
+        juce::MessageManager::callAsync ([this, isCurrent]
         {
-            // `discovered` could be used here for progress reporting.
-        }
-    }
+            if (! isCurrent())
+                return;
+
+            scanRunning = false;
+            saveKnownListToDisk();
+
+            if (onScanFinished)
+                onScanFinished();
+        });
+    });
+}
+
+void PluginManager::scanForPluginsBlocking()
+{
+    // Let a background scan finish first; both write the same cache
+    scanPool.removeAllJobs (false, -1);
+
+    // Callbacks may come from worker threads; nothing else touches the lists meanwhile
+    const juce::CriticalSection listLock;
+
+    runIncrementalScan (knownPlugins.getBlacklistedFiles(),
+                        [this, &listLock] (const PluginScanCache::Entry& entry)
+                        {
+                            const juce::ScopedLock sl (listLock);
+                            applyScanResult (entry);
+                        },
+                        [this, &listLock] (const juce::String& fileOrIdentifier)
+                        {
+                            const juce::ScopedLock sl (listLock);
+                            addToBlacklist (fileOrIdentifier);
+                        },
+                        [this, &listLock] (const juce::String& fileOrIdentifier)
+                        {
+                            const juce::ScopedLock sl (listLock);
+                            removeTypesForFile (fileOrIdentifier);
+                        });
 
     saveKnownListToDisk();
 }
@@ -264,7 +328,18 @@ void PluginManager::rescanAsync (bool clearBlacklistFirst)
         blacklistFile.deleteFile();
     }
 
-    startScanner (/* reset */ true);
+    cancelScan = true;
+    scanPool.removeAllJobs (false, -1);
+    scanRunning = false;
+
+    // Without the cache nothing can tell which plugins were deleted, so the known list is rebuilt too
+    scanCache.clear();
+
+    for (auto* list : { &knownPlugins, settings.mirrorList })
+        if (list != nullptr)
+            list->clear();
+
+    scanForPluginsAsync();
 }
 
 //==============================================================================
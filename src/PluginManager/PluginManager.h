@@ -1,6 +1,9 @@
 #pragma once
 
+#include "OutOfProcessPluginScanner.h"
+#include "PluginScanCache.h"
 #include <tracktion_engine/tracktion_engine.h>
+#include <atomic>
 
 namespace te = tracktion::engine;
 
@@ -9,12 +12,19 @@ namespace te = tracktion::engine;
  *
  * PluginManager wraps Tracktion Engine's plugin scanning and known-list
  * functionality for a given Edit. It:
- *  - Scans AU/VST3 (depending on settings and platform).
- *  - Persists the known-plugin list, blacklist, and dead-man's file.
+ *  - Scans AU/VST3 (depending on settings and platform) on a background thread,
+ *    incrementally: a PluginScanCache keyed by path + modification time means
+ *    only new or changed plugins are instantiated.
+ *  - With Settings::scanWorkerCommand set, instantiates them in parallel child
+ *    processes (OutOfProcessPluginScanner); plugins that hang or crash a worker
+ *    are blacklisted instead of stalling the app.
+ *  - Fills its own known list, and optionally a mirror list (Tracktion's
+ *    knownPluginList), straight from the cache at startup - no scan needed.
+ *  - Persists the scan cache, known-plugin list, blacklist, and dead-man's file.
  *  - Provides helpers for inserting external instrument/effect plugins
  *    onto AudioTracks.
  */
-class PluginManager : private juce::Timer
+class PluginManager
 {
 public:
     //==============================================================================
@@ -29,6 +39,9 @@ public:
         juce::File appDataDir; ///< Directory where known plugins, blacklist, etc. are stored.
         bool scanAudioUnits = true; ///< Whether to scan AudioUnit plugins (macOS only).
         bool scanVST3       = true; ///< Whether to scan VST3 plugins.
+        juce::KnownPluginList* mirrorList = nullptr; ///< Also kept in sync with scan results (e.g. Tracktion's list).
+        juce::StringArray scanWorkerCommand; ///< Worker executable for out-of-process scans; empty scans in-process.
+        int scanTimeoutMs = 30000;           ///< Per-plugin limit for out-of-process scans before blacklisting.
     };
 
     //==============================================================================
@@ -45,20 +58,24 @@ public:
      */
     explicit PluginManager (te::Edit& edit, const Settings& settings);
 
+    /** Stops a running scan (waiting for the plugin currently being scanned). */
+    ~PluginManager();
+
     //==============================================================================
     // Scanning API
 
     /**
-     * @brief Starts an asynchronous plugin scan using the current settings.
+     * @brief Starts an incremental plugin scan on a background thread.
      *
-     * Use isScanRunning() to check progress. When scanning completes, the
-     * known-plugin list and blacklist will be written to disk automatically
-     * (or you can call saveKnownListToDisk() explicitly).
+     * Unchanged plugins are skipped; new or changed ones are added to the known
+     * list(s) on the message thread as they are found. Use isScanRunning() to
+     * check progress. When scanning completes, the scan cache, known-plugin list
+     * and blacklist are written to disk automatically.
      */
     void scanForPluginsAsync();
 
     /**
-     * @brief Performs a blocking scan over all supported plugin formats.
+     * @brief Performs a blocking incremental scan over all supported plugin formats.
      *
      * This call does not return until the scan has completed. On completion,
      * the known-plugin list and blacklist are written to disk.
@@ -66,25 +83,33 @@ public:
     void scanForPluginsBlocking();
 
     /**
-     * @brief Starts an asynchronous rescan of plugins.
+     * @brief Starts an asynchronous full rescan (the scan cache is discarded).
+     *
+     * Cancels a scan in progress. The known list(s) are emptied and filled again
+     * as plugins are found, so deleted plugins drop out.
      *
      * @param clearBlacklistFirst  If true, clears the blacklist in memory and
      *                             deletes the on-disk blacklist file before scanning.
      */
     void rescanAsync (bool clearBlacklistFirst = false);
 
+    /** Called on the message thread when an asynchronous scan finishes. */
+    std::function<void()> onScanFinished;
+
     //==============================================================================
     // State inspection / persistence
 
     /** @brief Returns true while an asynchronous scan is in progress. */
-    bool isScanRunning() const noexcept                 { return scanner != nullptr; }
+    bool isScanRunning() const noexcept                 { return scanRunning.load(); }
 
     /** @brief Returns the current known plugin list. */
     const juce::KnownPluginList& getKnownList() const noexcept { return knownPlugins; }
 
     /**
-     * @brief Loads the known-plugin list and blacklist from disk if present.
+     * @brief Loads the scan cache and blacklist from disk if present.
      *
+     * Fills the known list (and mirror list) from the cache. Plugins recorded in
+     * the dead-man's file (i.e. that crashed a previous scan) are blacklisted.
      * Normally called during construction. Safe to call again to re-sync
      * from disk.
      */
@@ -164,34 +189,31 @@ private:
     juce::FileSearchPath buildSearchPaths() const;
 
     /**
-     * @brief Starts the scanner over all formats.
+     * @brief Scans every format through the cache (calling thread).
      *
-     * @param reset Whether to reset scanning state (e.g. when rescanning).
-     */
-    void startScanner (bool reset);
-
-    /**
-     * @brief Starts scanning the next plugin format in the manager.
-     *
-     * Called internally when a format scan completes.
+     * Uses worker processes if configured, falling back to scanning in-process
+     * if they can't be launched.
      *
-     * @param reset Whether this is part of a reset/rescan operation.
+     * @param onFound       Called for each new or changed plugin (any thread).
+     * @param onBlacklist   Called for each plugin that hung or crashed a worker (any thread).
+     * @param onRemoved     Called for each cached plugin that is no longer on disk (any thread).
      */
-    void startNextFormatScan (bool reset);
+    void runIncrementalScan (const juce::StringArray& blacklisted,
+                             const PluginScanCache::FoundCallback& onFound,
+                             const std::function<void (const juce::String&)>& onBlacklist,
+                             const std::function<void (const juce::String&)>& onRemoved);
 
-    /**
-     * @brief Timer callback used to pump the PluginDirectoryScanner asynchronously.
-     */
-    void timerCallback() override;
+    /** Adds @p fileOrIdentifier to the blacklist of the known list(s) (message thread). */
+    void addToBlacklist (const juce::String& fileOrIdentifier);
 
-    /**
-     * @brief Pumps the scanner in a blocking loop until completion.
-     *
-     * Intended for blocking scan paths; async callers should not use this.
-     *
-     * @param progressPrefix Optional string to prefix any logging/progress output.
-     */
-    void pumpScannerUntilDone (juce::String progressPrefix);
+    /** Replaces any types from @p entry's file in the known list(s) with its new types (message thread). */
+    void applyScanResult (const PluginScanCache::Entry& entry);
+
+    /** Removes every type from @p fileOrIdentifier from the known list(s) (message thread). */
+    void removeTypesForFile (const juce::String& fileOrIdentifier);
+
+    /** Adds every cached type to the known list(s) (message thread). */
+    void populateFromCache();
 
     //==============================================================================
     // Member variables
@@ -202,12 +224,15 @@ private:
     juce::AudioPluginFormatManager        formatManager; ///< Registered plugin formats.
     juce::KnownPluginList                 knownPlugins;  ///< In-memory known plugin list.
 
-    std::unique_ptr<juce::TimeSliceThread>        scannerThread;  ///< Thread used for async scanning.
-    std::unique_ptr<juce::PluginDirectoryScanner> scanner;        ///< Active directory scanner.
-
     juce::File knownListFile;   ///< XML file storing the known-plugin list.
     juce::File blacklistFile;   ///< Text file storing blacklisted plugin paths.
-    juce::File deadMansFile;    ///< Dead-man's file used by JUCE during scanning.
+    juce::File deadMansFile;    ///< Holds the plugin being scanned (blacklisted on next launch if it crashed).
+
+    PluginScanCache scanCache;                 ///< Per-file scan results keyed by path + modification time.
+    juce::ThreadPool scanPool { 1 };           ///< Background scan thread.
+    std::atomic<bool> scanRunning { false };
+    std::atomic<bool> cancelScan { false };
+    int scanGeneration = 0;                    ///< Bumped per async scan; results of an older one are dropped (message thread).
 
-    int currentFormatIndex = -1; ///< Index of the format currently being scanned.
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PluginManager)
 };
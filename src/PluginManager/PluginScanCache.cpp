@@ -0,0 +1,258 @@
+#include "PluginScanCache.h"
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    const juce::Identifier cacheTag      ("PLUGINSCANCACHE");
+    const juce::Identifier entryTag      ("ENTRY");
+    const juce::Identifier versionAttr   ("version");
+    const juce::Identifier formatAttr    ("format");
+    const juce::Identifier fileAttr      ("file");
+    const juce::Identifier modTimeAttr   ("modTime");
+    const juce::Identifier failedAttr    ("failed");
+
+    juce::int64 newest (juce::int64 t, const juce::File& f)
+    {
+        return juce::jmax (t, f.getLastModificationTime().toMilliseconds());
+    }
+}
+
+//==============================================================================
+// Construction / persistence
+
+PluginScanCache::PluginScanCache (const juce::File& cacheFile)
+    : file (cacheFile)
+{
+}
+
+bool PluginScanCache::load()
+{
+    auto xml = juce::XmlDocument::parse (file);
+
+    const juce::ScopedLock sl (lock);
+    entries.clear();
+
+    if (xml == nullptr || ! xml->hasTagName (cacheTag.toString())
+        || xml->getIntAttribute (versionAttr.toString()) != formatVersion)
+        return false;
+
+    for (auto* e : xml->getChildWithTagNameIterator (entryTag.toString()))
+    {
+        Entry entry;
+        entry.formatName       = e->getStringAttribute (formatAttr.toString());
+        entry.fileOrIdentifier = e->getStringAttribute (fileAttr.toString());
+        entry.modificationTime = e->getStringAttribute (modTimeAttr.toString()).getLargeIntValue();
+        entry.failed           = e->getBoolAttribute (failedAttr.toString());
+
+        for (auto* p : e->getChildIterator())
+        {
+            juce::PluginDescription desc;
+            if (desc.loadFromXml (*p))
+                entry.types.add (desc);
+        }
+
+        entries[makeKey (entry.formatName, entry.fileOrIdentifier)] = std::move (entry);
+    }
+
+    return true;
+}
+
+bool PluginScanCache::save() const
+{
+    juce::XmlElement xml (cacheTag.toString());
+    xml.setAttribute (versionAttr.toString(), formatVersion);
+
+    {
+        const juce::ScopedLock sl (lock);
+
+        for (const auto& [key, entry] : entries)
+        {
+            auto* e = xml.createNewChildElement (entryTag.toString());
+            e->setAttribute (formatAttr.toString(), entry.formatName);
+            e->setAttribute (fileAttr.toString(), entry.fileOrIdentifier);
+            e->setAttribute (modTimeAttr.toString(), juce::String (entry.modificationTime));
+            e->setAttribute (failedAttr.toString(), entry.failed);
+
+            for (const auto& desc : entry.types)
+                e->addChildElement (desc.createXml().release());
+        }
+    }
+
+    file.getParentDirectory().createDirectory();
+    return xml.writeTo (file);
+}
+
+void PluginScanCache::clear()
+{
+    const juce::ScopedLock sl (lock);
+    entries.clear();
+}
+
+int PluginScanCache::getNumEntries() const
+{
+    const juce::ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+// Queries
+
+juce::String PluginScanCache::makeKey (const juce::String& formatName, const juce::String& fileOrIdentifier)
+{
+    return formatName + "|" + fileOrIdentifier;
+}
+
+juce::int64 PluginScanCache::getModificationTime (const juce::String& fileOrIdentifier)
+{
+    if (! juce::File::isAbsolutePath (fileOrIdentifier))
+        return 0;
+
+    const juce::File f (fileOrIdentifier);
+    if (! f.exists())
+        return 0;
+
+    auto t = newest (0, f);
+
+    // Bundle: the top-level folder's time doesn't change when the binary inside is replaced
+    if (f.isDirectory())
+    {
+        const auto contents = f.getChildFile ("Contents");
+        t = newest (t, contents);
+
+        for (const auto& archDir : contents.findChildFiles (juce::File::findDirectories, false))
+            for (const auto& binary : archDir.findChildFiles (juce::File::findFiles, false))
+                t = newest (t, binary);
+    }
+
+    return t;
+}
+
+bool PluginScanCache::isUpToDate (const juce::String& formatName, const juce::String& fileOrIdentifier) const
+{
+    const auto modTime = getModificationTime (fileOrIdentifier);
+
+    const juce::ScopedLock sl (lock);
+    auto it = entries.find (makeKey (formatName, fileOrIdentifier));
+
+    return it != entries.end() && it->second.modificationTime == modTime;
+}
+
+juce::Array<juce::PluginDescription> PluginScanCache::getAllTypes() const
+{
+    juce::Array<juce::PluginDescription> types;
+
+    const juce::ScopedLock sl (lock);
+    for (const auto& [key, entry] : entries)
+        types.addArray (entry.types);
+
+    return types;
+}
+
+void PluginScanCache::store (const Entry& entry)
+{
+    const juce::ScopedLock sl (lock);
+    entries[makeKey (entry.formatName, entry.fileOrIdentifier)] = entry;
+}
+
+//==============================================================================
+// Scanning
+
+juce::StringArray PluginScanCache::findFilesToScan (juce::AudioPluginFormat& format,
+                                                   const juce::FileSearchPath& searchPath,
+                                                   const juce::StringArray& skip,
+                                                   ScanStats& stats)
+{
+    const auto formatName = format.getName();
+
+    // Cheap directory walk; nothing is instantiated here
+    const auto found = format.searchPathsForPlugins (searchPath, true, true);
+
+    // Forget plugins that were removed from disk
+    {
+        const juce::ScopedLock sl (lock);
+
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (it->second.formatName == formatName && ! found.contains (it->second.fileOrIdentifier))
+            {
+                stats.removedFiles.add (it->second.fileOrIdentifier);
+                it = entries.erase (it);
+                ++stats.removed;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    juce::StringArray toScan;
+
+    for (const auto& fileOrId : found)
+    {
+        if (skip.contains (fileOrId))
+            continue;
+
+        if (isUpToDate (formatName, fileOrId))
+            ++stats.skipped;
+        else
+            toScan.add (fileOrId);
+    }
+
+    return toScan;
+}
+
+PluginScanCache::Entry PluginScanCache::storeResult (const juce::String& formatName,
+                                                     const juce::String& fileOrIdentifier,
+                                                     const juce::Array<juce::PluginDescription>& types)
+{
+    Entry entry;
+    entry.formatName = formatName;
+    entry.fileOrIdentifier = fileOrIdentifier;
+    entry.modificationTime = getModificationTime (fileOrIdentifier);
+    entry.types = types;
+    entry.failed = types.isEmpty();
+
+    store (entry);
+    return entry;
+}
+
+PluginScanCache::ScanStats PluginScanCache::scan (juce::AudioPluginFormat& format,
+                                                  const juce::FileSearchPath& searchPath,
+                                                  const juce::StringArray& skip,
+                                                  const juce::File& deadMansFile,
+                                                  const std::function<bool()>& shouldExit,
+                                                  const FoundCallback& onFound)
+{
+    ScanStats stats;
+
+    for (const auto& fileOrId : findFilesToScan (format, searchPath, skip, stats))
+    {
+        if (shouldExit && shouldExit())
+            break;
+
+        // Dead-man's pedal: if this crashes the app, the next launch blacklists it
+        if (deadMansFile != juce::File())
+            deadMansFile.replaceWithText (fileOrId);
+
+        juce::OwnedArray<juce::PluginDescription> found;
+        format.findAllTypesForFile (found, fileOrId);
+
+        if (deadMansFile != juce::File())
+            deadMansFile.deleteFile();
+
+        juce::Array<juce::PluginDescription> types;
+        for (auto* t : found)
+            types.add (*t);
+
+        const auto entry = storeResult (format.getName(), fileOrId, types);
+        ++stats.scanned;
+
+        if (onFound)
+            onFound (entry);
+    }
+
+    return stats;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <functional>
+#include <map>
+
+/**
+ * @brief Persistent, incremental plugin scan database.
+ *
+ * Stores the scan result for every plugin file (or identifier) keyed by
+ * format + path and the file's modification time. A scan only instantiates
+ * plugins that are new or have changed since they were last scanned; unchanged
+ * ones are answered from the cache, and files that disappeared are dropped.
+ *
+ * Plugins that failed to scan are remembered too (with no types), so a broken
+ * plugin is not retried on every launch - only once its file changes.
+ *
+ * Thread-safety: all methods lock internally, so a background scan can run
+ * while the message thread reads results.
+ */
+class PluginScanCache
+{
+public:
+    //==============================================================================
+    /** Scan result for one plugin file / identifier. */
+    struct Entry
+    {
+        juce::String formatName;
+        juce::String fileOrIdentifier;
+        juce::int64 modificationTime = 0;               ///< 0 for identifiers that aren't files.
+        juce::Array<juce::PluginDescription> types;     ///< Empty if the scan failed.
+        bool failed = false;
+    };
+
+    /** Counts from one call to scan(). */
+    struct ScanStats
+    {
+        int scanned = 0;    ///< New or changed files that were instantiated.
+        int skipped = 0;    ///< Unchanged files answered from the cache.
+        int removed = 0;    ///< Cached files that no longer exist.
+        juce::StringArray removedFiles;   ///< Those files, so their types can be dropped from a known list.
+    };
+
+    using FoundCallback = std::function<void (const Entry&)>;
+
+    //==============================================================================
+    // Construction / persistence
+
+    explicit PluginScanCache (const juce::File& cacheFile);
+
+    /** Replaces the in-memory cache with the file's contents. */
+    bool load();
+
+    /** Writes the cache to disk (atomically). */
+    bool save() const;
+
+    void clear();
+
+    int getNumEntries() const;
+
+    //==============================================================================
+    // Queries
+
+    /**
+     * @brief Modification time used as the cache key for @p fileOrIdentifier.
+     *
+     * For bundles (directories) this is the newest time among the bundle, its
+     * Contents folder and the binaries directly below it, so replacing the
+     * plugin binary invalidates the entry. Returns 0 for non-file identifiers.
+     */
+    static juce::int64 getModificationTime (const juce::String& fileOrIdentifier);
+
+    /** Returns true if @p fileOrIdentifier was scanned and hasn't changed since. */
+    bool isUpToDate (const juce::String& formatName, const juce::String& fileOrIdentifier) const;
+
+    /** Every plugin type currently in the cache. */
+    juce::Array<juce::PluginDescription> getAllTypes() const;
+
+    void store (const Entry& entry);
+
+    /** Stores the scan result for @p fileOrIdentifier (failed if @p types is empty) and returns it. */
+    Entry storeResult (const juce::String& formatName,
+                       const juce::String& fileOrIdentifier,
+                       const juce::Array<juce::PluginDescription>& types);
+
+    //==============================================================================
+    // Scanning
+
+    /**
+     * @brief Lists the files under @p searchPath that are new or changed.
+     *
+     * Drops cached files that no longer exist (listing them in @p stats) and
+     * counts the unchanged ones. Nothing is instantiated, so this is cheap; the caller scans
+     * the returned files (in or out of process) and hands them to storeResult().
+     */
+    juce::StringArray findFilesToScan (juce::AudioPluginFormat& format,
+                                       const juce::FileSearchPath& searchPath,
+                                       const juce::StringArray& skip,
+                                       ScanStats& stats);
+
+    /**
+     * @brief Incrementally scans @p searchPath for plugins of @p format.
+     *
+     * Runs on the calling thread (normally a background thread). New or changed
+     * files are instantiated via AudioPluginFormat::findAllTypesForFile and
+     * reported through @p onFound; removed ones are dropped from the cache.
+     *
+     * @param skip           Files not to scan (e.g. the blacklist).
+     * @param deadMansFile   Holds the file being scanned, so a crash can be blacklisted next launch.
+     * @param shouldExit     Polled between files (optional).
+     */
+    ScanStats scan (juce::AudioPluginFormat& format,
+                    const juce::FileSearchPath& searchPath,
+                    const juce::StringArray& skip,
+                    const juce::File& deadMansFile,
+                    const std::function<bool()>& shouldExit = {},
+                    const FoundCallback& onFound = {});
+
+private:
+    //==============================================================================
+    static juce::String makeKey (const juce::String& formatName, const juce::String& fileOrIdentifier);
+
+    juce::File file;
+    std::map<juce::String, Entry> entries;   ///< Keyed by makeKey().
+    juce::CriticalSection lock;
+
+    static constexpr int formatVersion = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
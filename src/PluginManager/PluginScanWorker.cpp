@@ -0,0 +1,155 @@
+#include "PluginScanWorker.h"
+#include <iostream>
+
+//==============================================================================
+// Local helpers
+
+namespace
+{
+    // Plugins may print to stdout themselves; our lines carry a marker so they
+    // can be found even if a plugin left a partial line in front of them.
+    const juce::String marker ("@gkscan:");
+    const juce::String beginTag ("begin");
+    const juce::String resultTag ("result");
+
+    const juce::Identifier jobTag     ("PLUGINSCANJOB");
+    const juce::Identifier fileTag    ("FILE");
+    const juce::Identifier formatAttr ("format");
+    const juce::Identifier pathAttr   ("path");
+    const juce::Identifier typesTag   ("TYPES");
+}
+
+//==============================================================================
+// Worker (child process)
+
+bool PluginScanWorker::isWorkerCommandLine (const juce::StringArray& args)
+{
+    return args.contains (commandLineSwitch);
+}
+
+int PluginScanWorker::runFromCommandLine (const juce::StringArray& args, juce::AudioPluginFormatManager& formats)
+{
+    const auto index = args.indexOf (commandLineSwitch);
+    if (index < 0 || index + 1 >= args.size())
+        return 1;
+
+    juce::String formatName;
+    juce::StringArray files;
+
+    if (! readJobFile (juce::File (args[index + 1].unquoted()), formatName, files))
+        return 1;
+
+    for (int i = 0; i < formats.getNumFormats(); ++i)
+    {
+        if (auto* format = formats.getFormat (i); format->getName() == formatName)
+        {
+            scanFiles (*format, files, [] (const juce::String& line)
+            {
+                std::cout << line << std::endl;   // endl flushes: the parent reads as we go
+            });
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void PluginScanWorker::scanFiles (juce::AudioPluginFormat& format,
+                                  const juce::StringArray& files,
+                                  const std::function<void (const juce::String&)>& writeLine)
+{
+    for (const auto& fileOrId : files)
+    {
+        writeLine (createBeginLine (fileOrId));
+
+        juce::OwnedArray<juce::PluginDescription> types;
+        format.findAllTypesForFile (types, fileOrId);
+
+        writeLine (createResultLine (fileOrId, types));
+    }
+}
+
+//==============================================================================
+// Protocol
+
+bool PluginScanWorker::writeJobFile (const juce::File& jobFile, const juce::String& formatName, const juce::StringArray& files)
+{
+    juce::XmlElement xml (jobTag.toString());
+    xml.setAttribute (formatAttr.toString(), formatName);
+
+    for (const auto& f : files)
+        xml.createNewChildElement (fileTag.toString())->setAttribute (pathAttr.toString(), f);
+
+    return xml.writeTo (jobFile);
+}
+
+bool PluginScanWorker::readJobFile (const juce::File& jobFile, juce::String& formatName, juce::StringArray& files)
+{
+    auto xml = juce::XmlDocument::parse (jobFile);
+    if (xml == nullptr || ! xml->hasTagName (jobTag.toString()))
+        return false;
+
+    formatName = xml->getStringAttribute (formatAttr.toString());
+
+    for (auto* e : xml->getChildWithTagNameIterator (fileTag.toString()))
+        files.add (e->getStringAttribute (pathAttr.toString()));
+
+    return formatName.isNotEmpty();
+}
+
+juce::String PluginScanWorker::createBeginLine (const juce::String& fileOrIdentifier)
+{
+    return marker + beginTag + "\t" + fileOrIdentifier;
+}
+
+juce::String PluginScanWorker::createResultLine (const juce::String& fileOrIdentifier,
+                                                 const juce::OwnedArray<juce::PluginDescription>& types)
+{
+    juce::XmlElement xml (typesTag.toString());
+
+    for (auto* t : types)
+        xml.addChildElement (t->createXml().release());
+
+    // Single line: newlines inside attribute values are escaped
+    const auto text = xml.toString (juce::XmlElement::TextFormat().singleLine().withoutHeader());
+    return marker + resultTag + "\t" + fileOrIdentifier + "\t" + text;
+}
+
+bool PluginScanWorker::parseLine (const juce::String& line, Message& message)
+{
+    if (! line.contains (marker))
+        return false;
+
+    const auto fields = juce::StringArray::fromTokens (line.fromFirstOccurrenceOf (marker, false, false)
+                                                           .trimCharactersAtEnd ("\r\n"),
+                                                       "\t", {});
+    if (fields.size() < 2)
+        return false;
+
+    message = {};
+    message.fileOrIdentifier = fields[1];
+
+    if (fields[0] == beginTag)
+    {
+        message.type = Message::Type::begin;
+        return true;
+    }
+
+    if (fields[0] != resultTag || fields.size() < 3)
+        return false;
+
+    message.type = Message::Type::result;
+
+    if (auto xml = juce::parseXML (fields[2]))
+    {
+        for (auto* e : xml->getChildIterator())
+        {
+            juce::PluginDescription desc;
+            if (desc.loadFromXml (*e))
+                message.types.add (desc);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <functional>
+
+/**
+ * @brief The child-process side of out-of-process plugin scanning.
+ *
+ * The app re-launches its own executable with `--plugin-scan-worker <jobFile>`.
+ * The job file names a plugin format and the files to scan; the worker
+ * instantiates them one at a time and streams a line per event to stdout:
+ *
+ *  - `begin<TAB>file`               before a file is instantiated
+ *  - `result<TAB>file<TAB>xml`      its types, as single-line PluginDescription XML
+ *
+ * If a plugin hangs or crashes the worker, the parent sees a `begin` without a
+ * `result` and blacklists that file. See OutOfProcessPluginScanner for the parent side.
+ */
+class PluginScanWorker
+{
+public:
+    //==============================================================================
+    /** One parsed line of worker output. */
+    struct Message
+    {
+        enum class Type { begin, result };
+
+        Type type = Type::begin;
+        juce::String fileOrIdentifier;
+        juce::Array<juce::PluginDescription> types;   ///< Only for Type::result.
+    };
+
+    static constexpr const char* commandLineSwitch = "--plugin-scan-worker";
+
+    //==============================================================================
+    // Worker (child process)
+
+    /** Returns true if @p args ask this process to act as a scan worker. */
+    static bool isWorkerCommandLine (const juce::StringArray& args);
+
+    /**
+     * @brief Runs a scan job from the command line, writing results to stdout.
+     *
+     * @param args     Command-line arguments (as from JUCEApplication::getCommandLineParameterArray).
+     * @param formats  Formats the worker can scan; the job's format is looked up by name.
+     * @return The process exit code.
+     */
+    static int runFromCommandLine (const juce::StringArray& args, juce::AudioPluginFormatManager& formats);
+
+    /** Scans @p files in order, passing each protocol line to @p writeLine. */
+    static void scanFiles (juce::AudioPluginFormat& format,
+                           const juce::StringArray& files,
+                           const std::function<void (const juce::String&)>& writeLine);
+
+    //==============================================================================
+    // Protocol
+
+    /** Writes a job file for one worker; returns false if it couldn't be written. */
+    static bool writeJobFile (const juce::File& jobFile, const juce::String& formatName, const juce::StringArray& files);
+
+    /** Reads a job file written by writeJobFile(). */
+    static bool readJobFile (const juce::File& jobFile, juce::String& formatName, juce::StringArray& files);
+
+    static juce::String createBeginLine (const juce::String& fileOrIdentifier);
+    static juce::String createResultLine (const juce::String& fileOrIdentifier,
+                                          const juce::OwnedArray<juce::PluginDescription>& types);
+
+    /** Parses one line of worker output; returns false for anything unrecognised. */
+    static bool parseLine (const juce::String& line, Message& message);
+};
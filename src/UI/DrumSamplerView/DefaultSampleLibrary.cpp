@@ -1,5 +1,6 @@
 #include <juce_core/juce_core.h>
 #include "../../DrumSamplerEngine/DefaultSampleLibrary.h"
+#include "../../AppEngine/StartupTrace.h"
 #include "BinaryData.h"
 
 using namespace juce;
@@ -104,6 +105,8 @@ namespace DefaultSampleLibrary
     //==============================================================================
     void ensureInstalled()
     {
+        GK_TRACE_SCOPE ("DefaultSampleLibrary::ensureInstalled");
+
         int copied = 0;
 
         for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
@@ -2,6 +2,8 @@
 
 MainComponent::MainComponent()
 {
+    GK_TRACE_SCOPE("MainComponent");
+
     // Create shared transport bar
     transportBar = std::make_unique<TransportBar>(appEngine);
     transportBar->onSwitchView = [this] {
@@ -17,19 +19,62 @@ MainComponent::MainComponent()
     menuBar->onSwitchToMix = [this] { showMixView(); };
     menuBar->onSwitchToTrackEdit = [this] { showTrackView(); }; // (Written by Claude Code)
 
+    appEngine.onLoadProgress = [this](const double progress, const juce::String& stage) {
+        showLoadProgress(progress, stage);
+    };
+
     setSize(1200, 800);
 
     appEngine.initialise();
 
     showTrackView();
+
+    if (appEngine.hasRecoverableSession())
+        juce::MessageManager::callAsync([safe = juce::Component::SafePointer<MainComponent>(this)] {
+            if (safe != nullptr)
+                safe->offerSessionRecovery();
+        });
 }
 
 MainComponent::~MainComponent() = default;
 
+void MainComponent::paintOverChildren(juce::Graphics&)
+{
+    // Everything is on screen once the first paint gets here
+    StartupTrace::getInstance().markFirstFrame();
+}
+
 void MainComponent::resized()
 {
     if (view)
         view->setBounds(getLocalBounds());
+
+    if (loadOverlay)
+        loadOverlay->setBounds(getLocalBounds());
+}
+
+void MainComponent::showLoadProgress(const double progress, const juce::String& stage)
+{
+    if (progress >= 1.0)
+    {
+        if (loadOverlay)
+        {
+            removeChildComponent(loadOverlay.get());
+            loadOverlay.reset();
+        }
+        return;
+    }
+
+    if (!loadOverlay)
+    {
+        loadOverlay = std::make_unique<ExportOverlayComponent>();
+        loadOverlay->setBounds(getLocalBounds());
+        addAndMakeVisible(loadOverlay.get());
+    }
+
+    loadOverlay->setText("Opening project...", stage);
+    loadOverlay->setProgress(progress);
+    loadOverlay->toFront(false);
 }
 
 void MainComponent::setView(std::unique_ptr<juce::Component> newView)
@@ -40,10 +85,15 @@ void MainComponent::setView(std::unique_ptr<juce::Component> newView)
     view = std::move(newView);
     addAndMakeVisible(view.get());
     view->setBounds(getLocalBounds());
+
+    if (loadOverlay)
+        loadOverlay->toFront(false);
 }
 
 void MainComponent::showTrackView()
 {
+    GK_TRACE_SCOPE("TrackEditView");
+
     auto tev = std::make_unique<TrackEditView>(appEngine, *transportBar, *menuBar);
     tev->onOpenMix = [this] { showMixView(); };
     transportBar->setViewMode(TransportBar::ViewMode::TrackEdit);
@@ -51,6 +101,28 @@ void MainComponent::showTrackView()
     setView(std::move(tev));
 }
 
+void MainComponent::offerSessionRecovery()
+{
+    const auto opts = juce::MessageBoxOptions()
+        .withIconType(juce::MessageBoxIconType::WarningIcon)
+        .withTitle("Recover unsaved work?")
+        .withMessage("GrooveKit didn't shut down cleanly last time. "
+                     "Do you want to recover the autosaved session?")
+        .withButton("Recover")
+        .withButton("Discard");
+
+    juce::AlertWindow::showAsync(opts,
+        [safe = juce::Component::SafePointer<MainComponent>(this)](const int result) {
+            if (safe == nullptr)
+                return;
+
+            if (result == 1 && safe->appEngine.recoverAutosavedSession())
+                return;
+
+            safe->appEngine.discardRecoveredSession();
+        });
+}
+
 void MainComponent::showMixView()
 {
     auto mv = std::make_unique<MixView>(appEngine, *transportBar, *menuBar);
@@ -6,6 +6,7 @@
 #include "TransportBar/TransportBar.h"
 #include "MenuBar/GrooveKitMenuBar.h"
 #include "../AppEngine/AppEngine.h"
+#include "../AppEngine/StartupTrace.h"
 
 class MainComponent final : public juce::Component
 {
@@ -14,10 +15,13 @@ public:
     ~MainComponent() override;
 
     void resized() override;
+    void paintOverChildren(juce::Graphics&) override;
 
 private:
     void showTrackView();
     void showMixView();
+    void offerSessionRecovery();
+    void showLoadProgress(double progress, const juce::String& stage);
 
     void setView(std::unique_ptr<juce::Component> newView);
 
@@ -25,4 +29,5 @@ private:
     AppEngine appEngine;
     std::unique_ptr<TransportBar> transportBar;
     std::unique_ptr<GrooveKitMenuBar> menuBar;
+    std::unique_ptr<ExportOverlayComponent> loadOverlay;
 };
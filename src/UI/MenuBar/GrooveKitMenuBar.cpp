@@ -55,6 +55,8 @@ juce::PopupMenu GrooveKitMenuBar::getMenuForIndex(const int topLevelMenuIndex, c
         SaveEdit = 2003,
         SaveEditAs = 2004,
         ExportAudio = 2005,
+        ExportStems = 2006,
+        SaveDspLoadReport = 2007,
         NewInstrumentTrack = 3001,
         NewDrumTrack = 3002
     };
@@ -66,7 +68,9 @@ juce::PopupMenu GrooveKitMenuBar::getMenuForIndex(const int topLevelMenuIndex, c
         menu.addSeparator();
         menu.addItem(SaveEdit, "Save Edit");
         menu.addItem(SaveEditAs, "Save Edit As...");
-        menu.addItem (ExportAudio, "Export Audio");
+        menu.addItem (ExportAudio, "Export Audio", ! appEngine->isExporting());
+        menu.addItem (ExportStems, "Export Stems...", ! appEngine->isExporting());
+        menu.addItem (SaveDspLoadReport, "Save DSP Load Report...");
         menu.addSeparator();
         menu.addItem(ShowPreferences, "Preferences..."); // (Written by Claude Code)
     }
@@ -98,6 +102,8 @@ void GrooveKitMenuBar::menuItemSelected(const int menuItemID, int)
         SaveEdit = 2003,
         SaveEditAs = 2004,
         ExportAudio = 2005,
+        ExportStems = 2006,
+        SaveDspLoadReport = 2007,
         NewInstrumentTrack = 3001,
         NewDrumTrack = 3002
     };
@@ -137,7 +143,13 @@ void GrooveKitMenuBar::menuItemSelected(const int menuItemID, int)
             break;
         case ExportAudio:
             exportAudio();
-        break;
+            break;
+        case ExportStems:
+            exportStems();
+            break;
+        case SaveDspLoadReport:
+            saveDspLoadReport();
+            break;
         default:
             break;
     }
@@ -153,7 +165,7 @@ void GrooveKitMenuBar::showPreferences() const
 {
     // Created by Claude Code on 2025-11-18.
     auto* settingsComponent = new SettingsDialog(*appEngine);
-    settingsComponent->setSize(600, 400);
+    settingsComponent->setSize(600, 700);
 
     juce::DialogWindow::LaunchOptions opts;
     opts.content.setOwned(settingsComponent);
@@ -180,20 +192,11 @@ void GrooveKitMenuBar::showNewEditMenu() const
                 if (r == 1)
                 {
                     // Save
-                    const bool hasPath =
-                        appEngine->getCurrentEditFile().getFullPathName().isNotEmpty();
-                    if (hasPath)
-                    {
-                        if (appEngine->saveEdit())
+                    // Falls back to Save As when the edit has no file yet
+                    appEngine->saveEdit([this](const bool ok) {
+                        if (ok)
                             appEngine->newUntitledEdit();
-                    }
-                    else
-                    {
-                        appEngine->saveEditAsAsync([this](const bool ok) {
-                            if (ok)
-                                appEngine->newUntitledEdit();
-                        });
-                    }
+                    });
                 }
                 else if (r == 2)
                 {
@@ -228,18 +231,11 @@ void GrooveKitMenuBar::showOpenEditMenu() const
         [this](const int result) {
             if (result == 1) // Save
             {
-                if (appEngine->getCurrentEditFile().getFullPathName().isNotEmpty())
-                {
-                    if (appEngine->saveEdit())
+                // Falls back to Save As when the edit has no file yet
+                appEngine->saveEdit([this](const bool ok) {
+                    if (ok)
                         appEngine->openEditAsync();
-                }
-                else
-                {
-                    appEngine->saveEditAsAsync([this](const bool ok) {
-                        if (ok)
-                            appEngine->openEditAsync();
-                    });
-                }
+                });
             }
             else if (result == 2) // Discard
             {
@@ -267,35 +263,153 @@ void GrooveKitMenuBar::exportAudio()
 
         file = file.withFileExtension (".wav");
 
-        // Create and show full-screen overlay
         exportOverlay = std::make_unique<ExportOverlayComponent>();
+        exportOverlay->setProgress (0.0);
+        exportOverlay->setCancelCallback ([this] { appEngine->cancelExport(); });
         exportOverlay->setBounds (getLocalBounds());
         addAndMakeVisible (exportOverlay.get());
         exportOverlay->toFront (true);
-        repaint();
-
-        // Do the export
-        const bool ok = appEngine->exportAudio (file);
 
-        // Remove overlay
-        if (exportOverlay != nullptr)
+        auto removeOverlay = [this]
         {
-            removeChildComponent (exportOverlay.get());
-            exportOverlay.reset();
-        }
+            if (exportOverlay != nullptr)
+            {
+                removeChildComponent (exportOverlay.get());
+                exportOverlay.reset();
+            }
+        };
 
-        // Show result
-        if (! ok)
+        // The render runs in the background; the overlay follows its progress
+        const bool started = appEngine->exportAudio (file,
+            [this] (const double progress, const juce::String& status)
+            {
+                if (exportOverlay != nullptr)
+                {
+                    exportOverlay->setProgress (progress);
+                    exportOverlay->setText ("Exporting audio...", status);
+                }
+            },
+            [removeOverlay, file] (const AudioExporter::Result& result)
+            {
+                removeOverlay();
+
+                if (result.cancelled)
+                    return;
+
+                if (result.ok)
+                    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::InfoIcon,
+                                                            "Export complete",
+                                                            "audio exported to:\n" + file.getFullPathName());
+                else
+                    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon,
+                                                            "Export failed",
+                                                            result.error.isNotEmpty() ? result.error
+                                                                                      : "There was a problem rendering the audio.");
+            });
+
+        if (! started)
         {
+            removeOverlay();
             juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon,
                                                     "Export failed",
                                                     "There was a problem rendering the audio.");
         }
-        else
+    });
+}
+
+void GrooveKitMenuBar::exportStems()
+{
+    auto chooser = std::make_shared<juce::FileChooser> (
+        "Export stems to folder",
+        juce::File::getSpecialLocation (juce::File::userDesktopDirectory));
+
+    chooser->launchAsync (juce::FileBrowserComponent::openMode
+                          | juce::FileBrowserComponent::canSelectDirectories,
+                          [this, chooser] (const juce::FileChooser& fc)
+    {
+        const auto dir = fc.getResult();
+
+        if (dir == juce::File())
+            return; // user cancelled
+
+        exportOverlay = std::make_unique<ExportOverlayComponent>();
+        exportOverlay->setText ("Exporting stems...", "Rendering every track in parallel.");
+        exportOverlay->setProgress (0.0);
+        exportOverlay->setCancelCallback ([this] { appEngine->cancelExport(); });
+        exportOverlay->setBounds (getLocalBounds());
+        addAndMakeVisible (exportOverlay.get());
+        exportOverlay->toFront (true);
+
+        auto removeOverlay = [this]
+        {
+            if (exportOverlay != nullptr)
+            {
+                removeChildComponent (exportOverlay.get());
+                exportOverlay.reset();
+            }
+        };
+
+        const bool started = appEngine->exportStems (dir,
+            [this] (const double progress, const juce::String& status)
+            {
+                if (exportOverlay != nullptr)
+                {
+                    exportOverlay->setProgress (progress);
+                    exportOverlay->setText ("Exporting stems...", status);
+                }
+            },
+            [removeOverlay, dir] (const AudioExporter::Result& result)
+            {
+                removeOverlay();
+
+                if (result.cancelled)
+                    return;
+
+                if (result.ok)
+                    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::InfoIcon,
+                                                            "Export complete",
+                                                            juce::String (result.files.size()) + " stems exported to:\n"
+                                                                + dir.getFullPathName());
+                else
+                    juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon,
+                                                            "Export failed",
+                                                            result.error);
+            });
+
+        if (! started)
         {
-            juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::InfoIcon,
-                                                    "Export complete",
-                                                    "audio exported to:\n" + file.getFullPathName());
+            removeOverlay();
+            juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon,
+                                                    "Export failed",
+                                                    "There are no tracks to export.");
         }
     });
 }
+
+void GrooveKitMenuBar::saveDspLoadReport() const
+{
+    auto chooser = std::make_shared<juce::FileChooser> (
+        "Save DSP load report",
+        juce::File::getSpecialLocation (juce::File::userDesktopDirectory).getChildFile ("DSP Load.csv"),
+        "*.csv");
+
+    chooser->launchAsync (juce::FileBrowserComponent::saveMode
+                          | juce::FileBrowserComponent::canSelectFiles
+                          | juce::FileBrowserComponent::warnAboutOverwriting,
+                          [this, chooser] (const juce::FileChooser& fc)
+    {
+        auto file = fc.getResult();
+
+        if (file == juce::File())
+            return; // user cancelled
+
+        file = file.withFileExtension (".csv");
+
+        const auto result = appEngine->saveDspLoadReport (file);
+
+        if (result.failed())
+            juce::AlertWindow::showMessageBoxAsync (juce::AlertWindow::WarningIcon,
+                                                    "Couldn't save report",
+                                                    result.getErrorMessage());
+    });
+}
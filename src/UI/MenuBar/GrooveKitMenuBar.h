@@ -53,6 +53,8 @@ private:
     void showNewEditMenu() const;
     void showOpenEditMenu() const;
     void exportAudio();
+    void exportStems();
+    void saveDspLoadReport() const;
 
     std::shared_ptr<AppEngine> appEngine;
     std::unique_ptr<ExportOverlayComponent> exportOverlay;
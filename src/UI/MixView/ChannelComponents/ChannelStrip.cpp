@@ -1,5 +1,6 @@
 #include "ChannelStrip.h"
 #include "../TrackView/TrackHeaderComponent.h"
+#include "../../../AppEngine/MeterTapPlugin.h"
 #include "MainComponent.h"
 
 /**
@@ -9,12 +10,15 @@
  *   - Instrument button
  *   - Inserts label + insert slot buttons + ▼ menus
  *   - Mute / Solo / Record buttons
+ *   - Freeze toggle
  *   - Editable track name
  *   - Volume fader with custom LookAndFeel (FaderComponent)
+ *   - Level meter + LUFS readout
  *   - Pan knob
  */
 ChannelStrip::ChannelStrip (juce::Colour color)
-    : stripColor (color)
+    : stripColor (color),
+      meter (color.darker (0.4f))
 {
     setOpaque (false);
 
@@ -72,7 +76,7 @@ ChannelStrip::ChannelStrip (juce::Colour color)
 
     //==========================================================================
     // Mute / Solo / Record buttons (toggle states)
-    for (auto* b : { &muteButton, &soloButton, &recordButton })
+    for (auto* b : { &muteButton, &soloButton, &recordButton, &freezeButton })
     {
         addAndMakeVisible (*b);
         b->setColour (juce::TextButton::buttonColourId, juce::Colour (0xFFADB5BD));
@@ -82,15 +86,19 @@ ChannelStrip::ChannelStrip (juce::Colour color)
     muteButton.setButtonText ("M");
     soloButton.setButtonText ("S");
     recordButton.setButtonText ("R");
+    freezeButton.setButtonText ("Freeze");
 
     muteButton.setClickingTogglesState   (true);
     soloButton.setClickingTogglesState   (true);
     recordButton.setClickingTogglesState (true);
+    freezeButton.setClickingTogglesState (true);
 
     // Match TrackHeaderComponent colors
     muteButton  .setColour (juce::TextButton::buttonOnColourId, juce::Colours::red);
     soloButton  .setColour (juce::TextButton::buttonOnColourId, juce::Colours::yellow);
     recordButton.setColour (juce::TextButton::buttonOnColourId, juce::Colours::darkred);
+    freezeButton.setColour (juce::TextButton::buttonOnColourId, juce::Colour (0xFF4DABF7));
+    freezeButton.setTooltip ("Freeze: render this track to audio and switch its plugins off to save CPU");
 
     //==========================================================================
     // Instrument button callback (open plugin editor)
@@ -165,6 +173,32 @@ ChannelStrip::ChannelStrip (juce::Colour color)
             onRequestArmChange (nowArmed);
     };
 
+    freezeButton.onClick = [this]
+    {
+        const bool nowFrozen = freezeButton.getToggleState();
+        bool handled = false;
+
+        for (int i = listenerComponents.size(); --i >= 0;)
+        {
+            if (auto* comp = listenerComponents[i].getComponent())
+            {
+                if (auto* l = dynamic_cast<TrackHeaderComponent::Listener*>(comp))
+                {
+                    l->onFreezeToggled (nowFrozen);
+                    handled = true;
+                }
+                else
+                    listenerComponents.remove (i);
+            }
+            else
+                listenerComponents.remove (i);
+        }
+
+        // Freezing isn't idempotent like mute, so only one path may start it
+        if (! handled && onRequestFreezeChange)
+            onRequestFreezeChange (nowFrozen);
+    };
+
     //==========================================================================
     // Track name label
     addAndMakeVisible (name);
@@ -193,6 +227,20 @@ ChannelStrip::ChannelStrip (juce::Colour color)
     pan.setTextBoxStyle (juce::Slider::NoTextBox, false, 0, 0);
     pan.setRange (-1.0, 1.0, 0.001);
     pan.setValue (0.0);
+
+    //==========================================================================
+    // Level meter + short-term loudness (both opaque, so their repaints stop at their bounds)
+    addAndMakeVisible (meter);
+    meter.setTooltip ("Peak / RMS (click to clear the clip lights)");
+
+    addAndMakeVisible (lufsLabel);
+    lufsLabel.setOpaque (true);
+    lufsLabel.setColour (juce::Label::backgroundColourId, stripColor.darker (0.4f));
+    lufsLabel.setColour (juce::Label::textColourId, juce::Colours::white.withAlpha (0.7f));
+    lufsLabel.setFont (juce::Font (10.0f));
+    lufsLabel.setJustificationType (juce::Justification::centred);
+    lufsLabel.setTooltip ("Short-term loudness (3 s)");
+    lufsLabel.setText ("-- LUFS", juce::dontSendNotification);
 }
 
 ChannelStrip::~ChannelStrip()
@@ -228,6 +276,7 @@ void ChannelStrip::bindToTrack (te::AudioTrack& track)
 
     // Show instrument + inserts for regular tracks
     instrumentButton.setVisible (true);
+    freezeButton.setVisible (true);
     insertsLabel.setVisible (true);
     for (auto* s : insertSlots)
         s->setVisible (true);
@@ -272,8 +321,11 @@ void ChannelStrip::bindToMaster (te::Edit& edit)
         boundVnp->setSliderPos (pos);
     };
 
+    meterAddsFaderGain = true;
+
     // Master strip doesn’t have an instrument button
     instrumentButton.setVisible (false);
+    freezeButton.setVisible (false);   // the master bus can't be frozen
 
     // ---- Pan binding ----
     const float panValue = boundVnp ? boundVnp->getPan() : 0.0f;
@@ -335,6 +387,15 @@ void ChannelStrip::setMuted (bool b)   { muteButton.setToggleState   (b, juce::d
 void ChannelStrip::setSolo  (bool b)   { soloButton.setToggleState   (b, juce::dontSendNotification); }
 void ChannelStrip::setArmed (bool b)   { recordButton.setToggleState (b, juce::dontSendNotification); }
 
+void ChannelStrip::setFreezeState (bool isFrozen, double freezeProgress)
+{
+    const bool freezing = freezeProgress >= 0.0;
+
+    freezeButton.setToggleState (isFrozen || freezing, juce::dontSendNotification);
+    freezeButton.setButtonText (freezing ? juce::String (juce::roundToInt (freezeProgress * 100.0)) + "%"
+                                         : isFrozen ? "Frozen" : "Freeze");
+}
+
 void ChannelStrip::setInsertSlotName (int slotIndex, const juce::String& text)
 {
     if (! juce::isPositiveAndBelow (slotIndex, insertSlots.size()))
@@ -349,6 +410,71 @@ void ChannelStrip::setInstrumentButtonText (const juce::String& text)
     instrumentButton.setButtonText (text.isEmpty() ? "Instrument" : text);
 }
 
+namespace
+{
+    juce::String describeDspLoad (double average, double peak)
+    {
+        return "DSP " + juce::String (average * 100.0, 1) + "% avg, "
+                      + juce::String (peak * 100.0, 1) + "% peak";
+    }
+}
+
+void ChannelStrip::setDspLoad (double average, double peak)
+{
+    // Skip repaints for changes the bar can't show
+    if (std::abs (average - dspLoad) < 0.001 && std::abs (peak - dspLoadPeak) < 0.001)
+        return;
+
+    dspLoad     = average;
+    dspLoadPeak = peak;
+    repaint (dspLoadArea);
+}
+
+void ChannelStrip::setInstrumentDspLoad (double average, double peak)
+{
+    instrumentButton.setTooltip (instrumentButton.getButtonText() + "\n" + describeDspLoad (average, peak));
+}
+
+void ChannelStrip::setInsertSlotDspLoad (int slotIndex, double average, double peak)
+{
+    if (! juce::isPositiveAndBelow (slotIndex, insertSlots.size()))
+        return;
+
+    if (auto* button = insertSlots[slotIndex])
+    {
+        const auto text = button->getButtonText();
+        button->setTooltip (text.isEmpty() ? juce::String() : text + "\n" + describeDspLoad (average, peak));
+    }
+}
+
+void ChannelStrip::setMeterTap (MeterTapPlugin* tap)
+{
+    meterTap = tap;
+    meter.clear();
+    lufsLabel.setText ("-- LUFS", juce::dontSendNotification);
+}
+
+void ChannelStrip::updateMeter()
+{
+    auto* tap = static_cast<MeterTapPlugin*> (meterTap.get());
+    if (tap == nullptr)
+        return;
+
+    const auto readings = tap->readMeter();
+
+    float gainDb = 0.0f;
+    if (meterAddsFaderGain && boundVnp != nullptr)
+        gainDb = juce::Decibels::gainToDecibels (te::volumeFaderPositionToGain (boundVnp->getSliderPos()), -100.0f);
+
+    meter.setReadings (readings, gainDb);
+
+    // Label::setText is a no-op for the same text, so this only repaints on a visible change
+    const float lufs = readings.shortTermLufs + gainDb;
+    const bool silent = readings.shortTermLufs <= MeterTap::minLufs || ! meter.isReceivingAudio();
+    lufsLabel.setText (silent ? juce::String ("-- LUFS") : juce::String (lufs, 1) + " LUFS",
+                       juce::dontSendNotification);
+}
+
 //==============================================================================
 // Painting & Layout
 void ChannelStrip::paint (juce::Graphics& g)
@@ -360,6 +486,32 @@ void ChannelStrip::paint (juce::Graphics& g)
 
     g.setColour (juce::Colours::white.withAlpha (0.20f));
     g.drawRoundedRectangle (bounds, 10.0f, 1.5f);
+
+    // DSP load: average as the bar, worst callback as a tick
+    if (boundTrack != nullptr && ! dspLoadArea.isEmpty())
+    {
+        const auto bar = dspLoadArea.toFloat();
+        g.setColour (juce::Colours::black.withAlpha (0.35f));
+        g.fillRoundedRectangle (bar, 2.0f);
+
+        const auto colourFor = [] (double load)
+        {
+            return load < 0.5 ? juce::Colour (0xFF51CF66)
+                 : load < 0.8 ? juce::Colour (0xFFFCC419)
+                              : juce::Colour (0xFFFF6B6B);
+        };
+
+        const auto avgW = bar.getWidth() * (float) juce::jlimit (0.0, 1.0, dspLoad);
+        g.setColour (colourFor (dspLoad));
+        g.fillRoundedRectangle (bar.withWidth (avgW), 2.0f);
+
+        if (dspLoadPeak > dspLoad)
+        {
+            const auto peakX = bar.getX() + bar.getWidth() * (float) juce::jlimit (0.0, 1.0, dspLoadPeak);
+            g.setColour (colourFor (dspLoadPeak));
+            g.fillRect (juce::Rectangle<float> (peakX - 1.0f, bar.getY(), 2.0f, bar.getHeight()));
+        }
+    }
 }
 
 void ChannelStrip::resized()
@@ -380,7 +532,7 @@ void ChannelStrip::resized()
         numSlots > 0 ? (numSlots * slotH + (numSlots - 1) * slotGap) : 0;
 
     const int topH =
-        bigBtnH + gapS + labelH + slotsTotalH + gapM + (3 * bigBtnH);
+        bigBtnH + gapS + labelH + slotsTotalH + gapM + (4 * bigBtnH) + (3 * gapS);
 
     auto top = r.removeFromTop (topH);
 
@@ -390,6 +542,10 @@ void ChannelStrip::resized()
     auto nameArea = r.removeFromBottom (nameH + nameGap);
     name.setBounds (nameArea.removeFromBottom (nameH));
 
+    // DSP load bar just above the name
+    constexpr int loadBarH = 4;
+    dspLoadArea = r.removeFromBottom (loadBarH + gapS).removeFromTop (loadBarH).reduced (4, 0);
+
     // Instrument button
     instrumentButton.setBounds (top.removeFromTop (bigBtnH));
     top.removeFromTop (gapS);
@@ -416,12 +572,14 @@ void ChannelStrip::resized()
 
     top.removeFromTop (gapM);
 
-    // Mute / Solo / Record
+    // Mute / Solo / Record / Freeze
     muteButton.setBounds   (top.removeFromTop (bigBtnH));
     top.removeFromTop (gapS);
     soloButton.setBounds   (top.removeFromTop (bigBtnH));
     top.removeFromTop (gapS);
     recordButton.setBounds (top.removeFromTop (bigBtnH));
+    top.removeFromTop (gapS);
+    freezeButton.setBounds (top.removeFromTop (bigBtnH));
 
     // Pan + Fader area
     auto bottom = r;
@@ -429,5 +587,10 @@ void ChannelStrip::resized()
     auto panArea = bottom.removeFromTop (48);
     pan.setBounds (panArea.withSizeKeepingCentre (50, 50));
 
+    lufsLabel.setBounds (bottom.removeFromBottom (14).reduced (4, 0));
+
+    constexpr int meterW = 13;
+    meter.setBounds (bottom.removeFromRight (meterW + 4).withTrimmedRight (4).reduced (0, 16));
+
     fader.setBounds (bottom.reduced (2, 8));
 }
\ No newline at end of file
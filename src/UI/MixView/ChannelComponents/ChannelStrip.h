@@ -2,11 +2,14 @@
 
 #include "../TrackView/TrackHeaderComponent.h"
 #include "ChannelStripComponents/FaderComponent.h"
+#include "ChannelStripComponents/LevelMeterComponent.h"
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
 
 namespace te = tracktion::engine;
 
+class MeterTapPlugin;
+
 /**
  * @brief A single mixer-strip UI component used in Mix View.
  *
@@ -19,9 +22,12 @@ namespace te = tracktion::engine;
  *   - Instrument button
  *   - FX Insert slots with ▼ menu buttons
  *   - Mute / Solo / Record-Arm buttons
- *   - Volume fader (custom LookAndFeel)
+ *   - Freeze toggle (shows progress while the track renders)
+ *   - Volume fader (custom LookAndFeel) with a peak/RMS meter beside it
+ *   - Short-term loudness (LUFS) readout under the fader
  *   - Pan knob
  *   - Editable track name label
+ *   - DSP load bar (tracks only), with per-plugin load in the instrument/insert tooltips
  *
  * It forwards user actions back to TrackHeaderComponent listeners or to
  * callback functions provided by MixView (e.g., onRequestMuteChange).
@@ -94,6 +100,9 @@ public:
     void setArmed (bool isArmed);
     bool isArmed() const;
 
+    /** Shows the freeze toggle as frozen or not; a @p freezeProgress of 0..1 shows a freeze in progress. */
+    void setFreezeState (bool isFrozen, double freezeProgress = -1.0);
+
     /** Change label of a specific FX insert slot (0–3). */
     void setInsertSlotName (int slotIndex, const juce::String& text);
 
@@ -102,11 +111,27 @@ public:
 
     int getNumInsertSlots() const { return insertSlots.size(); }
 
+    /** Sets the track's DSP load bar (fractions of real time; see DspLoadMonitor). */
+    void setDspLoad (double average, double peak);
+
+    /** Adds the instrument's DSP load to the instrument button tooltip. */
+    void setInstrumentDspLoad (double average, double peak);
+
+    /** Adds a plugin's DSP load to an FX insert slot's tooltip; ignored for empty slots. */
+    void setInsertSlotDspLoad (int slotIndex, double average, double peak);
+
+    /** Feeds the level meter from @p tap (nullptr = no meter signal); the master adds its fader gain. */
+    void setMeterTap (MeterTapPlugin* tap);
+
+    /** Display rate: pulls the tap's readings; the meter and LUFS readout repaint only if they changed. */
+    void updateMeter();
+
     //==========================================================================
     // Callback hooks used by MixView when TrackHeaderComponent is not present
     std::function<void (bool)> onRequestMuteChange;
     std::function<void (bool)> onRequestSoloChange;
     std::function<void (bool)> onRequestArmChange;
+    std::function<void (bool)> onRequestFreezeChange;   ///< Only called when no TrackHeaderComponent listener handled it
     std::function<void()>      onOpenInstrumentEditor;
     std::function<void (int)>  onInsertSlotClicked;
     std::function<void (int)>  onInsertSlotMenuRequested;
@@ -117,7 +142,7 @@ private:
     int trackIndex = -1;
     juce::Colour stripColor;
 
-    juce::TextButton muteButton, soloButton, recordButton;
+    juce::TextButton muteButton, soloButton, recordButton, freezeButton;
     juce::TextButton instrumentButton;
 
     juce::Label insertsLabel;
@@ -126,10 +151,18 @@ private:
 
     juce::Label name;
 
+    double dspLoad = 0.0, dspLoadPeak = 0.0;
+    juce::Rectangle<int> dspLoadArea;
+
     FaderComponent lnf;
     juce::Slider fader;
     juce::Slider pan;
 
+    LevelMeterComponent meter;
+    juce::Label lufsLabel;
+    te::Selectable::WeakRef meterTap;    ///< A MeterTapPlugin; weak because it is read every frame and tracks can go away first
+    bool meterAddsFaderGain { false };   ///< Master: the tap sits before the master fader
+
     te::AudioTrack*           boundTrack { nullptr };
     te::VolumeAndPanPlugin*   boundVnp   { nullptr };
     bool ignoreSliderCallback { false };
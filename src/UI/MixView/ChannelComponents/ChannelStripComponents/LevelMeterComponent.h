@@ -0,0 +1,208 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <array>
+#include "../../../../AudioEngine/MeterTap.h"
+
+/**
+ * @brief Stereo peak/RMS bar meter for a ChannelStrip.
+ *
+ * The owner pushes MeterTap readings at display rate via setReadings(). The
+ * meter turns them into pixel positions and repaints itself only when one of
+ * them moved, and it is opaque, so nothing behind it is redrawn. RMS is the
+ * solid bar, the held peak a line above it, and the top cell lights red once
+ * the signal has gone over 0 dBFS (cleared by clicking the meter).
+ */
+class LevelMeterComponent final : public juce::Component,
+                                  public juce::SettableTooltipClient
+{
+public:
+    static constexpr float minDb             = -60.0f;
+    static constexpr float maxDb             = 6.0f;
+    static constexpr double peakHoldSeconds  = 1.5;
+    static constexpr float peakFallDbPerSec  = 24.0f;
+    static constexpr double staleSeconds     = 0.25;    ///< No audio for this long reads as silence
+
+    explicit LevelMeterComponent (juce::Colour backgroundColour)
+        : background (backgroundColour)
+    {
+        setOpaque (true);
+    }
+
+    /**
+     * @brief Shows new readings; @p gainDb is added to them (the master's fader).
+     *
+     * Call at display rate from the message thread.
+     */
+    void setReadings (const MeterTap::Readings& readings, float gainDb = 0.0f)
+    {
+        const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+        const double elapsed = lastUpdate > 0.0 ? juce::jmin (0.1, now - lastUpdate) : 0.0;
+        lastUpdate = now;
+
+        if (readings.fresh)
+            lastFresh = now;
+
+        const bool live = isReceivingAudio();
+
+        for (size_t ch = 0; ch < channels.size(); ++ch)
+        {
+            auto& c = channels[ch];
+            const float peakDb = live ? juce::Decibels::gainToDecibels (readings.peak[ch], minDb) + gainDb : minDb;
+            c.rmsDb = live ? juce::Decibels::gainToDecibels (readings.rms[ch], minDb) + gainDb : minDb;
+
+            if (peakDb >= c.heldPeakDb)
+            {
+                c.heldPeakDb = peakDb;
+                c.heldSince = now;
+            }
+            else if (now - c.heldSince > peakHoldSeconds)
+            {
+                c.heldPeakDb = juce::jmax (peakDb, c.heldPeakDb - peakFallDbPerSec * (float) elapsed);
+            }
+
+            c.clipped = c.clipped || peakDb > 0.0f;
+        }
+
+        repaintIfMoved();
+    }
+
+    /** False once no audio has reached the tap for staleSeconds. */
+    bool isReceivingAudio() const noexcept { return lastUpdate - lastFresh < staleSeconds; }
+
+    /** Drops everything back to silence (e.g. when the strip is rebound). */
+    void clear()
+    {
+        for (auto& c : channels)
+            c = {};
+
+        repaintIfMoved();
+    }
+
+    void mouseDown (const juce::MouseEvent&) override
+    {
+        for (auto& c : channels)
+            c.clipped = false;
+
+        repaintIfMoved();
+    }
+
+    void resized() override
+    {
+        painted = {};   // pixel positions depend on the height
+        repaintIfMoved();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        g.fillAll (background);
+
+        const auto bounds = getLocalBounds();
+        const int barW = juce::jmax (1, (bounds.getWidth() - 1) / 2);
+
+        for (size_t ch = 0; ch < channels.size(); ++ch)
+        {
+            const auto& shown = painted[ch];
+            auto bar = bounds.withWidth (barW).withX (bounds.getX() + (int) ch * (barW + 1));
+            auto clipCell = bar.removeFromTop (clipCellH);
+            bar.removeFromTop (1);
+
+            g.setColour (shown.clipped ? juce::Colour (0xFFFF6B6B) : juce::Colours::black.withAlpha (0.35f));
+            g.fillRect (clipCell);
+
+            g.setColour (juce::Colours::black.withAlpha (0.35f));
+            g.fillRect (bar);
+
+            // RMS as zones: green to -18 dB, yellow to -6 dB, red above
+            const auto fillUpTo = [&] (float fromDb, float toDb, juce::Colour colour)
+            {
+                const int top = juce::jmax (yForDb (toDb, bar), shown.rmsY);
+                const int bottom = yForDb (fromDb, bar);
+
+                if (bottom > top)
+                {
+                    g.setColour (colour);
+                    g.fillRect (bar.getX(), top, bar.getWidth(), bottom - top);
+                }
+            };
+
+            if (shown.rmsY < bar.getBottom())
+            {
+                fillUpTo (minDb, -18.0f, juce::Colour (0xFF51CF66));
+                fillUpTo (-18.0f, -6.0f, juce::Colour (0xFFFCC419));
+                fillUpTo (-6.0f, maxDb,  juce::Colour (0xFFFF6B6B));
+            }
+
+            if (shown.peakY < bar.getBottom())
+            {
+                g.setColour (juce::Colours::white.withAlpha (0.85f));
+                g.fillRect (bar.getX(), shown.peakY, bar.getWidth(), 2);
+            }
+        }
+
+        // 0 dBFS mark
+        g.setColour (juce::Colours::white.withAlpha (0.4f));
+        g.fillRect (bounds.getX(), yForDb (0.0f, bounds.withTrimmedTop (clipCellH + 1)), bounds.getWidth(), 1);
+    }
+
+private:
+    struct Channel
+    {
+        float rmsDb = minDb;
+        float heldPeakDb = minDb;
+        double heldSince = 0.0;
+        bool clipped = false;
+    };
+
+    /** What the last paint showed, in pixels, so unchanged frames cost nothing. */
+    struct Painted
+    {
+        int rmsY = -1, peakY = -1;
+        bool clipped = false;
+
+        bool operator!= (const Painted& other) const
+        {
+            return rmsY != other.rmsY || peakY != other.peakY || clipped != other.clipped;
+        }
+    };
+
+    static constexpr int clipCellH = 3;
+
+    juce::Rectangle<int> getBarArea() const
+    {
+        return getLocalBounds().withTrimmedTop (clipCellH + 1);
+    }
+
+    static int yForDb (float db, juce::Rectangle<int> bar)
+    {
+        const float proportion = juce::jlimit (0.0f, 1.0f, (db - minDb) / (maxDb - minDb));
+        return bar.getBottom() - juce::roundToInt (proportion * (float) bar.getHeight());
+    }
+
+    void repaintIfMoved()
+    {
+        const auto bar = getBarArea();
+        bool moved = false;
+
+        for (size_t ch = 0; ch < channels.size(); ++ch)
+        {
+            const auto& c = channels[ch];
+            Painted now { yForDb (c.rmsDb, bar), yForDb (c.heldPeakDb, bar), c.clipped };
+
+            if (now != painted[ch])
+            {
+                painted[ch] = now;
+                moved = true;
+            }
+        }
+
+        if (moved)
+            repaint();
+    }
+
+    juce::Colour background;
+    std::array<Channel, MeterTap::numChannels> channels;
+    std::array<Painted, MeterTap::numChannels> painted;
+    double lastUpdate = 0.0, lastFresh = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeterComponent)
+};
@@ -17,10 +17,15 @@ MixerPanel::MixerPanel (AppEngine& engine)
     appEngine.onArmedTrackChanged = [this] {
         refreshArmStates();
     };
+
+    appEngine.addFreezeListener (this);
+    appEngine.addDspLoadListener (this);
 }
 
 MixerPanel::~MixerPanel()
 {
+    appEngine.removeFreezeListener (this);
+    appEngine.removeDspLoadListener (this);
     removeAllChildren();
     trackStrips.clear (true);
     masterStrip.reset();
@@ -84,6 +89,9 @@ void MixerPanel::refreshTracks()
             if (currentSelected != newSelected)
                 appEngine.setArmedTrack (newSelected);
         };
+        strip->onRequestFreezeChange = [this, idx = i] (bool frozen) {
+            appEngine.setTrackFrozen (idx, frozen);
+        };
         // Handle track name changes
         strip->onRequestNameChange = [this] (int trackIndex, const juce::String& newName) {
             appEngine.setTrackName (trackIndex, newName);
@@ -123,6 +131,7 @@ void MixerPanel::refreshTracks()
 
         strip->setInstrumentButtonText (
             appEngine.getInstrumentLabelForTrack (i));
+        strip->setMeterTap (appEngine.getTrackMeterTap (i));
 
         const int numSlots = strip->getNumInsertSlots();
         for (int slot = 0; slot < numSlots; ++slot)
@@ -141,9 +150,13 @@ void MixerPanel::refreshTracks()
         masterStrip = std::make_unique<ChannelStrip>(juce::Colours::dimgrey);
         masterStrip->setTrackName ("Master");
         masterStrip->bindToMaster (edit);
+        masterStrip->setMeterTap (appEngine.getMasterMeterTap());
         addAndMakeVisible (*masterStrip);
     }
 
+    refreshFreezeStates();
+    refreshDspLoads();
+
     resized();
     repaint();
 }
@@ -159,6 +172,56 @@ void MixerPanel::refreshArmStates()
     }
 }
 
+void MixerPanel::refreshFreezeStates()
+{
+    for (int i = 0; i < trackStrips.size(); ++i)
+    {
+        if (auto* strip = trackStrips[i])
+        {
+            const auto state = appEngine.getTrackFreezeState (i);
+            strip->setFreezeState (state == TrackFreezer::State::frozen,
+                                   state == TrackFreezer::State::freezing ? appEngine.getTrackFreezeProgress (i) : -1.0);
+        }
+    }
+}
+
+void MixerPanel::refreshDspLoads()
+{
+    for (int i = 0; i < trackStrips.size(); ++i)
+    {
+        if (auto* strip = trackStrips[i])
+        {
+            const auto trackLoad = appEngine.getTrackDspLoad (i);
+            strip->setDspLoad (trackLoad.average, trackLoad.peak);
+
+            const auto instrumentLoad = appEngine.getInstrumentDspLoad (i);
+            strip->setInstrumentDspLoad (instrumentLoad.average, instrumentLoad.peak);
+
+            for (int slot = 0; slot < strip->getNumInsertSlots(); ++slot)
+            {
+                const auto slotLoad = appEngine.getInsertSlotDspLoad (i, slot);
+                strip->setInsertSlotDspLoad (slot, slotLoad.average, slotLoad.peak);
+            }
+        }
+    }
+}
+
+void MixerPanel::refreshMeters()
+{
+    for (auto* strip : trackStrips)
+        strip->updateMeter();
+
+    if (masterStrip)
+        masterStrip->updateMeter();
+}
+
+void MixerPanel::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    // Freeze and DSP load share this callback; both refreshes are cheap
+    refreshFreezeStates();
+    refreshDspLoads();
+}
+
 //==============================================================================
 // Component Overrides
 
@@ -23,8 +23,12 @@ namespace te = tracktion::engine;
  *  - Created and owned by MixView
  *  - Call refreshTracks() when track configuration changes
  *  - Call refreshArmStates() when armed track changes to update visual indicators
+ *  - Freeze toggles follow AppEngine's freeze broadcaster on their own
+ *  - DSP load bars and insert tooltips follow AppEngine's DSP load polls
+ *  - Level meters are pulled from the strips' meter taps once per display frame
  */
-class MixerPanel final : public juce::Component
+class MixerPanel final : public juce::Component,
+                         private juce::ChangeListener
 {
 public:
     //==============================================================================
@@ -59,12 +63,37 @@ public:
      */
     void refreshArmStates();
 
+    /**
+     * @brief Updates freeze toggles (frozen / progress) on all channel strips.
+     *
+     * Called automatically whenever a track's freeze state or progress changes.
+     */
+    void refreshFreezeStates();
+
+    /**
+     * @brief Updates DSP load bars and instrument/insert tooltips on all track strips.
+     *
+     * Called automatically after every DSP load poll.
+     */
+    void refreshDspLoads();
+
+    /**
+     * @brief Pulls every strip's meter readings.
+     *
+     * Driven by a VBlankAttachment, so it runs once per display frame while the
+     * panel is showing. Strips repaint only meters whose pixels moved.
+     */
+    void refreshMeters();
+
     //==============================================================================
     // Component Overrides
 
     void resized() override;
 
 private:
+    /** Freeze state/progress changed or new DSP load figures arrived. */
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
     //==============================================================================
     // Member Variables
 
@@ -75,8 +104,11 @@ private:
 
     juce::Viewport tracksViewport; ///< Horizontal scrolling viewport for track strips
     juce::Component tracksContainer; ///< Container holding all track strips for viewport
+    juce::TooltipWindow tooltipWindow { this }; ///< Shows the strips' insert/DSP load tooltips
 
     int innerMargin = 12; ///< Internal margin around strips in pixels
     int gap = 12; ///< Gap between channel strips in pixels
     int stripW = 120; ///< Width of each channel strip in pixels
+
+    juce::VBlankAttachment meterVBlank { this, [this] { refreshMeters(); } }; ///< Display-rate meter updates (declared last: detached first)
 };
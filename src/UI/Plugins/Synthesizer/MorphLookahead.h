@@ -0,0 +1,874 @@
+// ==============================================================================
+// MorphLookahead.h
+// ------------------------------------------------------------------------------
+// Anticipative (look-ahead) rendering of clip notes for the Morph Synth.
+//
+// Responsibilities:
+//  - Render the track's upcoming clip notes on a shared worker thread into a
+//    ring buffer, up to a few seconds ahead of the playhead.
+//  - Let the audio callback copy from that buffer instead of running voices.
+//  - Re-render the unplayed part of the buffer when notes change.
+//
+// Notes:
+//  - Three threads touch this class: the message thread (setNotes, setLoop,
+//    setEnabled), one worker (renderAhead) and the audio thread (beginBlock,
+//    addPrerendered). The audio thread never locks or allocates.
+//  - Hand-over is seamless: when playback starts (or jumps), the plugin's own
+//    synth plays everything until the buffer's first sample, and keeps playing
+//    the notes it already started until their note-offs. Notes that start from
+//    that point on come from the buffer only.
+//  - A refresh (notes changed) keeps a short margin of already rendered
+//    audio, then re-renders from there. Notes held across that point are
+//    re-rendered from their note-on (pre-roll), so they don't re-attack.
+//  - Each stream is rendered with the parameters of the moment it was asked
+//    for. When they change, playback goes live until they have settled, and
+//    the live synth restarts the notes the buffer was playing.
+//  - If the worker falls behind, the block is played live instead and the
+//    next stream takes over the notes the buffer had started (pre-roll again).
+// ==============================================================================
+
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+#include "MorphSynthesiser.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Renders a MorphSynth's clip notes ahead of time on a worker thread.
+ *
+ * Positions are in edit samples (seconds * sampleRate). The ring is indexed by
+ * a "stream" position that counts samples rendered since the last reset; the
+ * stream maps onto the edit timeline, wrapping at the loop end when looping.
+ */
+class MorphLookahead : private juce::TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** One clip note, in edit time. */
+    struct Note
+    {
+        double startSeconds = 0.0, endSeconds = 0.0;
+        int channel = 1, noteNumber = 60;
+        float velocity = 0.8f;   ///< 0..1
+    };
+
+    static constexpr double defaultLookaheadSeconds = 1.0;
+    static constexpr double maxLookaheadSeconds     = 4.0;
+    static constexpr double maxPrerollSeconds       = 1.0;  ///< How far back a refresh re-renders held notes from.
+    static constexpr double resyncLeadSeconds       = 0.1;  ///< Live-only time after play/seek before the buffer takes over.
+    static constexpr double refreshMarginSeconds    = 0.1;  ///< Rendered audio kept when notes change.
+    static constexpr double paramSettleSeconds      = 0.25; ///< How long parameters must stay put before the buffer takes over again.
+    static constexpr int    chunkSize               = 256;  ///< Worker render granularity (samples).
+    static constexpr int    handoverGuard           = 2;    ///< Samples kept free of note-ons around a resync point.
+
+    MorphLookahead()
+    {
+        synth.addSound (new Sound());
+        synth.setMinimumRenderingSubdivisions (1);
+    }
+
+    ~MorphLookahead() override
+    {
+        stop();
+    }
+
+    //==============================================================================
+    // Setup (message thread)
+    //------------------------------------------------------------------------------
+
+    /** Allocate the ring and prepare the worker's synth. Stops the worker while it does so. */
+    void prepare (double newSampleRate, int maxBlockSize)
+    {
+        const bool wasRunning = worker != nullptr;
+        stop();
+
+        sampleRate = newSampleRate;
+        maxBlock   = juce::jmax (maxBlockSize, chunkSize);
+        capacity   = (int) std::ceil (maxLookaheadSeconds * sampleRate) + maxBlock;
+
+        ring.setSize (2, capacity);
+        ring.clear();
+        chunkBuffer.setSize (2, chunkSize);
+        chunkMidi.ensureSize (2048);
+        synth.prepare (sampleRate, chunkSize, &workerParams);
+
+        // Worker and audio thread both start from "nothing rendered"
+        generation.store (0);
+        requestedGeneration.store (0);
+        validEnd.store (0);
+        readStream.store (0);
+        workerGeneration = 0;
+        audio = {};
+        notesVersionSeen = -1;
+
+        if (wasRunning)
+            start();
+    }
+
+    /** Register with a shared worker thread. */
+    void start()
+    {
+        if (worker != nullptr || sampleRate <= 0.0)
+            return;
+
+        worker = &workers->next();
+        worker->addTimeSliceClient (this);
+    }
+
+    /** Unregister from the worker (blocks until any slice in progress has finished). */
+    void stop()
+    {
+        if (worker == nullptr)
+            return;
+
+        worker->removeTimeSliceClient (this);
+        worker = nullptr;
+    }
+
+    /** Replace the clip notes; the unplayed part of the buffer is re-rendered. */
+    void setNotes (std::vector<Note> newNotes)
+    {
+        {
+            const juce::ScopedLock sl (notesLock);
+            pendingNotes = std::move (newNotes);
+            ++notesVersion;
+        }
+
+        refreshRequested.store (true);
+    }
+
+    /** Loop range in edit seconds. A change makes the audio thread resync. */
+    void setLoop (bool isLooping, double startSeconds, double endSeconds) noexcept
+    {
+        loopStartSeconds.store (startSeconds);
+        loopEndSeconds.store (endSeconds);
+        loopEnabled.store (isLooping && endSeconds > startSeconds);
+    }
+
+    /** When disabled, beginBlock() always asks for live rendering (e.g. the track has live input). */
+    void setEnabled (bool shouldBeEnabled) noexcept   { enabled.store (shouldBeEnabled); }
+    bool isEnabled() const noexcept                   { return enabled.load(); }
+
+    /** How far ahead of the playhead to render (clamped to 0.1 .. maxLookaheadSeconds). */
+    void setLookaheadSeconds (double seconds) noexcept
+    {
+        lookaheadSeconds.store (juce::jlimit (0.1, maxLookaheadSeconds, seconds));
+    }
+
+    double getLookaheadSeconds() const noexcept { return lookaheadSeconds.load(); }
+
+    /** Mirrors the plugin's voice settings onto the worker's synth (any thread). */
+    void setPolyphony (int numVoices) noexcept                        { synth.setPolyphony (numVoices); }
+    void setSilenceDetection (float thresholdDb, int holdSamples) noexcept { synth.setSilenceDetection (thresholdDb, holdSamples); }
+
+    /** Blocks the buffer couldn't supply in time and that fell back to live rendering. */
+    juce::uint64 getNumUnderruns() const noexcept { return underruns.load (std::memory_order_relaxed); }
+
+    /** True while the audio thread is playing from the buffer. */
+    bool isPlayingFromBuffer() const noexcept { return readingFlag.load (std::memory_order_relaxed); }
+
+    //==============================================================================
+    // Audio thread
+    //------------------------------------------------------------------------------
+
+    /**
+     * @brief Decide how the block at @p editStart is rendered.
+     *
+     * @return The number of leading samples in which MIDI note-ons still go to
+     *         the plugin's live synth. Note-ons at or after that offset are in
+     *         the buffer and must be dropped; other events always go to the live
+     *         synth (it finishes the notes it started). Returns @p numSamples
+     *         when the whole block is live.
+     */
+    int beginBlock (juce::int64 editStart, int numSamples, bool isPlaying, const MorphParamSnapshot& params) noexcept
+    {
+        audio.blockCount = 0;
+        updateParams (params, numSamples);
+
+        if (! enabled.load() || ! isPlaying || capacity == 0 || numSamples > maxBlock)
+        {
+            if (! isPlaying)
+                forgetBufferNotes();   // stopped: every note has ended
+            else if (audio.reading || audio.claimUntil > audio.claimFrom)
+                handBackNotes();
+
+            setReading (false);
+            audio.resyncPending = false;
+            return numSamples;
+        }
+
+        // The buffer has the old values: play live until they settle, then resync with the new ones
+        if (audio.paramsMoving)
+        {
+            if (audio.reading || audio.claimUntil > audio.claimFrom)
+                handBackNotes();
+
+            audio.resyncPending = false;
+            return numSamples;
+        }
+
+        const auto gen = generation.load();
+        const auto loop = currentLoop();
+
+        if (audio.reading && (gen != audio.generation || editStart != audio.expectedEdit || loop != audio.loop))
+        {
+            setReading (false);   // jumped, loop changed, or the worker resynced
+            audio.resyncPending = false;
+            forgetBufferNotes();
+        }
+        else if (audio.reading && validEnd.load() < audio.stream + numSamples)
+        {
+            stopReadingAfterUnderrun (editStart);   // this block isn't rendered yet: play it live
+        }
+
+        if (! audio.reading)
+        {
+            if (audio.resyncPending && gen == audio.requested)
+            {
+                const auto origin = published.origin.load();
+
+                const bool rendered = validEnd.load() >= editStart + numSamples - origin;
+
+                if (origin >= editStart && origin < editStart + numSamples && rendered)
+                {
+                    audio.generation = gen;
+                    audio.stream     = 0;
+                    audio.origin     = origin;
+                    audio.loop       = { published.looping.load(), published.loopStart.load(), published.loopEnd.load() };
+                    audio.resyncPending = false;
+                    audio.claimFrom = audio.claimUntil = 0;
+                    setReading (true);
+
+                    const int split = (int) (origin - editStart);
+                    audio.blockStream = 0;
+                    audio.blockOffset = split;
+                    audio.blockCount  = numSamples - split;
+                    return split;
+                }
+
+                if (origin < editStart + numSamples || loop != LoopState { published.looping.load(), published.loopStart.load(), published.loopEnd.load() })
+                    audio.resyncPending = false;   // missed it, or the loop changed since; ask again below
+            }
+
+            if (! audio.resyncPending)
+            {
+                for (size_t i = 0; i < audio.params.values.size(); ++i)
+                    latestParams[i].store (audio.params.values[i], std::memory_order_relaxed);
+
+                audio.requested = requestedGeneration.load() + 1;
+                requestedOrigin.store (editStart + (juce::int64) std::llround (resyncLeadSeconds * sampleRate));
+                requestedClaimFrom.store (audio.claimFrom);
+                requestedClaimUntil.store (audio.claimUntil);
+                requestedGeneration.store (audio.requested);
+                audio.resyncPending = true;
+            }
+
+            return numSamples;
+        }
+
+        audio.blockStream = audio.stream;
+        audio.blockOffset = 0;
+        audio.blockCount  = numSamples;
+        return 0;
+    }
+
+    /**
+     * @brief Add the pre-rendered part of the block (as decided by beginBlock) to @p dest.
+     *
+     * Call after the live synth has rendered into @p dest. beginBlock() only
+     * hands a block to the buffer once it is rendered; if the stream was
+     * replaced since, nothing is added and the next block resyncs.
+     */
+    void addPrerendered (juce::AudioBuffer<float>& dest, int startSample, int numSamples) noexcept
+    {
+        if (audio.blockCount <= 0)
+            return;
+
+        const auto from = audio.blockStream;
+        const int  count = juce::jmin (audio.blockCount, numSamples - audio.blockOffset);
+
+        // The worker lowers validEnd before rewriting, then waits while we're busy
+        readerBusy.store (true);
+        const bool ok = generation.load() == audio.generation && validEnd.load() >= from + count;
+
+        if (ok)
+        {
+            const int pos   = (int) (from % capacity);
+            const int first = juce::jmin (count, capacity - pos);
+            const int destStart = startSample + audio.blockOffset;
+
+            for (int ch = 0; ch < dest.getNumChannels(); ++ch)
+            {
+                const int src = juce::jmin (ch, ring.getNumChannels() - 1);
+                dest.addFrom (ch, destStart, ring, src, pos, first);
+
+                if (first < count)
+                    dest.addFrom (ch, destStart + first, ring, src, 0, count - first);
+            }
+
+            audio.stream = from + count;
+            readStream.store (audio.stream, std::memory_order_release);   // before releasing readerBusy, so a resync wins
+        }
+
+        readerBusy.store (false);
+
+        if (! ok)
+        {
+            stopReadingAfterUnderrun (streamToEdit (from, audio.origin, audio.loop) + count);
+            return;
+        }
+
+        audio.expectedEdit = streamToEdit (audio.stream, audio.origin, audio.loop);
+    }
+
+    /**
+     * @brief Follow the notes the buffer is playing; call with each of the block's clip MIDI events.
+     *
+     * @p playedByBuffer is true for the note-ons beginBlock() said to drop. If
+     * playback later goes live mid-stream, addHandedBackNotes() restarts them.
+     */
+    void trackNote (const juce::MidiMessage& m, bool playedByBuffer) noexcept
+    {
+        const int channel = m.getChannel();
+        if (channel < 1)
+            return;
+
+        auto* velocities = audio.heldByBuffer.data() + (channel - 1) * 128;
+
+        if (m.isNoteOn())
+        {
+            if (playedByBuffer)
+                velocities[m.getNoteNumber()] = m.getFloatVelocity();
+        }
+        else if (m.isNoteOff())
+        {
+            velocities[m.getNoteNumber()] = 0.0f;
+        }
+        else if (m.isAllNotesOff() || m.isAllSoundOff())
+        {
+            std::fill (velocities, velocities + 128, 0.0f);
+        }
+    }
+
+    /**
+     * @brief If playback just went live mid-stream, add note-ons at @p samplePosition
+     *        for the notes the buffer was playing, so the live synth carries them on.
+     *
+     * Call after trackNote() has seen the block's events, so notes ending in it are left out.
+     */
+    void addHandedBackNotes (juce::MidiBuffer& liveMidi, int samplePosition)
+    {
+        if (! audio.handBack)
+            return;
+
+        audio.handBack = false;
+
+        for (size_t i = 0; i < audio.heldByBuffer.size(); ++i)
+        {
+            if (audio.heldByBuffer[i] > 0.0f)
+            {
+                liveMidi.addEvent (juce::MidiMessage::noteOn ((int) i / 128 + 1, (int) i % 128, audio.heldByBuffer[i]),
+                                   samplePosition);
+                audio.heldByBuffer[i] = 0.0f;
+            }
+        }
+    }
+
+    //==============================================================================
+    // Worker
+    //------------------------------------------------------------------------------
+
+    /**
+     * @brief Handle pending resyncs/refreshes and render until the buffer is full.
+     *
+     * Runs on the worker thread (tests call it directly).
+     * @return true if there is more to render right away.
+     */
+    bool renderAhead()
+    {
+        if (capacity == 0)
+            return false;
+
+        updateEvents();
+
+        const auto wanted = requestedGeneration.load();
+        if (wanted != workerGeneration)
+            resync (wanted);
+
+        if (refreshRequested.exchange (false) && workerGeneration != 0)
+            refresh();
+
+        if (workerGeneration == 0)
+            return false;   // nothing asked for yet
+
+        const auto target = readStream.load (std::memory_order_acquire)
+                          + (juce::int64) std::llround (lookaheadSeconds.load() * sampleRate);
+        const auto limit  = juce::jmin (target, readStream.load (std::memory_order_acquire) + capacity - maxBlock);
+
+        const auto sliceEnd = juce::Time::getMillisecondCounterHiRes() + 5.0;
+
+        while (writeStream < limit)
+        {
+            renderChunk ((int) juce::jmin ((juce::int64) chunkSize, limit - writeStream));
+
+            if (juce::Time::getMillisecondCounterHiRes() > sliceEnd)
+                return true;
+        }
+
+        return false;
+    }
+
+    //==============================================================================
+    /** Loop range in edit samples. */
+    struct LoopState
+    {
+        bool looping = false;
+        juce::int64 start = 0, end = 0;
+
+        bool operator== (const LoopState& o) const noexcept
+        {
+            return looping == o.looping && (! looping || (start == o.start && end == o.end));
+        }
+
+        bool operator!= (const LoopState& o) const noexcept { return ! operator== (o); }
+    };
+
+    /** Map a stream position to an edit sample, wrapping at the loop end once the stream reaches it. */
+    static juce::int64 streamToEdit (juce::int64 stream, juce::int64 origin, const LoopState& loop) noexcept
+    {
+        const auto pos = origin + stream;
+
+        if (! loop.looping || origin >= loop.end || pos < loop.end)
+            return pos;
+
+        const auto length = loop.end - loop.start;
+        return loop.start + (pos - loop.end) % length;
+    }
+
+private:
+    //==============================================================================
+    struct Sound : juce::SynthesiserSound
+    {
+        bool appliesToNote (int) override    { return true; }
+        bool appliesToChannel (int) override { return true; }
+    };
+
+    /** A note-on/off at an edit sample; note-offs sort before note-ons at the same sample. */
+    struct Event
+    {
+        juce::int64 sample = 0;
+        juce::int64 noteStart = 0;   ///< When the note started (for both halves).
+        int channel = 1, noteNumber = 60;
+        float velocity = 0.0f;       ///< Note-on velocity (for both halves).
+        bool isNoteOn = false;
+
+        bool operator< (const Event& other) const noexcept
+        {
+            if (sample != other.sample)
+                return sample < other.sample;
+            return ! isNoteOn && other.isNoteOn;
+        }
+    };
+
+    /** Shared worker threads (a few, high priority) that every instance is spread over. */
+    struct Workers
+    {
+        Workers()
+        {
+            const int n = juce::jlimit (1, 4, juce::SystemStats::getNumCpus() / 2);
+
+            for (int i = 0; i < n; ++i)
+            {
+                auto* t = threads.add (new juce::TimeSliceThread ("Morph Look-ahead " + juce::String (i + 1)));
+                t->startThread (juce::Thread::Priority::high);
+            }
+        }
+
+        ~Workers()
+        {
+            for (auto* t : threads)
+                t->stopThread (2000);
+        }
+
+        juce::TimeSliceThread& next() { return *threads[(int) (counter++ % (unsigned) threads.size())]; }
+
+        juce::OwnedArray<juce::TimeSliceThread> threads;
+        std::atomic<unsigned> counter { 0 };
+    };
+
+    //==============================================================================
+    int useTimeSlice() override
+    {
+        return renderAhead() ? 0 : 2;
+    }
+
+    LoopState currentLoop() const noexcept
+    {
+        if (! loopEnabled.load())
+            return {};
+
+        return { true,
+                 (juce::int64) std::llround (loopStartSeconds.load() * sampleRate),
+                 (juce::int64) std::llround (loopEndSeconds.load() * sampleRate) };
+    }
+
+    void setReading (bool shouldRead) noexcept
+    {
+        audio.reading = shouldRead;
+        readingFlag.store (shouldRead, std::memory_order_relaxed);
+    }
+
+    /**
+     * Audio thread: the buffer can't supply the block, so playback goes live
+     * from edit sample @p liveFrom. The live synth never got the note-ons the
+     * buffer played, so the next stream takes over the ones that started
+     * since this stream's origin (or the loop start, once it has wrapped).
+     */
+    void stopReadingAfterUnderrun (juce::int64 liveFrom) noexcept
+    {
+        underruns.fetch_add (1, std::memory_order_relaxed);
+
+        const bool wrapped = audio.loop.looping && audio.origin < audio.loop.end
+                              && audio.origin + audio.stream >= audio.loop.end;
+        audio.claimFrom  = wrapped ? audio.loop.start : audio.origin;
+        audio.claimUntil = liveFrom;
+
+        setReading (false);
+        audio.resyncPending = false;
+    }
+
+    /**
+     * Audio thread: playback goes live mid-stream (parameters moved, or look-ahead
+     * was disabled). The live synth restarts the notes the buffer was playing
+     * (addHandedBackNotes), so the next stream has nothing to take over.
+     */
+    void handBackNotes() noexcept
+    {
+        setReading (false);
+        audio.resyncPending = false;
+        audio.claimFrom = audio.claimUntil = 0;
+        audio.handBack = true;
+    }
+
+    /** Audio thread: the notes the buffer was playing have ended (stop or jump). */
+    void forgetBufferNotes() noexcept
+    {
+        audio.claimFrom = audio.claimUntil = 0;
+        audio.handBack = false;
+        audio.heldByBuffer.fill (0.0f);
+    }
+
+    /** Audio thread: note when the parameters last changed. The first snapshot after prepare() isn't a change. */
+    void updateParams (const MorphParamSnapshot& params, int numSamples) noexcept
+    {
+        if (! audio.hasParams || params.values != audio.params.values)
+        {
+            audio.paramsMoving = audio.hasParams;
+            audio.hasParams    = true;
+            audio.params       = params;
+            audio.paramsStill  = 0;
+        }
+        else if (audio.paramsMoving)
+        {
+            audio.paramsStill += numSamples;
+            audio.paramsMoving = audio.paramsStill < (juce::int64) std::llround (paramSettleSeconds * sampleRate);
+        }
+    }
+
+    /** Worker: take the parameters the audio thread stored with its last resync request. */
+    void loadParams() noexcept
+    {
+        for (size_t i = 0; i < workerParams.values.size(); ++i)
+            workerParams.values[i] = latestParams[i].load (std::memory_order_relaxed);
+    }
+
+    /** Worker: rebuild the sorted event list if the notes changed. */
+    void updateEvents()
+    {
+        std::vector<Note> notes;
+
+        {
+            const juce::ScopedLock sl (notesLock);
+            if (notesVersion == notesVersionSeen)
+                return;
+
+            notesVersionSeen = notesVersion;
+            notes = pendingNotes;
+        }
+
+        events.clear();
+        events.reserve (notes.size() * 2);
+
+        for (const auto& n : notes)
+        {
+            const auto on  = (juce::int64) std::llround (n.startSeconds * sampleRate);
+            const auto off = juce::jmax (on + 1, (juce::int64) std::llround (n.endSeconds * sampleRate));
+
+            events.push_back ({ on,  on, n.channel, n.noteNumber, n.velocity, true });
+            events.push_back ({ off, on, n.channel, n.noteNumber, n.velocity, false });
+        }
+
+        std::sort (events.begin(), events.end());
+    }
+
+    size_t firstEventAt (juce::int64 editSample) const
+    {
+        Event probe;
+        probe.sample = editSample;
+        return (size_t) (std::lower_bound (events.begin(), events.end(), probe,
+                                           [] (const Event& a, const Event& b) { return a.sample < b.sample; })
+                         - events.begin());
+    }
+
+    /**
+     * Notes that started before the stream origin belong to the live synth, until
+     * the first loop wrap; except those a previous stream played and handed over.
+     */
+    bool ownsNote (juce::int64 noteStart, juce::int64 stream) const noexcept
+    {
+        const bool wrapped = stream > 0 && loop.looping && origin < loop.end && origin + stream >= loop.end;
+        return wrapped || noteStart >= origin || (noteStart >= claimFrom && noteStart < claimUntil);
+    }
+
+    /** Invalidate everything from stream position @p from, waiting out any read in progress. */
+    void truncateTo (juce::int64 from)
+    {
+        validEnd.store (from);
+
+        while (readerBusy.load())
+            juce::Thread::yield();
+
+        writeStream = from;
+    }
+
+    void killAllVoices()
+    {
+        for (int ch = 1; ch <= 16; ++ch)
+            synth.allNotesOff (ch, false);
+    }
+
+    /** Worker: start a new stream at the position the audio thread asked for. */
+    void resync (int wanted)
+    {
+        truncateTo (0);
+        generation.store (0);   // audio thread stops reading until the new stream is published
+
+        loop   = currentLoop();
+        origin = requestedOrigin.load();
+        claimFrom  = requestedClaimFrom.load();
+        claimUntil = requestedClaimUntil.load();
+
+        // Keep note-ons clear of the hand-over point, so rounding can't give a note to both synths (or neither)
+        for (auto i = firstEventAt (origin - handoverGuard); i < events.size() && events[i].sample <= origin + handoverGuard; ++i)
+            if (events[i].isNoteOn)
+                origin = events[i].sample + handoverGuard + 1;
+
+        killAllVoices();
+        loadParams();
+        prerollHeldNotes (origin, 0);
+
+        published.origin.store (origin);
+        published.looping.store (loop.looping);
+        published.loopStart.store (loop.start);
+        published.loopEnd.store (loop.end);
+
+        readStream.store (0);
+        workerGeneration = wanted;
+        refreshRequested.store (false);
+        generation.store (wanted);
+    }
+
+    /** Worker: keep a short margin of rendered audio and re-render the rest, pre-rolling held notes. */
+    void refresh()
+    {
+        const auto margin = (juce::int64) std::llround (refreshMarginSeconds * sampleRate);
+        const auto from   = juce::jmin (writeStream, readStream.load (std::memory_order_acquire) + margin);
+
+        truncateTo (from);
+        killAllVoices();
+        prerollHeldNotes (streamToEdit (from, origin, loop), from);
+    }
+
+    /** Worker: render (and discard) the owned notes held at @p editPos, so voices arrive there in the right state. */
+    void prerollHeldNotes (juce::int64 editPos, juce::int64 from)
+    {
+        const auto maxPreroll = (juce::int64) std::llround (maxPrerollSeconds * sampleRate);
+
+        // Earliest note this stream owns that is still held at editPos
+        auto prerollStart = editPos;
+
+        for (const auto& e : events)
+        {
+            if (e.isNoteOn || e.sample <= editPos || e.noteStart >= editPos)
+                continue;
+
+            if (ownsNote (e.noteStart, from))
+                prerollStart = juce::jmin (prerollStart, juce::jmax (e.noteStart, editPos - maxPreroll));
+        }
+
+        // Notes held for longer than the pre-roll restart at its first sample
+        chaseNotes.clear();
+
+        for (const auto& e : events)
+            if (! e.isNoteOn && e.sample > prerollStart && e.noteStart < prerollStart && ownsNote (e.noteStart, from))
+                chaseNotes.push_back (e);
+
+        // Render from the earliest held note
+        nextEvent = firstEventAt (prerollStart);
+
+        for (auto pos = prerollStart; pos < editPos;)
+        {
+            const int len = (int) juce::jmin ((juce::int64) chunkSize, editPos - pos);
+            renderSynth (pos, len, from);
+            pos += len;
+        }
+
+        nextEvent = firstEventAt (editPos);
+    }
+
+    /** Render @p numSamples of the synth starting at @p editPos into chunkBuffer. */
+    void renderSynth (juce::int64 editPos, int numSamples, juce::int64 stream)
+    {
+        chunkMidi.clear();
+
+        for (const auto& e : chaseNotes)
+            chunkMidi.addEvent (juce::MidiMessage::noteOn (e.channel, e.noteNumber, e.velocity), 0);
+
+        chaseNotes.clear();
+
+        while (nextEvent < events.size() && events[nextEvent].sample < editPos + numSamples)
+        {
+            const auto& e = events[nextEvent++];
+            const int offset = (int) juce::jmax ((juce::int64) 0, e.sample - editPos);
+
+            if (e.isNoteOn)
+            {
+                if (ownsNote (e.noteStart, stream))
+                    chunkMidi.addEvent (juce::MidiMessage::noteOn (e.channel, e.noteNumber, e.velocity), offset);
+            }
+            else
+            {
+                chunkMidi.addEvent (juce::MidiMessage::noteOff (e.channel, e.noteNumber), offset);
+            }
+        }
+
+        chunkBuffer.clear (0, numSamples);
+        synth.renderNextBlock (chunkBuffer, chunkMidi, 0, numSamples);
+    }
+
+    /** Worker: render the next chunk of the stream into the ring and publish it. */
+    void renderChunk (int maxSamples)
+    {
+        const auto editPos = streamToEdit (writeStream, origin, loop);
+        int len = maxSamples;
+
+        const bool beforeLoopEnd = loop.looping && origin < loop.end && editPos < loop.end;
+        if (beforeLoopEnd)
+            len = (int) juce::jmin ((juce::int64) len, loop.end - editPos);
+
+        renderSynth (editPos, len, writeStream);
+        chunkBuffer.applyGain (0, len, juce::Decibels::decibelsToGain (workerParams.get (MorphParam::gain)));
+
+        const int pos   = (int) (writeStream % capacity);
+        const int first = juce::jmin (len, capacity - pos);
+
+        for (int ch = 0; ch < ring.getNumChannels(); ++ch)
+        {
+            ring.copyFrom (ch, pos, chunkBuffer, ch, 0, first);
+
+            if (first < len)
+                ring.copyFrom (ch, 0, chunkBuffer, ch, first, len - first);
+        }
+
+        writeStream += len;
+        validEnd.store (writeStream, std::memory_order_release);
+
+        // Playback ends held notes at the loop end; do the same, then carry on from the loop start
+        if (beforeLoopEnd && editPos + len == loop.end)
+        {
+            for (int ch = 1; ch <= 16; ++ch)
+                synth.allNotesOff (ch, true);
+
+            nextEvent = firstEventAt (loop.start);
+        }
+    }
+
+    //==============================================================================
+    // Shared with the audio thread
+    std::atomic<bool> enabled { true };
+    std::atomic<double> lookaheadSeconds { defaultLookaheadSeconds };
+
+    std::atomic<int> generation { 0 };             ///< Worker: stream currently in the ring (0 = none)
+    std::atomic<int> requestedGeneration { 0 };    ///< Audio: stream it wants next
+    std::atomic<juce::int64> requestedOrigin { 0 };
+    std::atomic<juce::int64> requestedClaimFrom { 0 }, requestedClaimUntil { 0 };   ///< Audio: notes the next stream takes over
+    std::atomic<juce::int64> validEnd { 0 };       ///< Worker: stream samples rendered so far
+    std::atomic<juce::int64> readStream { 0 };     ///< Audio: stream samples consumed so far
+    std::atomic<bool> readerBusy { false };
+    std::atomic<bool> readingFlag { false };
+    std::atomic<juce::uint64> underruns { 0 };
+
+    struct
+    {
+        std::atomic<juce::int64> origin { 0 }, loopStart { 0 }, loopEnd { 0 };
+        std::atomic<bool> looping { false };
+    } published;                                   ///< Stream layout, written before generation is stored
+
+    std::array<std::atomic<float>, MorphParams::numParams> latestParams {};   ///< Audio: parameters for the requested stream
+
+    // Message thread -> worker / audio thread
+    std::atomic<bool> refreshRequested { false };
+    std::atomic<bool> loopEnabled { false };
+    std::atomic<double> loopStartSeconds { 0.0 }, loopEndSeconds { 0.0 };
+
+    juce::CriticalSection notesLock;               ///< Message thread and worker only
+    std::vector<Note> pendingNotes;
+    int notesVersion = 0;
+
+    //==============================================================================
+    // Worker only
+    MorphSynthesiser synth;
+    MorphParamSnapshot workerParams;
+    juce::AudioBuffer<float> chunkBuffer;
+    juce::MidiBuffer chunkMidi;
+    std::vector<Event> events;
+    std::vector<Event> chaseNotes;                 ///< Note-offs of notes to restart at the next render
+    size_t nextEvent = 0;
+    int notesVersionSeen = -1;
+    int workerGeneration = 0;
+    juce::int64 writeStream = 0;
+    juce::int64 origin = 0;
+    juce::int64 claimFrom = 0, claimUntil = 0;     ///< Note starts handed over from the previous stream
+    LoopState loop;
+
+    //==============================================================================
+    // Audio thread only
+    struct AudioState
+    {
+        bool reading = false, resyncPending = false;
+        int generation = 0, requested = 0;
+        juce::int64 origin = 0, stream = 0, expectedEdit = 0;
+        juce::int64 claimFrom = 0, claimUntil = 0;     ///< Set by an underrun, for the next resync request
+        LoopState loop;
+        MorphParamSnapshot params;
+        bool hasParams = false, paramsMoving = false;
+        juce::int64 paramsStill = 0;                   ///< Samples since the parameters last changed
+        std::array<float, 16 * 128> heldByBuffer {};   ///< Velocity of notes the buffer is playing, by channel and note
+        bool handBack = false;                         ///< Restart heldByBuffer in the live synth this block
+        juce::int64 blockStream = 0;
+        int blockOffset = 0, blockCount = 0;
+    } audio;
+
+    //==============================================================================
+    double sampleRate = 0.0;
+    int maxBlock = 0, capacity = 0;
+    juce::AudioBuffer<float> ring;
+
+    juce::SharedResourcePointer<Workers> workers;
+    juce::TimeSliceThread* worker = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MorphLookahead)
+};
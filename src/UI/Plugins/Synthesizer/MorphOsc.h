@@ -8,6 +8,8 @@
 //  - Per-sample morph blend between A and B (0..1)
 //  - Pulse width for pulse waveform (clamped 0.05..0.95)
 //  - Simple phase-accumulator oscillator with normalized phase [0, 1)
+//  - Band-limited mode (default): PolyBLEP saw/pulse, table sine, and
+//    mip-mapped triangle from the shared MorphWavetables bank
 //
 // Notes:
 //  - Call prepare(sampleRate) before use.
@@ -17,6 +19,7 @@
 
 #pragma once
 #include <juce_dsp/juce_dsp.h>
+#include "MorphWavetables.h"
 
 /**
  * @brief Simple morphing oscillator (two wave sources crossfaded by @c morph).
@@ -52,6 +55,7 @@ struct MorphOsc
     void prepare (double sr)
     {
         sampleRate = sr;
+        tables = &MorphWavetables::get(); // builds the shared bank off the audio thread
         setFrequency (freqHz); // refresh phaseInc with the new sample rate
     }
 
@@ -66,8 +70,9 @@ struct MorphOsc
      */
     void setFrequency (double hz)
     {
-        freqHz   = hz;
-        phaseInc = hz / sampleRate;
+        freqHz     = hz;
+        phaseInc   = hz / sampleRate;
+        tableLevel = MorphWavetables::levelForIncrement (phaseInc);
     }
 
     /**
@@ -107,6 +112,15 @@ struct MorphOsc
         pulseWidth = juce::jlimit (0.05f, 0.95f, pw);
     }
 
+    /**
+     * @brief Choose band-limited (default) or naive waveform generation.
+     *
+     * Naive mode reproduces the original trivial waveforms (and std::sin for
+     * the sine); it aliases audibly on high notes.
+     */
+    void setBandLimited (bool shouldBeBandLimited) { bandLimited = shouldBeBandLimited; }
+    bool isBandLimited() const noexcept             { return bandLimited; }
+
     //==============================================================================
     // Synthesis
     //------------------------------------------------------------------------------
@@ -127,6 +141,18 @@ struct MorphOsc
         return wa * (1.0f - morph) + wb * morph;
     }
 
+    /**
+     * @brief Render @p numSamples consecutive samples into @p dest.
+     *
+     * Equivalent to calling next() @p numSamples times with the current
+     * frequency, morph and pulse width.
+     */
+    void renderBlock (float* dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = next();
+    }
+
 private:
     //==============================================================================
     // Helpers
@@ -139,6 +165,9 @@ private:
      */
     float oscSample (int type) const
     {
+        if (bandLimited && tables != nullptr)
+            return bandLimitedSample (type);
+
         const float x = (float) phase;
 
         switch (type)
@@ -168,6 +197,65 @@ private:
         }
     }
 
+    /**
+     * @brief Band-limited version of oscSample().
+     *
+     * Sine and triangle come from the shared tables; saw and pulse are the
+     * naive shapes with a PolyBLEP residual subtracted at each discontinuity.
+     */
+    float bandLimitedSample (int type) const
+    {
+        switch (type)
+        {
+            case Sine:
+                return tables->sine (phase);
+
+            case Triangle:
+                return tables->triangle (phase, tableLevel);
+
+            case Saw:
+                return (float) (2.0 * phase - 1.0 - polyBlep (phase, phaseInc));
+
+            case Pulse:
+            {
+                // Rising edge at phase 0, falling edge at pulseWidth
+                double fall = phase + 1.0 - pulseWidth;
+                if (fall >= 1.0)
+                    fall -= 1.0;
+
+                const double naive = (phase < pulseWidth) ? 1.0 : -1.0;
+                return (float) (naive + polyBlep (phase, phaseInc) - polyBlep (fall, phaseInc));
+            }
+
+            default:
+                return 0.0f;
+        }
+    }
+
+    /**
+     * @brief Two-sample polynomial band-limited step residual.
+     * @param t  Phase [0, 1) relative to the discontinuity.
+     * @param dt Phase increment per sample.
+     */
+    static double polyBlep (double t, double dt) noexcept
+    {
+        dt = juce::jmin (dt, 0.5);
+
+        if (t < dt)
+        {
+            t /= dt;
+            return t + t - t * t - 1.0;
+        }
+
+        if (t > 1.0 - dt)
+        {
+            t = (t - 1.0) / dt;
+            return t * t + t + t + 1.0;
+        }
+
+        return 0.0;
+    }
+
     //==============================================================================
     // State
     //------------------------------------------------------------------------------
@@ -185,4 +273,9 @@ private:
     // Wave selections (defaults: A=Sine, B=Saw to match original)
     int typeA         = (int) Sine;
     int typeB         = (int) Saw;
+
+    // Band-limited mode
+    bool bandLimited  = true;
+    int tableLevel    = 0;     // mip level for phaseInc (see MorphWavetables)
+    const MorphWavetables* tables = nullptr; // shared bank (set in prepare)
 };
\ No newline at end of file
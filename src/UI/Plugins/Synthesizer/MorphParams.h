@@ -0,0 +1,75 @@
+// ==============================================================================
+// MorphParams.h
+// ------------------------------------------------------------------------------
+// Compile-time parameter indices and the per-block parameter snapshot shared by
+// MorphSynthPlugin and its voices.
+//
+// Notes:
+//  - The plugin fills one MorphParamSnapshot per block; every voice reads it
+//    directly by enum index (no string lookups, no atomic loads per voice).
+//  - Enum order matches paramIDs below; keep the two in sync.
+// ==============================================================================
+
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+/** Index of every Morph Synth parameter (values match paramIDs order). */
+enum class MorphParam : int
+{
+    morph, oscAType, oscBType, pulseWidth,
+    filterType, cutoff, resonance,
+    aA, dA, sA, rA,
+    aF, dF, sF, rF, fEnvAmt,
+    semi, fine, glide,
+    lfoTarget, lfoRate, lfoDepth,
+    keyTrack,
+    gain,
+    oscQuality,
+
+    count
+};
+
+namespace MorphParams
+{
+    inline constexpr std::size_t numParams = (std::size_t) MorphParam::count;
+
+    /** Parameter IDs as registered with Tracktion (and used in saved state). */
+    inline constexpr std::array<const char*, numParams> paramIDs {
+        "morph", "oscAType", "oscBType", "pulseWidth",
+        "filterType", "cutoff", "resonance",
+        "aA", "dA", "sA", "rA",
+        "aF", "dF", "sF", "rF", "fEnvAmt",
+        "semi", "fine", "glide",
+        "lfoTarget", "lfoRate", "lfoDepth",
+        "keyTrack",
+        "gain",
+        "oscQuality"
+    };
+
+    inline constexpr const char* getID (MorphParam p) noexcept { return paramIDs[(std::size_t) p]; }
+
+    /** True for discrete (choice) parameters, read through MorphParamSnapshot::choice(). */
+    inline constexpr bool isChoice (MorphParam p) noexcept
+    {
+        return p == MorphParam::oscAType || p == MorphParam::oscBType
+            || p == MorphParam::filterType || p == MorphParam::lfoTarget
+            || p == MorphParam::oscQuality;
+    }
+}
+
+/**
+ * @brief Plain copy of all parameter values for one block.
+ *
+ * Trivially copyable; missing parameters read as 0 (matching the old
+ * ParamsView behaviour).
+ */
+struct MorphParamSnapshot
+{
+    std::array<float, MorphParams::numParams> values {};
+
+    float get (MorphParam p) const noexcept          { return values[(std::size_t) p]; }
+    int   choice (MorphParam p) const noexcept       { return (int) std::lround (values[(std::size_t) p]); }
+    void  set (MorphParam p, float v) noexcept       { values[(std::size_t) p] = v; }
+};
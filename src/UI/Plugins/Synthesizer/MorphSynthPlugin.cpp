@@ -5,6 +5,9 @@
 // ==============================================================================
 
 #include "MorphSynthPlugin.h"
+#include <functional>
+
+namespace t = tracktion;
 
 //------------------------------------------------------------------------------
 // Local sound type for JUCE Synthesiser
@@ -73,6 +76,8 @@ namespace
 
 } // namespace
 
+static const juce::Identifier polyphonyID ("polyphony");
+
 //==============================================================================
 // Construction / destruction
 //==============================================================================
@@ -87,6 +92,8 @@ MorphSynthPlugin::MorphSynthPlugin (const te::PluginCreationInfo& info)
     oscBType   = addChoice(*this, "oscBType",   "Osc B",
                            juce::StringArray{ "Sine","Triangle","Saw","Pulse" }, 2);
     pulseWidth = addFloat (*this, "pulseWidth", "Pulse Width", 0.05f,  0.95f,   0.5f);
+    oscQuality = addChoice(*this, "oscQuality", "Osc Quality",
+                           juce::StringArray{ "Band-limited","Naive" }, 0);
 
     // --- Filter
     filterType = addChoice(*this, "filterType", "Filter",
@@ -124,19 +131,29 @@ MorphSynthPlugin::MorphSynthPlugin (const te::PluginCreationInfo& info)
     // --- Output
     gain = addFloat (*this, "gain", "Output", -24.f, 6.f, 0.f);
 
-    // --- Synth voices/sounds
-    for (int i = 0; i < numVoices; ++i)
-        synth.addVoice (new MorphVoice());
+    buildParamTable();
+
+    // --- Synth sounds (voices are pre-allocated by MorphSynthesiser)
+    polyphonyValue.referTo (state, polyphonyID, getUndoManager(), defaultPolyphony);
+    synth.setPolyphony (polyphonyValue.get());
     synth.addSound (new MorphSound());
 
-    // Timer available for future smoothing/polling if needed.
+    // Split rendering at every event so notes start on their exact sample.
+    synth.setMinimumRenderingSubdivisions (1);
+
+    // Timer polls state-backed settings (e.g. polyphony after undo).
     startTimerHz (30);
 
     DBG("[MorphSynth] morph=" << (morph ? morph->getCurrentValue() : -1.0f)
     << " cutoff=" << (cutoff ? cutoff->getCurrentValue() : -1.0f));
 }
 
-MorphSynthPlugin::~MorphSynthPlugin() = default;
+MorphSynthPlugin::~MorphSynthPlugin()
+{
+    stopTimer();
+    watchedTrackState.removeListener (this);
+    lookahead.stop();
+}
 
 //==============================================================================
 // te::Plugin lifecycle
@@ -147,17 +164,23 @@ void MorphSynthPlugin::initialise (const te::PluginInitialisationInfo& info)
     const double sr       = info.sampleRate;
     const int    maxBlock = (info.blockSizeSamples > 0 ? (int) info.blockSizeSamples : 512);
 
-    synth.setCurrentPlaybackSampleRate (sr);
     synth.setNoteStealingEnabled (true);
 
-    // Prepare voices with engine parameters/ptrs
-    for (int i = 0; i < synth.getNumVoices(); ++i)
-        if (auto* v = dynamic_cast<MorphVoice*> (synth.getVoice (i)))
-            v->prepare (sr, maxBlock, this);
+    midiScratch.ensureSize (2048);
+
+    // Prepare the whole voice pool with engine parameters/ptrs
+    synth.prepare (sr, maxBlock, &snapshot);
+
+    lookahead.prepare (sr, maxBlock);
+    lookahead.setPolyphony (polyphonyValue.get());
+    lookahead.setSilenceDetection (synth.getSilenceThresholdDb(), synth.getSilenceHoldSamples());
+    notesDirty = true;   // picked up by the timer, on the message thread
+    lookahead.start();
 }
 
 void MorphSynthPlugin::deinitialise()
 {
+    lookahead.stop();
     stopAllNotes();
     // synth.clearSounds();
     synth.setCurrentPlaybackSampleRate (0.0);
@@ -180,17 +203,40 @@ void MorphSynthPlugin::applyToBuffer (const te::PluginRenderContext& rc)
 
     const int start   = rc.bufferStartSample;
     const int numSamp = rc.bufferNumSamples;
+    const double sr = synth.getSampleRate();
 
-    // Collect MIDI
-    juce::MidiBuffer midi;
+    const DspLoadCounter::ScopedTimer loadTimer (dspLoad, numSamp, sr);
+
+    const auto& params = captureParameterSnapshot();
+
+    // Offline renders (export, freeze) always run live; during playback the
+    // look-ahead may already have this block's new notes
+    const int liveNoteOnsUntil = rc.isRendering
+        ? numSamp
+        : lookahead.beginBlock ((juce::int64) std::llround (rc.editTime.getStart().inSeconds() * sr),
+                                numSamp, rc.isPlaying, params);
+
+    // Collect MIDI (timestamps are seconds relative to the start of this block)
+    midiScratch.clear();
     if (auto* mma = rc.bufferForMidiMessages)
-        for (auto& m : *mma)
-            midi.addEvent (m, 0);
+    {
+        addMessagesToBuffer (midiScratch, *mma, sr, start, numSamp, sampleAccurateMidi, liveNoteOnsUntil);
 
-    // Render synth then apply output gain
-    const float g = juce::Decibels::decibelsToGain (gain ? gain->getCurrentValue() : 0.0f);
-    synth.renderNextBlock (*audio, midi, start, numSamp);
+        if (! rc.isRendering)
+            for (auto& m : *mma)
+                lookahead.trackNote (m, timeStampToSampleOffset (m.getTimeStamp(), sr, numSamp) >= liveNoteOnsUntil);
+    }
+
+    // If playback just went live mid-stream, the notes the buffer was playing carry on here
+    if (! rc.isRendering)
+        lookahead.addHandedBackNotes (midiScratch, start);
+
+    // Render synth then apply output gain (pre-rendered audio already has it)
+    const float g = juce::Decibels::decibelsToGain (params.get (MorphParam::gain));
+    synth.renderNextBlock (*audio, midiScratch, start, numSamp);
     audio->applyGain (start, numSamp, g);
+
+    lookahead.addPrerendered (*audio, start, numSamp);
 }
 
 //==============================================================================
@@ -246,18 +292,7 @@ juce::ValueTree MorphSynthPlugin::saveToValueTree()
     auto v = state.getOrCreateChildWithName ("MORPH_SYNTH", nullptr);
     v.removeAllProperties (nullptr); // avoid stale values
 
-    te::AutomatableParameter* params[] = {
-        oscAType, oscBType, morph, pulseWidth,
-        filterType, cutoff, resonance,
-        aA, dA, sA, rA,
-        aF, dF, sF, rF, fEnvAmt,
-        semi, fine, glide,
-        lfoTarget, lfoRate, lfoDepth,
-        keyTrack,
-        gain
-    };
-
-    for (auto* p : params)
+    for (auto* p : paramTable)
         if (p != nullptr)
             v.setProperty (p->paramID, p->getCurrentValue(), nullptr);
 
@@ -271,76 +306,81 @@ void MorphSynthPlugin::restoreFromValueTree (const juce::ValueTree& /*unused*/)
     if (! v.isValid())
         return;
 
-    te::AutomatableParameter* params[] = {
-        oscAType, oscBType, morph, pulseWidth,
-        filterType, cutoff, resonance,
-        aA, dA, sA, rA,
-        aF, dF, sF, rF, fEnvAmt,
-        semi, fine, glide,
-        lfoTarget, lfoRate, lfoDepth,
-        keyTrack,
-        gain
-    };
-
-    for (auto* p : params)
+    for (auto* p : paramTable)
         if (p != nullptr && v.hasProperty (p->paramID))
             p->setParameter ((float) v.getProperty (p->paramID), juce::dontSendNotification);
     // If your AP expects absolute values, setParameter is fine.
     // If it expects normalised, use setCurrentValue instead.
+
+    // Saved before the band-limited oscillators existed: keep the naive ones so old projects sound the same
+    if (oscQuality != nullptr && ! v.hasProperty (oscQuality->paramID))
+        oscQuality->setParameter (1.0f, juce::dontSendNotification);
 }
 
 //==============================================================================
-// MorphVoice::ParamsView (voices read parameter values by string key)
+// Parameter snapshot
 //==============================================================================
 
-float MorphSynthPlugin::get (const juce::String& id) const
+void MorphSynthPlugin::buildParamTable()
 {
-    // Tone
-    if      (id == "morph")       return morph       ? morph->getCurrentValue()       : 0.f;
-    else if (id == "pulseWidth")  return pulseWidth  ? pulseWidth->getCurrentValue()  : 0.f;
-
-    // Filter
-    else if (id == "cutoff")      return cutoff      ? cutoff->getCurrentValue()      : 0.f;
-    else if (id == "resonance")   return resonance   ? resonance->getCurrentValue()   : 0.f;
-
-    // Amp ADSR
-    else if (id == "aA") return aA ? aA->getCurrentValue() : 0.f;
-    else if (id == "dA") return dA ? dA->getCurrentValue() : 0.f;
-    else if (id == "sA") return sA ? sA->getCurrentValue() : 0.f;
-    else if (id == "rA") return rA ? rA->getCurrentValue() : 0.f;
+    auto set = [this] (MorphParam p, te::AutomatableParameter* ap) { paramTable[(size_t) p] = ap; };
+
+    set (MorphParam::morph,      morph);
+    set (MorphParam::oscAType,   oscAType);
+    set (MorphParam::oscBType,   oscBType);
+    set (MorphParam::pulseWidth, pulseWidth);
+    set (MorphParam::filterType, filterType);
+    set (MorphParam::cutoff,     cutoff);
+    set (MorphParam::resonance,  resonance);
+    set (MorphParam::aA, aA);
+    set (MorphParam::dA, dA);
+    set (MorphParam::sA, sA);
+    set (MorphParam::rA, rA);
+    set (MorphParam::aF, aF);
+    set (MorphParam::dF, dF);
+    set (MorphParam::sF, sF);
+    set (MorphParam::rF, rF);
+    set (MorphParam::fEnvAmt,    fEnvAmt);
+    set (MorphParam::semi,       semi);
+    set (MorphParam::fine,       fine);
+    set (MorphParam::glide,      glide);
+    set (MorphParam::lfoTarget,  lfoTarget);
+    set (MorphParam::lfoRate,    lfoRate);
+    set (MorphParam::lfoDepth,   lfoDepth);
+    set (MorphParam::keyTrack,   keyTrack);
+    set (MorphParam::gain,       gain);
+    set (MorphParam::oscQuality, oscQuality);
+
+   #if JUCE_DEBUG
+    for (size_t i = 0; i < paramTable.size(); ++i)
+        jassert (paramTable[i] == nullptr || paramTable[i]->paramID == MorphParams::paramIDs[i]);
+   #endif
+}
 
-    // Filter ADSR + amount
-    else if (id == "aF")      return aF      ? aF->getCurrentValue()      : 0.f;
-    else if (id == "dF")      return dF      ? dF->getCurrentValue()      : 0.f;
-    else if (id == "sF")      return sF      ? sF->getCurrentValue()      : 0.f;
-    else if (id == "rF")      return rF      ? rF->getCurrentValue()      : 0.f;
-    else if (id == "fEnvAmt") return fEnvAmt ? fEnvAmt->getCurrentValue() : 0.f;
+const MorphParamSnapshot& MorphSynthPlugin::captureParameterSnapshot() noexcept
+{
+    for (size_t i = 0; i < paramTable.size(); ++i)
+        snapshot.values[i] = paramTable[i] != nullptr ? paramTable[i]->getCurrentValue() : 0.f;
 
-    // Pitch / glide / key tracking
-    else if (id == "semi")     return semi     ? semi->getCurrentValue()     : 0.f;
-    else if (id == "fine")     return fine     ? fine->getCurrentValue()     : 0.f;
-    else if (id == "glide")    return glide    ? glide->getCurrentValue()    : 0.f;
-    else if (id == "keyTrack") return keyTrack ? keyTrack->getCurrentValue() : 0.f;
+    return snapshot;
+}
 
-    // LFO  **ADD THESE**
-    else if (id == "lfoRate")  return lfoRate  ? lfoRate->getCurrentValue()  : 0.f;
-    else if (id == "lfoDepth") return lfoDepth ? lfoDepth->getCurrentValue() : 0.f;
+//==============================================================================
+// MorphVoice::ParamsView (compatibility shim: string key -> table lookup)
+//==============================================================================
 
-    // Output
-    else if (id == "gain") return gain ? gain->getCurrentValue() : 0.f;
+float MorphSynthPlugin::get (const juce::String& id) const
+{
+    for (size_t i = 0; i < paramTable.size(); ++i)
+        if (id == MorphParams::paramIDs[i])
+            return paramTable[i] != nullptr ? paramTable[i]->getCurrentValue() : 0.f;
 
     return 0.f;
 }
 
-
 int MorphSynthPlugin::choice (const juce::String& id) const
 {
-    if      (id == "oscAType")   return oscAType   ? (int) std::round (oscAType->getCurrentValue())   : 0;
-    else if (id == "oscBType")   return oscBType   ? (int) std::round (oscBType->getCurrentValue())   : 0;
-    else if (id == "filterType") return filterType ? (int) std::round (filterType->getCurrentValue()) : 0;
-    else if (id == "lfoTarget")  return lfoTarget  ? (int) std::round (lfoTarget->getCurrentValue())  : 0;
-
-    return 0;
+    return (int) std::round (get (id));
 }
 
 //==============================================================================
@@ -353,4 +393,227 @@ void MorphSynthPlugin::stopAllNotes()
         synth.allNotesOff (ch, false); // false = kill immediately (no tail)
 }
 
-void MorphSynthPlugin::timerCallback() {}
\ No newline at end of file
+void MorphSynthPlugin::setPolyphony (int numVoices)
+{
+    polyphonyValue = juce::jlimit (1, maxPolyphony, numVoices);
+    synth.setPolyphony (polyphonyValue.get());
+    lookahead.setPolyphony (polyphonyValue.get());
+}
+
+int MorphSynthPlugin::getPolyphony() const
+{
+    return synth.getPolyphony();
+}
+
+void MorphSynthPlugin::setSilenceDetection (float thresholdDb, int holdSamples)
+{
+    synth.setSilenceDetection (thresholdDb, holdSamples);
+    lookahead.setSilenceDetection (thresholdDb, holdSamples);
+}
+
+juce::uint64 MorphSynthPlugin::getNumVoicesEndedEarly() const
+{
+    return synth.getNumVoicesEndedEarly();
+}
+
+void MorphSynthPlugin::resetNumVoicesEndedEarly()
+{
+    synth.resetNumVoicesEndedEarly();
+}
+
+void MorphSynthPlugin::timerCallback()
+{
+    // Pick up state changes made behind our back (undo/redo, edit reload).
+    if (synth.getPolyphony() != polyphonyValue.get())
+    {
+        synth.setPolyphony (polyphonyValue.get());
+        lookahead.setPolyphony (polyphonyValue.get());
+    }
+
+    updateLookahead();
+}
+
+//==============================================================================
+// Look-ahead rendering
+//==============================================================================
+
+void MorphSynthPlugin::setLookaheadEnabled (bool shouldBeEnabled)
+{
+    lookaheadEnabled = shouldBeEnabled;
+    updateLookahead();
+}
+
+namespace
+{
+    /** Hash of everything that maps beats to time: tempo changes (with their curves) and time signatures. */
+    juce::uint64 hashTempoSequence (te::TempoSequence& tempoSequence)
+    {
+        juce::uint64 hash = 17;
+        const auto mix = [&hash] (double value) { hash = hash * 31 + (juce::uint64) std::hash<double>() (value); };
+
+        for (auto* tempo : tempoSequence.getTempos())
+        {
+            mix (tempo->getStartBeat().inBeats());
+            mix (tempo->getBpm());
+            mix (tempo->getCurve());
+        }
+
+        for (auto* sig : tempoSequence.getTimeSigs())
+        {
+            mix (sig->getStartBeat().inBeats());
+            mix (sig->numerator.get());
+            mix (sig->denominator.get());
+        }
+
+        return hash;
+    }
+}
+
+void MorphSynthPlugin::updateLookahead()
+{
+    auto* track = dynamic_cast<te::AudioTrack*> (getOwnerTrack());
+
+    if (track == nullptr)
+    {
+        lookahead.setEnabled (false);
+        return;
+    }
+
+    if (watchedTrackState != track->state)
+    {
+        watchedTrackState.removeListener (this);
+        watchedTrackState = track->state;
+        watchedTrackState.addListener (this);
+        notesDirty = true;
+    }
+
+    auto& transport = edit.getTransport();
+    const auto loopRange = transport.getLoopRange();
+    lookahead.setLoop (transport.looping, loopRange.getStart().inSeconds(), loopRange.getEnd().inSeconds());
+
+    // Notes are stored in beats; any tempo or time signature change can move them in time
+    const auto tempoHash = hashTempoSequence (edit.tempoSequence);
+    if (tempoHash != notesTempoHash)
+    {
+        notesTempoHash = tempoHash;
+        notesDirty = true;
+    }
+
+    if (notesDirty)
+    {
+        notesDirty = false;
+
+        std::vector<MorphLookahead::Note> notes;
+        clipsCanPrerender = collectClipNotes (*track, notes);
+        lookahead.setNotes (std::move (notes));
+    }
+
+    // Live input goes straight to the synth, so the buffer must not also play clip notes;
+    // automation changes the sound at every position, which a stream rendered with one
+    // parameter snapshot can't follow
+    lookahead.setEnabled (lookaheadEnabled && clipsCanPrerender && ! hasLiveInput (*track) && ! hasAutomatedParameter());
+}
+
+bool MorphSynthPlugin::hasAutomatedParameter() const
+{
+    for (auto* p : paramTable)
+        if (p != nullptr && p->isAutomationActive())
+            return true;
+
+    return false;
+}
+
+bool MorphSynthPlugin::collectClipNotes (te::AudioTrack& track, std::vector<MorphLookahead::Note>& notes)
+{
+    auto& grooves = track.edit.engine.getGrooveTemplateManager();
+
+    for (auto* clip : track.getClips())
+    {
+        auto* midiClip = dynamic_cast<te::MidiClip*> (clip);
+        if (midiClip == nullptr || midiClip->isMuted())
+            continue;
+
+        // The worker only plays notes; sustain pedal, pitch bend etc. need the live synth
+        if (midiClip->isLooping() || ! midiClip->getSequence().getControllerEvents().isEmpty())
+            return false;
+
+        // Same timing and channel as clip playback: quantised, grooved, trimmed to the clip
+        const auto* groove   = grooves.getTemplateByName (midiClip->getGrooveTemplate());
+        const double clipStart = midiClip->getPosition().getStart().inSeconds();
+        const double clipEnd   = midiClip->getPosition().getEnd().inSeconds();
+        const int channel      = midiClip->getMidiChannel().getChannelNumber();
+
+        for (auto* note : midiClip->getSequence().getNotes())
+        {
+            if (note->isMute())
+                continue;
+
+            const double start = juce::jmax (clipStart, note->getPlaybackTime (te::MidiNote::NoteEdge::start, *midiClip, groove).inSeconds());
+            const double end   = juce::jmin (clipEnd,   note->getPlaybackTime (te::MidiNote::NoteEdge::end,   *midiClip, groove).inSeconds());
+
+            if (end <= start)
+                continue;
+
+            MorphLookahead::Note n;
+            n.startSeconds = start;
+            n.endSeconds   = end;
+            n.channel      = juce::jlimit (1, 16, channel);
+            n.noteNumber   = note->getNoteNumber();
+            n.velocity     = (float) note->getVelocity() / 127.0f;
+            notes.push_back (n);
+        }
+    }
+
+    return true;
+}
+
+bool MorphSynthPlugin::hasLiveInput (te::AudioTrack& track)
+{
+    for (auto* instance : track.edit.getAllInputDevices())
+        if (instance->getTargets().contains (track.itemID))
+            return true;
+
+    return false;
+}
+
+namespace
+{
+    /** True if @p tree is (inside) a MIDI clip, i.e. an edit there can change what the synth plays. */
+    bool isInMidiClip (juce::ValueTree tree)
+    {
+        for (; tree.isValid(); tree = tree.getParent())
+        {
+            if (tree.hasType (te::IDs::MIDICLIP))
+                return true;
+
+            if (tree.hasType (te::IDs::TRACK))
+                return false;
+        }
+
+        return false;
+    }
+}
+
+void MorphSynthPlugin::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier&)
+{
+    if (isInMidiClip (tree))
+        notesDirty = true;
+}
+
+void MorphSynthPlugin::valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child)
+{
+    if (child.hasType (te::IDs::MIDICLIP) || isInMidiClip (parent))
+        notesDirty = true;
+}
+
+void MorphSynthPlugin::valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int)
+{
+    if (child.hasType (te::IDs::MIDICLIP) || isInMidiClip (parent))
+        notesDirty = true;
+}
+
+void MorphSynthPlugin::valueTreeChildOrderChanged (juce::ValueTree& parent, int, int)
+{
+    if (isInMidiClip (parent))
+        notesDirty = true;
+}
\ No newline at end of file
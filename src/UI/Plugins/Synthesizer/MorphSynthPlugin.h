@@ -5,19 +5,25 @@
 //
 // Responsibilities:
 //  - Owns parameters (osc types, morph, pulse, filter, envelopes, LFO, pitch).
-//  - Hosts a JUCE Synthesiser with MorphVoice voices.
+//  - Hosts a MorphSynthesiser (pre-allocated MorphVoice pool, configurable polyphony).
 //  - Renders audio/MIDI and exposes parameters to Tracktion automation.
 //
 // Notes:
 //  - See MorphSynthPlugin.cpp for parameter creation & rendering.
 //  - UI binds directly to te::AutomatableParameter* members declared here.
+//  - Voices read a MorphParamSnapshot captured once per block (MorphParams.h).
+//  - While playing, clip notes are pre-rendered on a worker thread
+//    (MorphLookahead.h) and the audio callback mostly copies the result.
 // ==============================================================================
 
 #pragma once
 
 #include <tracktion_engine/tracktion_engine.h>
 #include <juce_audio_processors/juce_audio_processors.h>
-#include "MorphVoice.h"
+#include "MorphSynthesiser.h"
+#include "MorphLookahead.h"
+#include "../../../AudioEngine/DspLoadCounter.h"
+#include <limits>
 
 namespace te = tracktion::engine;
 
@@ -28,9 +34,15 @@ namespace te = tracktion::engine;
  * Rendering pulls current parameter values, pushes MIDI to the synth, and
  * applies output gain. All parameters are exposed as te::AutomatableParameter
  * instances for host automation and UI attachments.
+ *
+ * During playback the owning track's clip notes are rendered ahead of the
+ * playhead by a MorphLookahead, unless the track has live MIDI input or a
+ * looped clip. The plugin keeps it fed with the track's notes, the loop range
+ * and the current parameters.
  */
 class MorphSynthPlugin final : public te::Plugin,
                                private juce::Timer,
+                               private juce::ValueTree::Listener,
                                private MorphVoice::ParamsView
 {
 public:
@@ -83,11 +95,128 @@ public:
     /** kill all active notes immediately. */
     void stopAllNotes();
 
+    /**
+     * @brief Read every parameter once into the shared snapshot.
+     *
+     * Called at the top of applyToBuffer; all voices then read the returned
+     * struct by MorphParam index for the rest of the block.
+     */
+    const MorphParamSnapshot& captureParameterSnapshot() noexcept;
+
+    //==============================================================================
+    // Polyphony
+    //------------------------------------------------------------------------------
+    static constexpr int maxPolyphony = MorphSynthesiser::maxVoices;
+
+    /**
+     * @brief Set the number of voices available to new notes (1..maxPolyphony).
+     *
+     * Stored in the plugin state (saved with the edit). Voices are
+     * pre-allocated, so this never allocates on the audio thread.
+     */
+    void setPolyphony (int numVoices);
+    int  getPolyphony() const;
+
+    //==============================================================================
+    // Silence detection
+    //------------------------------------------------------------------------------
+    /**
+     * @brief End voices whose output stays below @p thresholdDb for
+     *        @p holdSamples samples (defaults: -90 dBFS, 2048 samples; 0 disables).
+     */
+    void setSilenceDetection (float thresholdDb, int holdSamples);
+
+    /** Voices ended early by silence detection (diagnostics, e.g. CPU-saving checks). */
+    juce::uint64 getNumVoicesEndedEarly() const;
+    void resetNumVoicesEndedEarly();
+
+    /** Parameter for a given index (or nullptr if it was not created). */
+    te::AutomatableParameter* getParameter (MorphParam p) const noexcept { return paramTable[(size_t) p]; }
+
+    //==============================================================================
+    // MIDI timing
+    //------------------------------------------------------------------------------
+
+    /**
+     * @brief Enable/disable sample-accurate MIDI placement (default: enabled).
+     *
+     * When enabled, each incoming event fires at its in-block sample offset.
+     * When disabled, every event in a block fires on the block's first sample
+     * (the legacy behaviour, kept for A/B comparison).
+     */
+    void setSampleAccurateMidi (bool shouldBeSampleAccurate) noexcept { sampleAccurateMidi = shouldBeSampleAccurate; }
+    bool isSampleAccurateMidi() const noexcept                        { return sampleAccurateMidi; }
+
+    //==============================================================================
+    // Look-ahead rendering
+    //------------------------------------------------------------------------------
+
+    /**
+     * @brief Allow pre-rendering of clip notes (default: enabled).
+     *
+     * Playback stays live while a parameter is automated, and goes live for a
+     * moment whenever one moves, so the buffer never plays stale values.
+     */
+    void setLookaheadEnabled (bool shouldBeEnabled);
+    bool isLookaheadEnabled() const noexcept          { return lookaheadEnabled; }
+
+    /** True while playback is coming from the pre-rendered buffer. */
+    bool isPlayingFromLookahead() const noexcept      { return lookahead.isPlayingFromBuffer(); }
+
+    /** Blocks where the worker fell behind and playback fell back to live rendering. */
+    juce::uint64 getNumLookaheadUnderruns() const noexcept { return lookahead.getNumUnderruns(); }
+
+    //==============================================================================
+    // DSP load
+    //------------------------------------------------------------------------------
+
+    /** CPU time applyToBuffer() used since the last call, as a fraction of real time (see DspLoadMonitor). */
+    DspLoadCounter::Figures takeDspLoad() noexcept { return dspLoad.take(); }
+
+    /**
+     * @brief Convert a block-relative timestamp (seconds) to a sample offset.
+     * @return Offset clamped to [0, numSamples - 1].
+     */
+    static int timeStampToSampleOffset (double timeStampSeconds, double sampleRate, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return 0;
+
+        return juce::jlimit (0, numSamples - 1, juce::roundToInt (timeStampSeconds * sampleRate));
+    }
+
+    /**
+     * @brief Copy block-relative MIDI messages into a juce::MidiBuffer.
+     *
+     * @p src is any range of juce::MidiMessage (e.g. te::MidiMessageArray) whose
+     * timestamps are seconds from the start of the block. Events are written at
+     * startSample + offset so they line up with Synthesiser::renderNextBlock.
+     * Note-ons at or after @p dropNoteOnsFrom (a block offset) are skipped;
+     * the look-ahead buffer already has them.
+     */
+    template <typename MidiMessageRange>
+    static void addMessagesToBuffer (juce::MidiBuffer& dest, const MidiMessageRange& src,
+                                     double sampleRate, int startSample, int numSamples,
+                                     bool sampleAccurate,
+                                     int dropNoteOnsFrom = std::numeric_limits<int>::max())
+    {
+        for (auto& m : src)
+        {
+            const int offset = timeStampToSampleOffset (m.getTimeStamp(), sampleRate, numSamples);
+
+            if (offset >= dropNoteOnsFrom && m.isNoteOn())
+                continue;
+
+            dest.addEvent (m, startSample + (sampleAccurate ? offset : 0));
+        }
+    }
+
     //==============================================================================
     // Parameters (UI binds to these directly)
     //------------------------------------------------------------------------------
     // Oscillators / tone
     te::AutomatableParameter *morph = nullptr, *oscAType = nullptr, *oscBType = nullptr, *pulseWidth = nullptr;
+    te::AutomatableParameter *oscQuality = nullptr; // 0 = band-limited, 1 = naive (legacy)
 
     // Pitch
     te::AutomatableParameter *semi = nullptr, *fine = nullptr, *glide = nullptr;
@@ -106,7 +235,7 @@ public:
 
 private:
     //==============================================================================
-    // MorphVoice::ParamsView implementation
+    // MorphVoice::ParamsView implementation (compatibility shim; voices use the snapshot)
     //------------------------------------------------------------------------------
     float get   (const juce::String& id) const override;
     int   choice(const juce::String& id) const override;
@@ -118,11 +247,52 @@ private:
     // juce::Timer
     void timerCallback() override;
 
+    /** Fill paramTable from the named parameter members (after they are created). */
+    void buildParamTable();
+
+    /** Message thread: keep the look-ahead's notes, loop range and enablement current. */
+    void updateLookahead();
+
+    /**
+     * The owning track's MIDI clip notes in edit time, as playback sends them (quantise,
+     * groove, clip channel); false if they can't be pre-rendered (looped clips, or
+     * clips with controller events).
+     */
+    static bool collectClipNotes (te::AudioTrack& track, std::vector<MorphLookahead::Note>& notes);
+
+    /** True if any of our parameters follows automation or a modifier. */
+    bool hasAutomatedParameter() const;
+
+    /** True if any input device (MIDI keyboard etc.) targets @p track. */
+    static bool hasLiveInput (te::AudioTrack& track);
+
+    // juce::ValueTree::Listener (owning track's state; flags clip/note edits)
+    void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
+    void valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int) override;
+    void valueTreeChildOrderChanged (juce::ValueTree& parent, int, int) override;
+
     //==============================================================================
     // State
     //------------------------------------------------------------------------------
-    juce::Synthesiser synth;
-    static constexpr int numVoices = 8;
+    MorphSynthesiser synth;
+    static constexpr int defaultPolyphony = 8;
+    juce::CachedValue<int> polyphonyValue;           ///< Persisted voice count (plugin state)
+
+    std::array<te::AutomatableParameter*, MorphParams::numParams> paramTable {}; ///< Indexed by MorphParam
+    MorphParamSnapshot snapshot;                     ///< Refreshed once per block, read by all voices
+
+    juce::MidiBuffer midiScratch;                    ///< Reused per block (sized in initialise)
+    std::atomic<bool> sampleAccurateMidi { true };
+
+    MorphLookahead lookahead;
+    bool lookaheadEnabled = true;
+    juce::ValueTree watchedTrackState;               ///< Owning track, listened to for clip edits
+    bool notesDirty = true;
+    bool clipsCanPrerender = true;                   ///< False while the track has a looped clip or controller data
+    juce::uint64 notesTempoHash = 0;                 ///< Tempo sequence the current notes were converted with
+
+    DspLoadCounter dspLoad;                          ///< Written by applyToBuffer, read by DspLoadMonitor
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MorphSynthPlugin)
 };
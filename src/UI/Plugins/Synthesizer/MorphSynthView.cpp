@@ -188,6 +188,13 @@ MorphSynthView::MorphSynthView (MorphSynthPlugin& p)
     lfoTargetA = std::make_unique<ChoiceAttachment> (*plugin.lfoTarget, lfoTarget);
     lfoRateA   = std::make_unique<SliderAttachment>  (*plugin.lfoRate,   lfoRate);
     lfoDepthA  = std::make_unique<SliderAttachment>  (*plugin.lfoDepth,  lfoDepth);
+
+    // Voices (polyphony) -------------------------------------------------------
+    setupKnob (voices); addAndMakeVisible (voices);
+    addAndMakeVisible (voicesLabel); setupLabel (voicesLabel, "Voices");
+    voices.setRange (1, MorphSynthPlugin::maxPolyphony, 1);
+    voices.setValue (plugin.getPolyphony(), juce::dontSendNotification);
+    voices.onValueChange = [this] { plugin.setPolyphony ((int) voices.getValue()); };
 }
 
 MorphSynthView::~MorphSynthView()
@@ -344,9 +351,11 @@ void MorphSynthView::resized()
 
     r.removeFromTop (rowGap);
 
-    // Row 6: Output (Gain) -----------------------------------------------------
+    // Row 6: Output (Gain) / Voices -------------------------------------------
     {
         auto row = r.removeFromTop (knobRowH);
-        placeKnob (gain, gainLabel, row);
+        auto left = row.removeFromLeft (row.getWidth() / 2);
+        placeKnob (gain,   gainLabel,   left);
+        placeKnob (voices, voicesLabel, row);
     }
 }
\ No newline at end of file
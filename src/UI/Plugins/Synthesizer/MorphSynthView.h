@@ -177,6 +177,9 @@ private:
     juce::ComboBox lfoTarget;            juce::Label lfoTargetLabel;
     juce::Slider   lfoRate, lfoDepth;    juce::Label lfoRateLabel, lfoDepthLabel;
 
+    // --- voices (plugin setting, not an automatable parameter)
+    juce::Slider voices;                 juce::Label voicesLabel;
+
     //==============================================================================
     // Attachments (UI <-> parameters)
     //------------------------------------------------------------------------------
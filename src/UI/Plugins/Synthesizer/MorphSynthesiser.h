@@ -0,0 +1,179 @@
+// ==============================================================================
+// MorphSynthesiser.h
+// ------------------------------------------------------------------------------
+// Fixed-size voice pool for the Morph Synth.
+//
+// Responsibilities:
+//  - Pre-allocate every MorphVoice up front (no allocation when the voice
+//    count changes).
+//  - Limit new notes to the first N voices, where N is the polyphony setting.
+//  - Render only voices that are currently sounding.
+//  - Steal released voices first, then the quietest, then the oldest.
+//  - Apply silence detection to every voice and count voices ended early.
+//
+// Notes:
+//  - setPolyphony() is safe to call from any thread. Lowering it never cuts
+//    notes: voices above the limit finish their tails, they just don't get
+//    new notes.
+// ==============================================================================
+
+#pragma once
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "MorphVoice.h"
+
+/**
+ * @brief juce::Synthesiser with a bounded MorphVoice pool and custom stealing.
+ */
+class MorphSynthesiser : public juce::Synthesiser
+{
+public:
+    static constexpr int maxVoices = 64;
+
+    /** Create the full pool of maxVoices voices. */
+    MorphSynthesiser()
+    {
+        for (int i = 0; i < maxVoices; ++i)
+            addVoice (new MorphVoice());
+    }
+
+    /** Prepare every pooled voice (call from initialise, not the audio thread). */
+    void prepare (double sr, int maxBlock, const MorphParamSnapshot* snapshot)
+    {
+        setCurrentPlaybackSampleRate (sr);
+
+        for (auto* v : voices)
+            static_cast<MorphVoice*> (v)->prepare (sr, maxBlock, snapshot);
+    }
+
+    /** Set how many voices may be assigned new notes (clamped to 1..maxVoices). */
+    void setPolyphony (int numVoices) noexcept { polyphony = juce::jlimit (1, maxVoices, numVoices); }
+    int getPolyphony() const noexcept          { return polyphony; }
+
+    /**
+     * @brief Configure early voice termination (see MorphVoice::setSilenceDetection).
+     * Safe to call from any thread; applied to each voice before it renders.
+     */
+    void setSilenceDetection (float thresholdDb, int holdSamples) noexcept
+    {
+        silenceThresholdDb = thresholdDb;
+        silenceHoldSamples = juce::jmax (0, holdSamples);
+    }
+
+    float getSilenceThresholdDb() const noexcept   { return silenceThresholdDb; }
+    int   getSilenceHoldSamples() const noexcept   { return silenceHoldSamples; }
+
+    /** Voices ended by silence detection since construction or the last reset. */
+    juce::uint64 getNumVoicesEndedEarly() const noexcept { return voicesEndedEarly.load (std::memory_order_relaxed); }
+    void resetNumVoicesEndedEarly() noexcept             { voicesEndedEarly.store (0, std::memory_order_relaxed); }
+
+    /** Number of voices currently producing sound (for diagnostics/tests). */
+    int getNumActiveVoices() const noexcept
+    {
+        int n = 0;
+        for (auto* v : voices)
+            if (v->isVoiceActive())
+                ++n;
+        return n;
+    }
+
+    /**
+     * @brief Steal ordering: true if @p a should be stolen before @p b.
+     *
+     * Released voices go first, then the quieter voice (voices still in their
+     * attack count at their velocity), then the one that started earlier.
+     */
+    static bool isBetterStealCandidate (const MorphVoice& a, const MorphVoice& b) noexcept
+    {
+        const bool releasedA = a.isPlayingButReleased();
+        const bool releasedB = b.isPlayingButReleased();
+        if (releasedA != releasedB)
+            return releasedA;
+
+        const float levelA = a.getStealLevel();
+        const float levelB = b.getStealLevel();
+        if (std::abs (levelA - levelB) > levelTolerance)
+            return levelA < levelB;
+
+        return a.wasStartedBefore (b);
+    }
+
+protected:
+    //==============================================================================
+    // juce::Synthesiser overrides
+    //------------------------------------------------------------------------------
+
+    using juce::Synthesiser::renderVoices;
+
+    /** Render only sounding voices; idle voices cost a single flag check. */
+    void renderVoices (juce::AudioBuffer<float>& out, int startSample, int numSamples) override
+    {
+        const float thresholdDb = silenceThresholdDb;
+        const int   hold        = silenceHoldSamples;
+
+        for (auto* v : voices)
+        {
+            if (! v->isVoiceActive())
+                continue;
+
+            auto* mv = static_cast<MorphVoice*> (v);
+            mv->setSilenceDetection (thresholdDb, hold);
+            mv->renderNextBlock (out, startSample, numSamples);
+
+            if (! mv->isVoiceActive() && mv->wasEndedEarly())
+                voicesEndedEarly.fetch_add (1, std::memory_order_relaxed);
+        }
+    }
+
+    /** Search only the first getPolyphony() voices for an idle one. */
+    juce::SynthesiserVoice* findFreeVoice (juce::SynthesiserSound* sound,
+                                           int midiChannel,
+                                           int midiNoteNumber,
+                                           bool stealIfNoneAvailable) const override
+    {
+        const juce::ScopedLock sl (lock);
+        const int limit = juce::jmin ((int) polyphony, voices.size());
+
+        for (int i = 0; i < limit; ++i)
+        {
+            auto* v = voices.getUnchecked (i);
+            if (! v->isVoiceActive() && v->canPlaySound (sound))
+                return v;
+        }
+
+        if (stealIfNoneAvailable)
+            return findVoiceToSteal (sound, midiChannel, midiNoteNumber);
+
+        return nullptr;
+    }
+
+    /** Pick the best steal candidate among the first getPolyphony() voices. */
+    juce::SynthesiserVoice* findVoiceToSteal (juce::SynthesiserSound* sound,
+                                              int /*midiChannel*/,
+                                              int /*midiNoteNumber*/) const override
+    {
+        const int limit = juce::jmin ((int) polyphony, voices.size());
+        MorphVoice* best = nullptr;
+
+        for (int i = 0; i < limit; ++i)
+        {
+            auto* v = static_cast<MorphVoice*> (voices.getUnchecked (i));
+            if (! v->canPlaySound (sound))
+                continue;
+
+            if (best == nullptr || isBetterStealCandidate (*v, *best))
+                best = v;
+        }
+
+        return best;
+    }
+
+private:
+    static constexpr float levelTolerance = 1.0e-3f; // levels closer than this count as equal
+
+    std::atomic<int> polyphony { 8 };
+    std::atomic<float> silenceThresholdDb { MorphVoice::defaultSilenceThresholdDb };
+    std::atomic<int>   silenceHoldSamples { MorphVoice::defaultSilenceHoldSamples };
+    std::atomic<juce::uint64> voicesEndedEarly { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MorphSynthesiser)
+};
@@ -0,0 +1,105 @@
+// ==============================================================================
+// MorphWavetables.h
+// ------------------------------------------------------------------------------
+// Precomputed lookup tables for MorphOsc's band-limited mode.
+//
+// Features:
+//  - Single-cycle sine table (replaces per-sample std::sin)
+//  - Mip-mapped triangle tables, one per octave of phase increment, each
+//    holding only the harmonics that stay below Nyquist for that octave
+//
+// Notes:
+//  - One instance is shared by every voice; it is built on first use, so call
+//    MorphWavetables::get() from prepare(), never first from the audio thread.
+//  - Tables are indexed by normalized phase [0, 1) and are sample-rate agnostic.
+// ==============================================================================
+
+#pragma once
+#include <array>
+#include <cmath>
+#include <juce_core/juce_core.h>
+
+/**
+ * @brief Shared, read-only wavetable bank for the Morph Synth oscillators.
+ */
+class MorphWavetables
+{
+public:
+    static constexpr int tableSize = 2048;   ///< Samples per cycle (power of two)
+    static constexpr int numLevels = 10;     ///< Level L holds harmonics 1 .. 2^L
+
+    /** The process-wide bank (built on first call). */
+    static const MorphWavetables& get()
+    {
+        static const MorphWavetables instance;
+        return instance;
+    }
+
+    /**
+     * @brief Mip level for a given phase increment (frequency / sampleRate).
+     *
+     * Picks the richest table whose highest harmonic stays below Nyquist.
+     */
+    static int levelForIncrement (double phaseInc) noexcept
+    {
+        if (phaseInc <= 0.0)
+            return numLevels - 1;
+
+        const double maxHarmonic = 0.5 / phaseInc;
+        if (maxHarmonic < 2.0)
+            return 0;
+
+        return juce::jmin (numLevels - 1, std::ilogb (maxHarmonic));
+    }
+
+    /** Sine at normalized phase [0, 1). */
+    float sine (double phase) const noexcept                 { return lookup (sineTable, phase); }
+
+    /** Band-limited triangle at normalized phase [0, 1) for the given mip level. */
+    float triangle (double phase, int level) const noexcept  { return lookup (triangleTables[(size_t) level], phase); }
+
+private:
+    using Table = std::array<float, tableSize + 1>; // +1 guard point for interpolation
+
+    MorphWavetables()
+    {
+        const double twoPi = juce::MathConstants<double>::twoPi;
+
+        for (int i = 0; i <= tableSize; ++i)
+            sineTable[(size_t) i] = (float) std::sin (twoPi * i / tableSize);
+
+        // Triangle (matching MorphOsc's naive shape: -1 at phase 0, +1 at 0.5):
+        //   tri(x) = -(8 / pi^2) * sum_{odd n} cos(2 pi n x) / n^2
+        const double scale = 8.0 / (juce::MathConstants<double>::pi * juce::MathConstants<double>::pi);
+
+        for (int level = 0; level < numLevels; ++level)
+        {
+            const int maxHarmonic = 1 << level;
+            auto& table = triangleTables[(size_t) level];
+
+            for (int i = 0; i <= tableSize; ++i)
+            {
+                const double x = (double) i / tableSize;
+                double sum = 0.0;
+
+                for (int n = 1; n <= maxHarmonic; n += 2)
+                    sum += std::cos (twoPi * n * x) / (double) (n * n);
+
+                table[(size_t) i] = (float) (-scale * sum);
+            }
+        }
+    }
+
+    static float lookup (const Table& table, double phase) noexcept
+    {
+        const double pos  = phase * tableSize;
+        const int    i    = ((int) pos) & (tableSize - 1);
+        const float  frac = (float) (pos - std::floor (pos));
+        return table[(size_t) i] + frac * (table[(size_t) i + 1] - table[(size_t) i]);
+    }
+
+    Table sineTable {};
+    std::array<Table, numLevels> triangleTables {};
+
+    JUCE_DECLARE_NON_COPYABLE (MorphWavetables)
+};
@@ -1,6 +1,7 @@
 // Created by Claude Code on 2025-11-18.
 #include "AudioSettingsPanel.h"
 #include "../../AppEngine/AppEngine.h"
+#include <algorithm>
 
 using namespace juce;
 
@@ -48,14 +49,49 @@ AudioSettingsPanel::AudioSettingsPanel (AppEngine& engine)
     latencyLabel.setFont (Font (13.0f));
     latencyLabel.setColour (Label::textColourId, Colours::lightgrey);
 
+    // Callback timing
+    addAndMakeVisible (timingLabel);
+    timingLabel.setJustificationType (Justification::centredLeft);
+    timingLabel.setFont (Font (14.0f, Font::bold));
+
+    addAndMakeVisible (timingSummaryLabel);
+    timingSummaryLabel.setJustificationType (Justification::centredLeft);
+    timingSummaryLabel.setFont (Font (13.0f));
+    timingSummaryLabel.setColour (Label::textColourId, Colours::lightgrey);
+
+    addAndMakeVisible (timingEventsBox);
+    timingEventsBox.setMultiLine (true);
+    timingEventsBox.setReadOnly (true);
+    timingEventsBox.setScrollbarsShown (true);
+    timingEventsBox.setFont (Font (Font::getDefaultMonospacedFontName(), 12.0f, Font::plain));
+
+    addAndMakeVisible (resetTimingBtn);
+    resetTimingBtn.onClick = [this]
+    {
+        appEngine.getCallbackMonitor().reset();
+        timerCallback();
+    };
+
+    addAndMakeVisible (showTimingLogBtn);
+    showTimingLogBtn.onClick = [this]
+    {
+        const auto& log = appEngine.getCallbackMonitor().getLogFile();
+        if (log.existsAsFile())
+            log.revealToUser();
+    };
+
     // Initialize with current settings
     refreshDeviceList();
     refreshSampleRates();
     refreshBufferSizes();
+
+    timerCallback();
+    startTimerHz (4);
 }
 
 AudioSettingsPanel::~AudioSettingsPanel()
 {
+    stopTimer();
     deviceCombo.removeListener (this);
     sampleRateCombo.removeListener (this);
     bufferSizeCombo.removeListener (this);
@@ -64,6 +100,48 @@ AudioSettingsPanel::~AudioSettingsPanel()
 void AudioSettingsPanel::paint (Graphics& g)
 {
     g.fillAll (Colour (0xFF2B2D30)); // Slightly lighter than main background
+    paintHistogram (g);
+}
+
+void AudioSettingsPanel::paintHistogram (Graphics& g) const
+{
+    if (histogramArea.isEmpty())
+        return;
+
+    g.setColour (Colours::black.withAlpha (0.3f));
+    g.fillRect (histogramArea);
+
+    const auto stats = appEngine.getCallbackMonitor().getStats();
+    const auto maxCount = *std::max_element (stats.histogram.begin(), stats.histogram.end());
+
+    auto area = histogramArea.reduced (4);
+    auto labels = area.removeFromBottom (14);
+    const auto binW = (float) area.getWidth() / (float) AudioCallbackMonitor::numHistogramBins;
+
+    g.setFont (Font (10.0f));
+
+    for (int bin = 0; bin < AudioCallbackMonitor::numHistogramBins; ++bin)
+    {
+        const auto count = stats.histogram[(size_t) bin];
+        const auto x = (float) area.getX() + binW * (float) bin;
+
+        // Log scale: most callbacks sit in the low bins, the interesting ones are rare
+        if (count > 0 && maxCount > 0)
+        {
+            const auto h = (float) area.getHeight() * (float) (std::log10 (1.0 + (double) count) / std::log10 (1.0 + (double) maxCount));
+            const auto binLoad = bin * 0.1;
+
+            g.setColour (binLoad >= AudioCallbackMonitor::xrunLoad          ? Colour (0xFFFF6B6B)
+                         : binLoad >= AudioCallbackMonitor::nearMissLoad    ? Colour (0xFFFCC419)
+                                                                            : Colour (0xFF51CF66));
+            g.fillRect (Rectangle<float> (x + 1.0f, (float) area.getBottom() - h, binW - 2.0f, h));
+        }
+
+        g.setColour (Colours::lightgrey);
+        g.drawText (AudioCallbackMonitor::getHistogramBinLabel (bin),
+                    Rectangle<float> (x, (float) labels.getY(), binW, (float) labels.getHeight()),
+                    Justification::centred, false);
+    }
 }
 
 void AudioSettingsPanel::resized()
@@ -96,6 +174,24 @@ void AudioSettingsPanel::resized()
     bufferSizeCombo.setBounds (r.removeFromTop (28));
     r.removeFromTop (8);
     latencyLabel.setBounds (r.removeFromTop (20));
+
+    r.removeFromTop (20);
+
+    // Callback timing section
+    timingLabel.setBounds (r.removeFromTop (24));
+    r.removeFromTop (8);
+    histogramArea = r.removeFromTop (90);
+    r.removeFromTop (6);
+    timingSummaryLabel.setBounds (r.removeFromTop (20));
+    r.removeFromTop (6);
+
+    auto timingButtonRow = r.removeFromBottom (28);
+    resetTimingBtn.setBounds (timingButtonRow.removeFromLeft (120));
+    timingButtonRow.removeFromLeft (10);
+    showTimingLogBtn.setBounds (timingButtonRow.removeFromLeft (120));
+    r.removeFromBottom (8);
+
+    timingEventsBox.setBounds (r);
 }
 
 void AudioSettingsPanel::comboBoxChanged (ComboBox* combo)
@@ -138,6 +234,34 @@ void AudioSettingsPanel::comboBoxChanged (ComboBox* combo)
     }
 }
 
+void AudioSettingsPanel::timerCallback()
+{
+    auto& monitor = appEngine.getCallbackMonitor();
+    const auto stats = monitor.getStats();
+
+    timingSummaryLabel.setText (String ((int64) stats.numCallbacks) + " callbacks, worst "
+                                    + String (stats.worstLoad * 100.0, 0) + "% of "
+                                    + String (stats.periodMs, 1) + " ms  |  "
+                                    + String ((int64) stats.numNearMisses) + " near misses, "
+                                    + String ((int64) stats.numXruns) + " xruns",
+                                dontSendNotification);
+
+    const auto events = monitor.getRecentEvents();
+
+    String text;
+
+    for (auto it = events.rbegin(); it != events.rend(); ++it)
+        text << Time (it->timeMs).formatted ("%H:%M:%S  ") << AudioCallbackMonitor::formatEvent (*it) << "\n";
+
+    if (text.isEmpty())
+        text = "No near misses or xruns yet.";
+
+    if (text != timingEventsBox.getText())
+        timingEventsBox.setText (text, false);
+
+    repaint (histogramArea);
+}
+
 void AudioSettingsPanel::refreshDeviceList()
 {
     deviceCombo.clear();
@@ -12,6 +12,7 @@ class AppEngine;
  *  - Sample rate selection (44.1kHz, 48kHz, 96kHz, etc.)
  *  - Buffer size selection (with calculated latency display)
  *  - Quick access buttons (Refresh, Use System Default)
+ *  - Callback timing: load histogram, near-miss/xrun counts and recent events
  *
  * Architecture:
  *  - Owned by SettingsDialog (displayed in Audio tab)
@@ -24,12 +25,19 @@ class AppEngine;
  *  - Calculated as: (bufferSize / sampleRate) * 1000.0
  *  - Updates automatically when buffer or sample rate changes
  *
+ * Callback Timing:
+ *  - Read from AudioEngine's AudioCallbackMonitor a few times a second
+ *  - Histogram bars are callback time as a share of the buffer period (log scale)
+ *  - Show Log reveals the rolling log file with every near miss and xrun
+ *
  * Usage:
  *  - Changes apply immediately (no Apply button needed)
  *  - Refresh button re-enumerates devices (useful for hot-plugged interfaces)
  *  - System Default button restores OS default output device
  */
-class AudioSettingsPanel : public juce::Component, private juce::ComboBox::Listener
+class AudioSettingsPanel : public juce::Component,
+                           private juce::ComboBox::Listener,
+                           private juce::Timer
 {
 public:
     //==============================================================================
@@ -64,6 +72,9 @@ private:
      */
     void comboBoxChanged (juce::ComboBox* combo) override;
 
+    /** Refreshes the callback timing display. */
+    void timerCallback() override;
+
     //==============================================================================
     // Internal Methods
 
@@ -88,6 +99,13 @@ private:
      */
     void refreshSampleRates();
 
+    /**
+     * @brief Draws the callback load histogram into histogramArea.
+     *
+     * @param g Graphics context
+     */
+    void paintHistogram (juce::Graphics& g) const;
+
     //==============================================================================
     // Member Variables
 
@@ -105,5 +123,12 @@ private:
     juce::ComboBox bufferSizeCombo; ///< Buffer size dropdown
     juce::Label latencyLabel { {}, "" }; ///< Calculated latency display
 
+    juce::Label timingLabel { {}, "Callback Timing:" }; ///< Callback timing label
+    juce::Rectangle<int> histogramArea; ///< Where paintHistogram() draws
+    juce::Label timingSummaryLabel { {}, "" }; ///< Callbacks / worst load / near misses / xruns
+    juce::TextEditor timingEventsBox; ///< Most recent near misses and xruns, newest first
+    juce::TextButton resetTimingBtn { "Reset" }; ///< Clears the histogram and counters
+    juce::TextButton showTimingLogBtn { "Show Log" }; ///< Reveals the rolling log file
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioSettingsPanel)
 };
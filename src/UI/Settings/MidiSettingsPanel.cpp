@@ -22,6 +22,31 @@ MidiSettingsPanel::MidiSettingsPanel (AppEngine& engine)
 
     deviceContainer.setSize (400, 400); // Will be resized based on content
 
+    addAndMakeVisible (logLevelLabel);
+    logLevelLabel.setJustificationType (Justification::centredLeft);
+
+    // Item IDs are the RtLog::Level values + 1
+    addAndMakeVisible (logLevelCombo);
+    logLevelCombo.addItem ("Debug",   (int) RtLog::Level::debug + 1);
+    logLevelCombo.addItem ("Info",    (int) RtLog::Level::info + 1);
+    logLevelCombo.addItem ("Warning", (int) RtLog::Level::warning + 1);
+    logLevelCombo.addItem ("Error",   (int) RtLog::Level::error + 1);
+    logLevelCombo.addItem ("Off",     (int) RtLog::Level::off + 1);
+
+    logLevelCombo.setSelectedId ((int) rtLog->getLevel() + 1, dontSendNotification);
+    logLevelCombo.onChange = [this]
+    {
+        rtLog->setLevel ((RtLog::Level) (logLevelCombo.getSelectedId() - 1));
+    };
+
+    addAndMakeVisible (showLogBtn);
+    showLogBtn.onClick = [this]
+    {
+        const auto log = rtLog->getLogFile();
+        if (log.existsAsFile())
+            log.revealToUser();
+    };
+
     refreshDeviceList();
 }
 
@@ -36,6 +61,13 @@ void MidiSettingsPanel::resized()
 {
     auto r = getLocalBounds().reduced (20);
 
+    auto logRow = r.removeFromBottom (24);
+    logLevelLabel.setBounds (logRow.removeFromLeft (140));
+    logLevelCombo.setBounds (logRow.removeFromLeft (120));
+    logRow.removeFromLeft (8);
+    showLogBtn.setBounds (logRow.removeFromLeft (90));
+    r.removeFromBottom (12);
+
     titleLabel.setBounds (r.removeFromTop (24));
     r.removeFromTop (4);
     infoLabel.setBounds (r.removeFromTop (20));
@@ -1,6 +1,7 @@
 // Created by Claude Code on 2025-11-18.
 #pragma once
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "../../AudioEngine/RtLog.h"
 
 class AppEngine;
 
@@ -22,8 +23,12 @@ class AppEngine;
  *  - Displays "No MIDI input devices detected" if empty
  *  - Shows device identifier and name for each device
  *
+ * Realtime Log:
+ *  - Level combo sets what the MIDI/recording hot paths queue to RtLog
+ *  - "Show Log" reveals GrooveKit/Logs/realtime.log
+ *
  * Usage:
- *  - Display-only panel (no user interaction required)
+ *  - Device list is display-only
  *  - All detected MIDI devices are automatically available for input
  *  - MIDI input works when track is armed for recording
  */
@@ -72,5 +77,10 @@ private:
     juce::Viewport deviceViewport; ///< Scrollable viewport for device list
     juce::Component deviceContainer; ///< Container holding device labels
 
+    juce::SharedResourcePointer<RtLog> rtLog; ///< Shared real-time log (level is global)
+    juce::Label logLevelLabel { {}, "Realtime Log Level:" }; ///< Log level label
+    juce::ComboBox logLevelCombo; ///< Debug / Info / Warning / Error / Off
+    juce::TextButton showLogBtn { "Show Log" }; ///< Reveals the realtime log file
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiSettingsPanel)
 };
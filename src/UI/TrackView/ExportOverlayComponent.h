@@ -10,8 +10,10 @@
  * This semi-transparent modal overlay blocks all interaction with the UI
  * while rendering is in progress. It includes:
  *   - A centered title: "Exporting audio..."
- *   - A short message explaining that rendering is happening
- *   - An indeterminate ProgressBar animating until export completes
+ *   - A short message explaining that rendering is happening (or the
+ *     exporter's status and time remaining, via setText)
+ *   - A ProgressBar: indeterminate by default, or a percentage via setProgress
+ *   - An optional Cancel button (shown when onCancel is set)
  *
  * The overlay is meant to be added on top of the MainComponent (or editor)
  * while Tracktion Engine performs the render. Once finished, simply remove
@@ -47,6 +49,49 @@ public:
         // ---- Progress Bar ----
         addAndMakeVisible (progressBar);
         progressBar.setPercentageDisplay (false); // Only show the animated bar
+
+        // ---- Cancel Button (hidden until onCancel is set) ----
+        addChildComponent (cancelButton);
+        cancelButton.onClick = [this]
+        {
+            cancelButton.setEnabled (false);
+            messageLabel.setText ("Cancelling...", juce::dontSendNotification);
+
+            if (onCancel)
+                onCancel();
+        };
+    }
+
+    //==============================================================================
+    /**
+     * @brief Shows a Cancel button that calls @p callback (once) when clicked.
+     */
+    void setCancelCallback (std::function<void()> callback)
+    {
+        onCancel = std::move (callback);
+        cancelButton.setVisible (onCancel != nullptr);
+        cancelButton.setEnabled (true);
+    }
+
+    //==============================================================================
+    /**
+     * @brief Replace the title and message (e.g. to reuse the overlay while a project loads).
+     */
+    void setText (const juce::String& title, const juce::String& message)
+    {
+        titleLabel.setText (title, juce::dontSendNotification);
+        messageLabel.setText (message, juce::dontSendNotification);
+    }
+
+    /**
+     * @brief Set progress in 0..1, or -1 for the indeterminate animation.
+     *
+     * The ProgressBar polls progressValue on its own timer, so this is cheap to call often.
+     */
+    void setProgress (double newProgress)
+    {
+        progressValue = newProgress;
+        progressBar.setPercentageDisplay (newProgress >= 0.0);
     }
 
     //==============================================================================
@@ -69,6 +114,8 @@ public:
         messageLabel.setBounds (centreBox.removeFromTop (40));
         centreBox.removeFromTop (20);
         progressBar.setBounds  (centreBox.removeFromTop (30));
+        centreBox.removeFromTop (15);
+        cancelButton.setBounds (centreBox.removeFromTop (28).withSizeKeepingCentre (100, 28));
     }
 
     /**
@@ -97,4 +144,6 @@ private:
     double progressValue;              ///< -1.0 = JUCE indeterminate progress mode
     juce::ProgressBar progressBar;     ///< Animated progress indicator
     juce::Label titleLabel, messageLabel;
+    juce::TextButton cancelButton { "Cancel" };
+    std::function<void()> onCancel;
 };
\ No newline at end of file
@@ -160,7 +160,7 @@ void TrackComponent::onInstrumentClicked()
 
 void TrackComponent::onInstrumentMenuRequested()
 {
-    if (appEngine)
+    if (appEngine && confirmEditable (trackIndex))
         appEngine->showInstrumentChooser (trackIndex);
 }
 
@@ -181,6 +181,10 @@ void TrackComponent::onSettingsClicked()
     m.addItem (100, "Delete Track");
 
     m.showMenuAsync ({}, [this] (const int result) {
+        // Everything but Delete Track changes this track's clips
+        if (result >= 1 && result <= 3 && ! confirmEditable (trackIndex))
+            return;
+
         switch (result)
         {
             case 1: // Add Clip
@@ -273,10 +277,77 @@ void TrackComponent::onSoloToggled (const bool isSolo)
 
 void TrackComponent::onRecordArmToggled (bool isArmed)
 {
-    if (auto* p = findParentComponentOfClass<TrackListComponent>())
+    auto* p = findParentComponentOfClass<TrackListComponent>();
+
+    if (isArmed && ! confirmEditable (trackIndex))
+    {
+        if (p != nullptr)
+            p->refreshTrackStates();   // put the arm button back
+        return;
+    }
+
+    if (p != nullptr)
         p->armTrack (trackIndex, isArmed);
 }
 
+void TrackComponent::onFreezeToggled (const bool shouldBeFrozen)
+{
+    if (! appEngine)
+        return;
+
+    // Close the piano roll first: its notes are about to stop being editable
+    if (shouldBeFrozen)
+        if (auto* parent = findParentComponentOfClass<TrackEditView>())
+            if (parent->getPianoRollIndex() == trackIndex)
+                parent->hidePianoRoll();
+
+    appEngine->setTrackFrozen (trackIndex, shouldBeFrozen);
+}
+
+bool TrackComponent::confirmEditable (const int index)
+{
+    return confirmEditable (juce::Array<int> { index });
+}
+
+bool TrackComponent::confirmEditable (const juce::Array<int>& indices)
+{
+    juce::Array<int> frozen;
+
+    if (appEngine)
+        for (const auto index : indices)
+            if (appEngine->getTrackFreezeState (index) != TrackFreezer::State::live)
+                frozen.addIfNotAlreadyThere (index);
+
+    if (frozen.isEmpty())
+        return true;
+
+    juce::StringArray names;
+    for (const auto index : frozen)
+        names.add ("\"" + appEngine->getTrackName (index) + "\"");
+
+    const bool one = frozen.size() == 1;
+    const juce::String them = one ? "it" : "them";
+
+    const auto opts = juce::MessageBoxOptions()
+        .withIconType (juce::MessageBoxIconType::QuestionIcon)
+        .withTitle (one ? "Track is frozen" : "Tracks are frozen")
+        .withMessage (names.joinIntoString (" and ")
+                      + (one ? " is frozen, so its clips and instrument " : " are frozen, so their clips and instruments ")
+                      + "can't be changed. Unfreeze " + them + " to edit, then freeze " + them + " again when you're done.")
+        .withButton ("Unfreeze")
+        .withButton ("Cancel");
+
+    juce::AlertWindow::showAsync (opts,
+        [engine = appEngine, frozen] (const int r)
+        {
+            if (r == 1)
+                for (const auto index : frozen)
+                    engine->setTrackFrozen (index, false);
+        });
+
+    return false;
+}
+
 void TrackComponent::rebuildClipsFromEngine()
 {
     // Remove existing UI clips
@@ -293,7 +364,7 @@ void TrackComponent::rebuildClipsFromEngine()
 
         // Existing open piano roll callback
         ui->onClicked = [this] (te::MidiClip* c) {
-            if (onRequestOpenPianoRoll)
+            if (onRequestOpenPianoRoll && confirmEditable (trackIndex))
                 onRequestOpenPianoRoll (c);
         };
 
@@ -304,7 +375,7 @@ void TrackComponent::rebuildClipsFromEngine()
         };
 
         ui->onDuplicateRequested = [this] (te::MidiClip* c) {
-            if (appEngine)
+            if (appEngine && confirmEditable (trackIndex))
             {
                 appEngine->duplicateMidiClip (c);
                 rebuildAndRefreshHighlight();
@@ -313,7 +384,7 @@ void TrackComponent::rebuildClipsFromEngine()
 
         ui->onPasteRequested = [this] (te::MidiClip* c, double pasteBeats) {
             juce::ignoreUnused (c); // track determination is based on this component's trackIndex
-            if (appEngine)
+            if (appEngine && confirmEditable (trackIndex))
             {
                 appEngine->pasteClipboardAt (trackIndex, pasteBeats);
                 rebuildAndRefreshHighlight();
@@ -321,6 +392,9 @@ void TrackComponent::rebuildClipsFromEngine()
         };
 
         ui->onDeleteRequested = [this] (te::MidiClip* c) {
+            if (! confirmEditable (trackIndex))
+                return;
+
             if (auto* parent = findParentComponentOfClass<TrackEditView>())
             {
                 // If the piano roll is currently showing a clip from this track,
@@ -352,6 +426,10 @@ void TrackComponent::rebuildClipsFromEngine()
                 if (safeThis == nullptr || safeThis->appEngine == nullptr)
                     return;
 
+                // Copy only reads the clip
+                if (result > 1 && ! safeThis->confirmEditable (safeThis->trackIndex))
+                    return;
+
                 switch (result)
                 {
                     case 1: // Copy
@@ -419,6 +497,10 @@ void TrackComponent::rebuildClipsFromEngine()
                 return;
             }
 
+            // Both the source and the destination track must be live
+            if (! confirmEditable ({ trackIndex, targetTrack }))
+                return;
+
             // Apply changes to model
             const bool changingTracks = (targetTrack != trackIndex);
 
@@ -545,6 +627,9 @@ void TrackComponent::mouseUp (const juce::MouseEvent& e)
         if (safeThis == nullptr || safeThis->appEngine == nullptr)
             return;
 
+        if (result != 0 && ! safeThis->confirmEditable (safeThis->trackIndex))
+            return;
+
         switch (result)
         {
             case 1: // Paste Here
@@ -11,7 +11,7 @@ namespace t = tracktion;
  *
  * TrackComponent represents a single track's visual lane in the track editor, containing
  * TrackClip UI components for each MIDI clip on that track. It acts as a listener for
- * TrackHeaderComponent button events (mute/solo/arm/delete) and propagates them to AppEngine.
+ * TrackHeaderComponent button events (mute/solo/arm/freeze/delete) and propagates them to AppEngine.
  *
  * Architecture:
  *  - Owned by TrackListComponent (one TrackComponent per track)
@@ -105,6 +105,13 @@ public:
      */
     void onRecordArmToggled (bool isArmed) override;
 
+    /**
+     * @brief Called when the freeze button is toggled on the track header or channel strip.
+     *
+     * @param shouldBeFrozen True to start freezing, false to unfreeze (or cancel a freeze)
+     */
+    void onFreezeToggled (bool shouldBeFrozen) override;
+
     //==============================================================================
     // Track Index Management
 
@@ -204,6 +211,18 @@ private:
     double pixelsPerBeat = 100.0; ///< Horizontal zoom level (pixels per beat)
     t::BeatPosition viewStartBeat = t::BeatPosition::fromBeats(0.0); ///< Horizontal scroll position (beat at left edge)
 
+    /**
+     * @brief Returns true if the clips on track @p index can be edited.
+     *
+     * A frozen (or freezing) track's clips are baked into its freeze file, so
+     * instead this offers to unfreeze the track and returns false; the edit is
+     * dropped and can be redone once the track is live.
+     */
+    bool confirmEditable (int index);
+
+    /** As above for several tracks at once (e.g. both ends of a clip move), with one prompt for all the frozen ones. */
+    bool confirmEditable (const juce::Array<int>& indices);
+
     //==============================================================================
     // Coordinate Conversion Helpers
 
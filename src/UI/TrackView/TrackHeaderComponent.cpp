@@ -15,6 +15,7 @@ TrackHeaderComponent::TrackHeaderComponent (AppEngine& engine)
     addAndMakeVisible (muteTrackButton);
     addAndMakeVisible (soloTrackButton);
     addAndMakeVisible (recordArmButton);
+    addAndMakeVisible (freezeButton);
 
     instrumentButton.setButtonText ("Instrument");
 
@@ -60,6 +61,17 @@ TrackHeaderComponent::TrackHeaderComponent (AppEngine& engine)
         listeners.call ([&] (Listener& l) { l.onRecordArmToggled (nowArmed); });
     };
 
+    freezeButton.setClickingTogglesState (true);
+    freezeButton.setColour (juce::TextButton::buttonOnColourId, juce::Colour (0xFF4DABF7));
+    freezeButton.setColour (juce::TextButton::buttonColourId, juce::Colours::darkgrey);
+    freezeButton.setColour (juce::TextButton::textColourOnId, juce::Colours::black);
+    freezeButton.setColour (juce::TextButton::textColourOffId, juce::Colours::white);
+    freezeButton.setTooltip ("Freeze: render this track to audio and switch its plugins off to save CPU");
+    freezeButton.onClick = [this] {
+        const bool nowFrozen = freezeButton.getToggleState();
+        listeners.call ([&] (Listener& l) { l.onFreezeToggled (nowFrozen); });
+    };
+
     trackNameLabel.setFont (juce::Font (juce::FontOptions (15.f)));
     trackNameLabel.setColour (juce::Label::textColourId, juce::Colours::white.darker (0.1));
     trackNameLabel.setJustificationType (juce::Justification::centred);
@@ -171,6 +183,15 @@ void TrackHeaderComponent::setArmed (const bool shouldBeArmed)
 
 void TrackHeaderComponent::setArmButtonEnabled (const bool enabled) { recordArmButton.setEnabled (enabled); }
 
+void TrackHeaderComponent::setFreezeState (const bool isFrozen, const double freezeProgress)
+{
+    const bool freezing = freezeProgress >= 0.0;
+
+    freezeButton.setToggleState (isFrozen || freezing, juce::dontSendNotification);
+    freezeButton.setButtonText (freezing ? juce::String (juce::roundToInt (freezeProgress * 100.0)) + "%"
+                                         : isFrozen ? "Frozen" : "Freeze");
+}
+
 void TrackHeaderComponent::setDimmed (const bool dim)
 {
     setAlpha (dim ? 0.6f : 1.0f);
@@ -259,4 +280,9 @@ void TrackHeaderComponent::resized()
     fb.items.add (juce::FlexItem (recordArmButton).withHeight (buttonH).withMargin (margin));
 
     fb.performLayout (area);  // <— layout into the leftover area
+
+    // Freeze shares the settings row
+    auto settingsRow = settingsButton.getBounds();
+    freezeButton.setBounds (settingsRow.removeFromRight (settingsRow.getWidth() / 2).withTrimmedLeft (gap / 2));
+    settingsButton.setBounds (settingsRow.withTrimmedRight (gap / 2));
 }
\ No newline at end of file
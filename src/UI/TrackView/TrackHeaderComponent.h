@@ -21,6 +21,7 @@ public:
         virtual void onInstrumentClicked() = 0;
         virtual void onInstrumentMenuRequested() = 0;
         virtual void onRecordArmToggled(bool isArmed) = 0;
+        virtual void onFreezeToggled (bool shouldBeFrozen) = 0;
     };
 
     void addListener (Listener* listener) { listeners.add (listener); }
@@ -41,6 +42,9 @@ public:
     void setArmed (bool shouldBeArmed);
     bool isArmed() const;
     void setArmButtonEnabled(bool enabled);
+
+    /** Shows the freeze toggle as frozen or not; a @p freezeProgress of 0..1 shows a freeze in progress. */
+    void setFreezeState (bool isFrozen, double freezeProgress = -1.0);
     void setDimmed (bool dim);
 
     void setTrackName (juce::String name);
@@ -68,6 +72,7 @@ private:
     juce::TextButton muteTrackButton { "M" };
     juce::TextButton soloTrackButton { "S" };
     juce::TextButton recordArmButton { "R" };
+    juce::TextButton freezeButton { "Freeze" };
     juce::Label trackNameLabel { "Track" };
     bool selected = false;
 
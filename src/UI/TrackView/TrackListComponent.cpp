@@ -190,6 +190,9 @@ TrackListComponent::TrackListComponent (const std::shared_ptr<AppEngine>& engine
 
         repaint();
     };
+
+    // Freeze toggles and progress on the headers
+    appEngine->addFreezeListener (this);
 }
 
 /**
@@ -216,9 +219,15 @@ TrackListComponent::~TrackListComponent()
     {
         appEngine->onBpmChanged = nullptr;
         appEngine->onArmedTrackChanged = nullptr;
+        appEngine->removeFreezeListener (this);
     }
 }
 
+void TrackListComponent::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    refreshTrackStates();
+}
+
 void TrackListComponent::paint (juce::Graphics& g)
 {
     g.fillAll (juce::Colour (0xFF343A40)); // Dark background for track area
@@ -440,7 +449,13 @@ void TrackListComponent::refreshTrackStates() const
     for (int i = 0; i < headers.size(); ++i)
     {
         if (headers[i] != nullptr)
+        {
             headers[i]->setArmed (appEngine->getArmedTrackIndex() == i);
+
+            const auto freezeState = appEngine->getTrackFreezeState (i);
+            headers[i]->setFreezeState (freezeState == TrackFreezer::State::frozen,
+                                        freezeState == TrackFreezer::State::freezing ? appEngine->getTrackFreezeProgress (i) : -1.0);
+        }
     }
 }
 
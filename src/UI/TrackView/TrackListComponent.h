@@ -46,7 +46,8 @@ namespace t = tracktion;
  *  - Call setViewStartBeat() to update horizontal scroll position
  *  - Use getTrackIndexAtY() to convert mouse Y to track index for drag/drop
  */
-class TrackListComponent final : public juce::Component
+class TrackListComponent final : public juce::Component,
+                                 private juce::ChangeListener
 {
 public:
     //==============================================================================
@@ -104,9 +105,10 @@ public:
     // Track Management
 
     /**
-     * @brief Refreshes mute/solo/arm button states from engine.
+     * @brief Refreshes mute/solo/arm/freeze button states from engine.
      *
      * Updates visual state of all track header buttons to match AppEngine state.
+     * Also called whenever a track's freeze state or progress changes.
      */
     void refreshTrackStates() const;
 
@@ -253,6 +255,9 @@ public:
     void hideGhostClip();
 
 private:
+    /** Freeze state or progress changed (AppEngine::addFreezeListener). */
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
     //==============================================================================
     // Member Variables
 
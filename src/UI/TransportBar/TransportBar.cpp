@@ -53,6 +53,10 @@ void TransportBar::resized()
     auto metronomeArea = r.removeFromLeft(metronomeWidth).reduced(5, 8);
     metronomeButton.setBounds(metronomeArea);
 
+    // Loop recording mode next to the metronome
+    constexpr int loopRecordWidth = 120;
+    loopRecordBox.setBounds(r.removeFromLeft(loopRecordWidth).reduced(5, 8));
+
     // Center: Transport buttons
     constexpr int buttonSize = 20;
     constexpr int buttonGap = 10;
@@ -120,6 +124,18 @@ void TransportBar::setupButtons()
         appEngine->setClickTrackEnabled(metronomeButton.getToggleState());
     };
 
+    // Loop recording mode (item IDs are LoopRecordMode + 1)
+    addAndMakeVisible(loopRecordBox);
+    loopRecordBox.addItem("Loop: Replace", (int) MidiRecorder::LoopRecordMode::replace + 1);
+    loopRecordBox.addItem("Loop: Overdub", (int) MidiRecorder::LoopRecordMode::overdub + 1);
+    loopRecordBox.addItem("Loop: Takes", (int) MidiRecorder::LoopRecordMode::takes + 1);
+    loopRecordBox.setSelectedId((int) appEngine->getLoopRecordMode() + 1, juce::dontSendNotification);
+    loopRecordBox.setTooltip("What loop recording keeps when the loop wraps: only the last pass, "
+                             "every pass merged, or every pass as its own take");
+    loopRecordBox.onChange = [this] {
+        appEngine->setLoopRecordMode((MidiRecorder::LoopRecordMode) (loopRecordBox.getSelectedId() - 1));
+    };
+
     // View Switch Button - initialize with mixer icon (vertical lines)
     juce::Path mixerIcon;
     constexpr float lineWidth = 0.08f;
@@ -76,6 +76,7 @@ private:
     juce::ShapeButton stopButton{"stop", {}, {}, {}};
     juce::ShapeButton recordButton{"record", {}, {}, {}};
     juce::ToggleButton metronomeButton{"Click"};
+    juce::ComboBox loopRecordBox;   ///< What loop recording keeps on each pass
     juce::ShapeButton switchButton{"switch", {}, {}, {}};
 
     // Custom LookAndFeel for matching text sizes (Written by Claude Code)
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AudioEngine/AudioCallbackMonitor.h"
+
+namespace
+{
+    struct Fixture
+    {
+        Fixture()  { dir.deleteRecursively(); }
+        ~Fixture() { dir.deleteRecursively(); }
+
+        juce::ScopedJuceInitialiser_GUI juceInit;
+        juce::File dir = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                             .getChildFile ("GrooveKitCallbackTest_" + juce::String::toHexString (juce::Random::getSystemRandom().nextInt()));
+        juce::File log = dir.getChildFile ("audio-callback.log");
+        AudioCallbackMonitor monitor { [] (juce::int64) { return 12.5; }, log };
+    };
+
+    constexpr double period = 0.01;   // 480 samples @ 48 kHz
+}
+
+TEST_CASE("AudioCallbackMonitor bins callbacks by share of the period", "[audio][callbackmonitor]")
+{
+    REQUIRE(AudioCallbackMonitor::getHistogramBin (0.0) == 0);
+    REQUIRE(AudioCallbackMonitor::getHistogramBin (0.25) == 2);
+    REQUIRE(AudioCallbackMonitor::getHistogramBin (0.99) == 9);
+    REQUIRE(AudioCallbackMonitor::getHistogramBin (1.2) == 10);
+    REQUIRE(AudioCallbackMonitor::getHistogramBin (3.0) == 11);
+
+    REQUIRE(AudioCallbackMonitor::getHistogramBinLabel (2) == "20-30%");
+    REQUIRE(AudioCallbackMonitor::getHistogramBinLabel (10) == "100-150%");
+    REQUIRE(AudioCallbackMonitor::getHistogramBinLabel (11) == ">150%");
+}
+
+TEST_CASE("AudioCallbackMonitor counts near misses and xruns", "[audio][callbackmonitor]")
+{
+    Fixture f;
+
+    f.monitor.addCallback (0.002, period);
+    f.monitor.addCallback (0.003, period);
+    f.monitor.addCallback (0.0085, period);   // near miss
+    f.monitor.addCallback (0.013, period);    // xrun
+    f.monitor.processPendingEvents();
+
+    const auto stats = f.monitor.getStats();
+    REQUIRE(stats.numCallbacks == 4);
+    REQUIRE(stats.numNearMisses == 1);
+    REQUIRE(stats.numXruns == 1);
+    REQUIRE(stats.histogram[1] + stats.histogram[2] + stats.histogram[3] == 2);
+    REQUIRE(stats.histogram[8] == 1);
+    REQUIRE(stats.histogram[10] == 1);
+    REQUIRE(stats.worstLoad > 1.29);
+
+    SECTION("events carry the load and transport position")
+    {
+        const auto events = f.monitor.getRecentEvents();
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].type == AudioCallbackMonitor::EventType::nearMiss);
+        REQUIRE(events[1].type == AudioCallbackMonitor::EventType::xrun);
+        REQUIRE(events[1].transportSeconds == 12.5);
+        REQUIRE(AudioCallbackMonitor::formatEvent (events[1]) == "XRUN: callback took 130.0% of the period at 0:12.500");
+    }
+
+    SECTION("events are appended to the log")
+    {
+        const auto text = f.log.loadFileAsString();
+        REQUIRE(text.contains ("Near miss: callback took 85.0%"));
+        REQUIRE(text.contains ("XRUN: callback took 130.0%"));
+    }
+
+    SECTION("reset clears the statistics but keeps the log")
+    {
+        f.monitor.reset();
+
+        REQUIRE(f.monitor.getStats().numCallbacks == 0);
+        REQUIRE(f.monitor.getRecentEvents().empty());
+        REQUIRE(f.log.existsAsFile());
+    }
+}
+
+TEST_CASE("AudioCallbackMonitor rolls the log over", "[audio][callbackmonitor]")
+{
+    Fixture f;
+    f.dir.createDirectory();
+    f.log.replaceWithText (juce::String::repeatedString ("x", (int) AudioCallbackMonitor::maxLogBytes + 1));
+
+    f.monitor.addCallback (0.02, period);
+    f.monitor.processPendingEvents();
+
+    const auto previous = f.dir.getChildFile ("audio-callback.1.log");
+    REQUIRE(previous.getSize() > AudioCallbackMonitor::maxLogBytes);
+    REQUIRE(f.log.getSize() < 1024);
+    REQUIRE(f.log.loadFileAsString().contains ("XRUN"));
+}
+
+TEST_CASE("AudioCallbackMonitor times callbacks against the device's schedule", "[audio][callbackmonitor]")
+{
+    Fixture f;
+
+    // Blocks due every period that each take 1 ms of CPU
+    for (int block = 0; block < 10; ++block)
+        f.monitor.timeCallback (1.0 + block * period + 0.001, 0.001, period);
+
+    SECTION("a block that waits is charged for the wait, not just its CPU time")
+    {
+        f.monitor.timeCallback (1.0 + 10 * period + 0.009, 0.001, period);
+        f.monitor.processPendingEvents();
+
+        const auto events = f.monitor.getRecentEvents();
+        REQUIRE(f.monitor.getStats().numCallbacks == 11);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == AudioCallbackMonitor::EventType::nearMiss);
+        REQUIRE(events[0].load == Catch::Approx (0.9).margin (0.01));
+        REQUIRE(events[0].cpuLoad == Catch::Approx (0.1).margin (0.01));
+        REQUIRE(AudioCallbackMonitor::formatEvent (events[0]).contains ("(10.0% on the CPU)"));
+    }
+
+    SECTION("the schedule starts again after an xrun")
+    {
+        f.monitor.timeCallback (1.0 + 10 * period + 0.012, 0.012, period);   // overruns by 2 ms
+        f.monitor.timeCallback (1.0 + 11 * period + 0.009, 0.001, period);   // the device resumed 8 ms later
+        f.monitor.timeCallback (1.0 + 12 * period + 0.009, 0.001, period);
+
+        const auto stats = f.monitor.getStats();
+        REQUIRE(stats.numXruns == 1);
+        REQUIRE(stats.numNearMisses == 0);
+    }
+}
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/AudioClock.h"
+
+TEST_CASE("AudioClock interpolates between device blocks", "[audioclock]")
+{
+    AudioClock clock;
+    clock.start(48000.0);
+
+    SECTION("Positions count the samples of published blocks")
+    {
+        clock.publishBlock(512, 1000.0);
+        REQUIRE(clock.getBlockStartSample() == 0);
+
+        clock.publishBlock(512, 1000.0 + 512.0 / 48.0);
+        REQUIRE(clock.getBlockStartSample() == 512);
+    }
+
+    SECTION("Arrival time inside a block maps to a sub-block sample offset")
+    {
+        clock.publishBlock(512, 1000.0);
+        clock.publishBlock(512, 1010.0);
+
+        // 2.5 ms after the block started = 120 samples at 48 kHz (sub-millisecond resolution)
+        REQUIRE(clock.getSamplePositionAt(1012.5) == 512 + 120);
+        REQUIRE(clock.getSamplePositionAt(1010.0) == 512);
+    }
+
+    SECTION("Estimates are clamped to two blocks if the device stalls")
+    {
+        clock.publishBlock(256, 1000.0);
+        REQUIRE(clock.getSamplePositionAt(5000.0) == 512);
+        REQUIRE(clock.getSamplePositionAt(900.0) == 0);
+    }
+
+    SECTION("Without a running device, positions follow the millisecond counter")
+    {
+        clock.stop();
+        REQUIRE(clock.getSamplePositionAt(1000.0) == 48000);
+        REQUIRE(clock.getSamplePositionAt(1001.0) == 48048);
+    }
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/AudioExporter.h"
+#include "TestEdit.h"
+
+namespace
+{
+    /** Gives @p track a test tone and an empty MIDI clip of @p seconds, so the edit has a length. */
+    void addToneContent (te::AudioTrack& track, double seconds)
+    {
+        track.insertMIDIClip ({ tracktion::TimePosition(), tracktion::TimePosition::fromSeconds (seconds) }, nullptr);
+
+        if (auto tone = track.edit.getPluginCache().createNewPlugin (te::ToneGeneratorPlugin::xmlTypeName, {}))
+            track.pluginList.insertPlugin (tone, 0, nullptr);
+    }
+
+    juce::File makeTestDir (const juce::String& name)
+    {
+        auto dir = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile (name);
+        dir.deleteRecursively();
+        return dir;
+    }
+}
+
+TEST_CASE("AudioExporter names stem files", "[export][stems]")
+{
+    SECTION("numbered, sortable names")
+    {
+        REQUIRE(AudioExporter::makeStemFileName ("Song", 1, "Drums") == "Song - 01 Drums.wav");
+        REQUIRE(AudioExporter::makeStemFileName ("Song", 12, "Bass") == "Song - 12 Bass.wav");
+    }
+
+    SECTION("track names are made filesystem-safe")
+    {
+        const auto name = AudioExporter::makeStemFileName ("Song", 3, "Lead: L/R \"wide\"");
+
+        REQUIRE_FALSE(name.containsAnyOf ("/\\:\"*?<>|"));
+        REQUIRE(name.endsWith (".wav"));
+        REQUIRE(name.startsWith ("Song - 03 Lead"));
+    }
+}
+
+TEST_CASE("AudioExporter estimates the time remaining", "[export][eta]")
+{
+    SECTION("unknown until the render has made some progress")
+    {
+        REQUIRE(AudioExporter::estimateSecondsRemaining (0.1, 0.5) < 0.0);
+        REQUIRE(AudioExporter::estimateSecondsRemaining (10.0, 0.01) < 0.0);
+        REQUIRE(AudioExporter::formatTimeRemaining (-1.0).isEmpty());
+    }
+
+    SECTION("extrapolates the current rate")
+    {
+        REQUIRE(AudioExporter::estimateSecondsRemaining (10.0, 0.25) == 30.0);
+        REQUIRE(AudioExporter::estimateSecondsRemaining (4.0, 1.0) == 0.0);
+    }
+
+    SECTION("formats minutes and hours")
+    {
+        REQUIRE(AudioExporter::formatTimeRemaining (0.4) == "less than a second left");
+        REQUIRE(AudioExporter::formatTimeRemaining (64.2) == "about 1:05 left");
+        REQUIRE(AudioExporter::formatTimeRemaining (3725.0) == "about 1:02:05 left");
+    }
+}
+
+TEST_CASE("AudioExporter renders one stem per audible track", "[export][stems]")
+{
+    TestEdit t (4);
+    const juce::StringArray trackNames { "Drums", "Muted", "Empty", "Bass" };
+
+    for (int i = 0; i < trackNames.size(); ++i)
+        t.track (i).setName (trackNames[i]);
+
+    addToneContent (t.track (0), 1.0);
+    addToneContent (t.track (1), 1.0);
+    addToneContent (t.track (3), 2.0);
+    t.track (1).setMute (true);
+
+    const auto dir = makeTestDir ("GrooveKitExportStemTest");
+    AudioExporter exporter (t.engine, 2);
+    AudioExporter::Result result;
+
+    REQUIRE(exporter.startStems (t.edit->state, {}, dir, "Song", 44100.0, {},
+                                 [&] (const AudioExporter::Result& r) { result = r; }));
+    REQUIRE(exporter.waitForCompletion (60000));
+    REQUIRE(result.ok);
+
+    // Muted and empty tracks get no file; numbers follow the track order
+    juce::StringArray fileNames;
+    for (const auto& file : result.files)
+        fileNames.add (file.getFileName());
+
+    REQUIRE(fileNames == juce::StringArray { "Song - 01 Drums.wav", "Song - 04 Bass.wav", "Song - Master.wav" });
+
+    // Every file covers the whole song and has the tone in it
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    for (const auto& file : result.files)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+        REQUIRE(reader != nullptr);
+        REQUIRE(reader->lengthInSamples >= 2 * 44100 - 512);
+
+        juce::Range<float> levels[2];
+        reader->readMaxLevels (0, reader->lengthInSamples, levels, 2);
+        REQUIRE(levels[0].getEnd() > 0.01f);
+    }
+
+    dir.deleteRecursively();
+}
+
+TEST_CASE("AudioExporter cancels renders cleanly", "[export][stems]")
+{
+    TestEdit t (3);
+
+    // Long enough that cancelling always lands mid-render
+    for (int i = 0; i < 3; ++i)
+        addToneContent (t.track (i), 20.0 * 60.0);
+
+    const auto dir = makeTestDir ("GrooveKitExportCancelTest");
+    AudioExporter exporter (t.engine, 2);
+
+    AudioExporter::Result result;
+    int numCompletions = 0;
+
+    REQUIRE(exporter.startStems (t.edit->state, {}, dir, "Cancel", 44100.0, {},
+                                 [&] (const AudioExporter::Result& r) { result = r; ++numCompletions; }));
+    REQUIRE(exporter.isRunning());
+
+    juce::Thread::sleep (200);
+    exporter.cancel();
+
+    // Every task has stopped before cancel() returns, and nothing it wrote is left
+    REQUIRE_FALSE(exporter.isRunning());
+    REQUIRE(numCompletions == 1);
+    REQUIRE(result.cancelled);
+    REQUIRE_FALSE(result.ok);
+    REQUIRE(result.files.isEmpty());
+    REQUIRE(dir.findChildFiles (juce::File::findFiles, false).isEmpty());
+
+    dir.deleteRecursively();
+}
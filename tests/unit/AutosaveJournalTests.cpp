@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/AutosaveJournal.h"
+#include "TestProject.h"
+
+namespace
+{
+    // One of each kind of change the journal records
+    void editProject (juce::ValueTree& edit)
+    {
+        edit.setProperty (te::IDs::bpm, 98.5, nullptr);
+        edit.getChild (0).removeProperty (te::IDs::name, nullptr);
+
+        auto seq = getTestSequence (edit, 1);
+        seq.getChild (3).setProperty (te::IDs::v, 64, nullptr);
+        seq.removeChild (5, nullptr);
+        seq.moveChild (0, 10, nullptr);
+        seq.addChild (makeTestNote (72, 99.0), 2, nullptr);
+
+        juce::ValueTree clip (te::IDs::MIDICLIP);
+        clip.appendChild (juce::ValueTree (te::IDs::SEQUENCE), nullptr);
+
+        juce::ValueTree track (te::IDs::TRACK);
+        track.appendChild (clip, nullptr);
+        edit.addChild (track, 1, nullptr);
+        getTestSequence (edit, 1).appendChild (makeTestNote (40, 0.0), nullptr);
+    }
+
+    juce::File journalFile (const juce::File& dir, int gen)
+    {
+        return dir.getChildFile ("journal_" + juce::String (gen) + ".gkj");
+    }
+
+    struct Fixture
+    {
+        Fixture()  { dir.deleteRecursively(); }
+        ~Fixture() { journal.stop (false); dir.deleteRecursively(); }
+
+        juce::ScopedJuceInitialiser_GUI juceInit;
+        juce::File dir = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                             .getChildFile ("GrooveKitJournalTest_" + juce::String::toHexString (juce::Random::getSystemRandom().nextInt()));
+        ProjectSaver saver;
+        AutosaveJournal journal { saver };
+        juce::ValueTree project = makeTestProject (3, 16);
+
+        void crash()
+        {
+            journal.flush();
+            REQUIRE(saver.waitForPendingSaves (5000));
+        }
+    };
+}
+
+TEST_CASE("AutosaveJournal replays changes over the snapshot", "[project][autosave]")
+{
+    Fixture f;
+    const auto editFile = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("song.tracktionedit");
+    f.journal.start (f.dir, f.project, editFile);
+
+    SECTION("Every kind of change survives a crash")
+    {
+        editProject (f.project);
+        f.crash();
+
+        REQUIRE(AutosaveJournal::hasRecoverableSession (f.dir));
+
+        juce::File recoveredFile;
+        const auto recovered = AutosaveJournal::recover (f.dir, &recoveredFile);
+        REQUIRE(recovered.isEquivalentTo (f.project));
+        REQUIRE(recoveredFile == editFile);
+    }
+
+    SECTION("Changes after a compaction replay over the new snapshot")
+    {
+        editProject (f.project);
+        f.journal.compact();
+        REQUIRE(f.journal.getBytesSinceCompaction() == 0);
+
+        f.project.getChild (0).setProperty (te::IDs::name, "After compaction", nullptr);
+        f.crash();
+
+        REQUIRE(AutosaveJournal::recover (f.dir).isEquivalentTo (f.project));
+    }
+
+    SECTION("Journal growth scales with the change, not the project")
+    {
+        f.journal.flush();
+        const auto before = journalFile (f.dir, 0).getSize();
+
+        getTestSequence (f.project, 2).getChild (7).setProperty (te::IDs::p, 61, nullptr);
+        f.journal.flush();
+
+        REQUIRE(journalFile (f.dir, 0).getSize() - before < 64);
+    }
+
+    SECTION("A torn final record is dropped and earlier ones kept")
+    {
+        f.project.setProperty (te::IDs::bpm, 140.0, nullptr);
+        const auto expected = f.project.createCopy();
+        f.project.getChild (0).setProperty (te::IDs::name, "Lost in the crash", nullptr);
+        f.crash();
+
+        const auto file = journalFile (f.dir, 0);
+        juce::MemoryBlock data;
+        REQUIRE(file.loadFileAsData (data));
+        data.setSize (data.getSize() - 3);
+        REQUIRE(file.replaceWithData (data.getData(), data.getSize()));
+
+        REQUIRE(AutosaveJournal::recover (f.dir).isEquivalentTo (expected));
+    }
+
+    SECTION("A clean stop leaves nothing to recover")
+    {
+        editProject (f.project);
+        f.journal.stop (true);
+
+        REQUIRE_FALSE(AutosaveJournal::hasRecoverableSession (f.dir));
+    }
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AppEngine/DspLoadMonitor.h"
+
+TEST_CASE("DspLoadCounter reports load as a fraction of real time", "[dspload]")
+{
+    DspLoadCounter counter;
+
+    SECTION("average over the interval, worst single callback as peak")
+    {
+        // Two 10 ms blocks: 2 ms and 6 ms of work
+        counter.addCallback (0.002, 480, 48000.0);
+        counter.addCallback (0.006, 480, 48000.0);
+
+        const auto f = counter.take();
+        REQUIRE(f.numCallbacks == 2);
+        REQUIRE(f.average == Catch::Approx (0.4));
+        REQUIRE(f.peak == Catch::Approx (0.6));
+    }
+
+    SECTION("taking the figures starts a new interval")
+    {
+        counter.addCallback (0.005, 480, 48000.0);
+        counter.take();
+
+        const auto f = counter.take();
+        REQUIRE(f.numCallbacks == 0);
+        REQUIRE(f.average == 0.0);
+        REQUIRE(f.peak == 0.0);
+    }
+
+    SECTION("empty blocks are ignored")
+    {
+        counter.addCallback (0.001, 0, 48000.0);
+        counter.addCallback (0.001, 480, 0.0);
+        REQUIRE(counter.take().numCallbacks == 0);
+    }
+
+    SECTION("the scoped timer adds one callback")
+    {
+        {
+            const DspLoadCounter::ScopedTimer timer (counter, 480, 48000.0);
+        }
+
+        const auto f = counter.take();
+        REQUIRE(f.numCallbacks == 1);
+        REQUIRE(f.average >= 0.0);
+    }
+}
+
+TEST_CASE("DspLoadMonitor formats CSV rows", "[dspload]")
+{
+    DspLoadMonitor::Row row;
+    row.timeSeconds = 1.25;
+    row.trackIndex  = 2;
+    row.trackName   = "Lead \"Hook\", Bar 5";
+    row.pluginName  = "Morph Synth";
+    row.pluginKind  = "morph";
+    row.load        = { 0.123, 0.5 };
+
+    REQUIRE(DspLoadMonitor::getCsvHeader() == "time_s,track_index,track,plugin,kind,avg_load_pct,peak_load_pct");
+    REQUIRE(DspLoadMonitor::toCsvLine (row) == "1.250,2,\"Lead \"\"Hook\"\", Bar 5\",\"Morph Synth\",morph,12.30,50.00");
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <cstdlib>
+
+/**
+ * Plugin format for scan tests: every *.fakeplug file is a plugin with one type.
+ *
+ * Stub plugins misbehave by name, to exercise out-of-process scanning:
+ *  - "Hang*"  never returns from findAllTypesForFile
+ *  - "Crash*" aborts the process
+ *  - "Empty*" has no types (a failed scan)
+ */
+class FakePluginFormat final : public juce::AudioPluginFormat
+{
+public:
+    int numInstantiations = 0;
+
+    juce::String getName() const override { return "Fake"; }
+
+    void findAllTypesForFile (juce::OwnedArray<juce::PluginDescription>& results,
+                              const juce::String& fileOrIdentifier) override
+    {
+        ++numInstantiations;
+
+        const auto name = juce::File (fileOrIdentifier).getFileNameWithoutExtension();
+
+        if (name.startsWith ("Hang"))
+            for (;;)
+                juce::Thread::sleep (1000);
+
+        if (name.startsWith ("Crash"))
+            std::abort();
+
+        if (name.startsWith ("Empty"))
+            return;
+
+        auto* desc = results.add (new juce::PluginDescription());
+        desc->name = name;
+        desc->pluginFormatName = getName();
+        desc->fileOrIdentifier = fileOrIdentifier;
+        desc->uniqueId = fileOrIdentifier.hashCode();
+    }
+
+    bool fileMightContainThisPluginType (const juce::String& f) override      { return f.endsWith (".fakeplug"); }
+    juce::String getNameOfPluginFromIdentifier (const juce::String& f) override { return f; }
+    bool pluginNeedsRescanning (const juce::PluginDescription&) override       { return false; }
+    bool doesPluginStillExist (const juce::PluginDescription& d) override      { return juce::File (d.fileOrIdentifier).exists(); }
+    bool canScanForPlugins() const override                                     { return true; }
+    bool isTrivialToScan() const override                                       { return false; }
+    juce::FileSearchPath getDefaultLocationsToSearch() override                 { return {}; }
+
+    juce::StringArray searchPathsForPlugins (const juce::FileSearchPath& path, bool, bool) override
+    {
+        juce::StringArray found;
+        for (int i = 0; i < path.getNumPaths(); ++i)
+            for (const auto& f : path[i].findChildFiles (juce::File::findFiles, false, "*.fakeplug"))
+                found.add (f.getFullPathName());
+        return found;
+    }
+
+protected:
+    void createPluginInstance (const juce::PluginDescription&, double, int, PluginCreationCallback callback) override
+    {
+        callback (nullptr, "Fake plugins can't be instantiated");
+    }
+
+    bool requiresUnblockedMessageThreadDuringCreation (const juce::PluginDescription&) const override { return false; }
+};
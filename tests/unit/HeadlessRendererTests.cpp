@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/HeadlessRenderer.h"
+#include "AppEngine/ProjectSaver.h"
+#include "TestEdit.h"
+
+namespace
+{
+    juce::StringArray argsFrom (const juce::String& commandLine)
+    {
+        return juce::StringArray::fromTokens (commandLine, " ", "\"");
+    }
+
+    /** Writes a project with a tone generator playing over a @p seconds long MIDI clip. */
+    void writeToneProject (const juce::File& file, double seconds)
+    {
+        TestEdit t;
+        auto& track = t.track (0);
+        track.insertMIDIClip ({ tracktion::TimePosition(), tracktion::TimePosition::fromSeconds (seconds) }, nullptr);
+
+        if (auto tone = t.edit->getPluginCache().createNewPlugin (te::ToneGeneratorPlugin::xmlTypeName, {}))
+            track.pluginList.insertPlugin (tone, 0, nullptr);
+
+        t.edit->flushState();
+        REQUIRE(ProjectSaver::writeSnapshot (t.edit->state.createCopy(), file));
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> readWav (const juce::File& file)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        return std::unique_ptr<juce::AudioFormatReader> (formats.createReaderFor (file));
+    }
+}
+
+TEST_CASE("HeadlessRenderer parses the render command line", "[render][cli]")
+{
+    HeadlessRenderer::Options options;
+
+    SECTION("defaults")
+    {
+        const auto args = argsFrom ("--render song.tracktionedit out/song.wav");
+        REQUIRE(HeadlessRenderer::isRenderCommandLine (args));
+        REQUIRE(HeadlessRenderer::parseCommandLine (args, options).wasOk());
+
+        REQUIRE(options.input == juce::File::getCurrentWorkingDirectory().getChildFile ("song.tracktionedit"));
+        REQUIRE(options.output.getFileName() == "song.wav");
+        REQUIRE(options.rangeStart == 0.0);
+        REQUIRE(options.rangeEnd < 0.0);
+        REQUIRE(options.sampleRate == 48000.0);
+    }
+
+    SECTION("range, sample rate and bit depth")
+    {
+        const auto args = argsFrom ("--render in.gkproj \"/tmp/out dir/x.wav\" --range 1.5:12 --sr 96000 --bits 16");
+        REQUIRE(HeadlessRenderer::parseCommandLine (args, options).wasOk());
+
+        REQUIRE(options.output == juce::File ("/tmp/out dir/x.wav"));
+        REQUIRE(options.rangeStart == 1.5);
+        REQUIRE(options.rangeEnd == 12.0);
+        REQUIRE(options.sampleRate == 96000.0);
+        REQUIRE(options.bitDepth == 16);
+    }
+
+    SECTION("open-ended range")
+    {
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render a b --range 30:"), options).wasOk());
+        REQUIRE(options.rangeStart == 30.0);
+        REQUIRE(options.rangeEnd < 0.0);
+    }
+
+    SECTION("bad arguments are rejected")
+    {
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render only-input"), options).failed());
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render a b --range 5:2"), options).failed());
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render a b --range 5"), options).failed());
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render a b --sr 0"), options).failed());
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render a b --bits 12"), options).failed());
+        REQUIRE(HeadlessRenderer::parseCommandLine (argsFrom ("--render a b --loud"), options).failed());
+    }
+}
+
+TEST_CASE("HeadlessRenderer reports a missing project as a load error", "[render][cli]")
+{
+    HeadlessRenderer::Options options;
+    options.input = juce::File::getCurrentWorkingDirectory().getChildFile ("does-not-exist.tracktionedit");
+    options.output = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("never.wav");
+
+    juce::String error;
+    REQUIRE(HeadlessRenderer::render (options, error) == HeadlessRenderer::loadError);
+    REQUIRE(error.isNotEmpty());
+}
+
+TEST_CASE("HeadlessRenderer renders a project to a WAV file", "[render][cli]")
+{
+    juce::ScopedJuceInitialiser_GUI gui;
+
+    const auto dir = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("GrooveKitRenderTest");
+    dir.deleteRecursively();
+
+    HeadlessRenderer::Options options;
+    options.input = dir.getChildFile ("Tone.tracktionedit");
+    options.output = dir.getChildFile ("out").getChildFile ("Tone.wav");
+    options.sampleRate = 44100.0;
+    options.bitDepth = 16;
+
+    REQUIRE(options.input.getParentDirectory().createDirectory());
+    writeToneProject (options.input, 2.0);
+
+    juce::String error;
+
+    SECTION("the whole edit")
+    {
+        REQUIRE(HeadlessRenderer::render (options, error) == HeadlessRenderer::success);
+
+        auto reader = readWav (options.output);
+        REQUIRE(reader != nullptr);
+        REQUIRE(reader->sampleRate == 44100.0);
+        REQUIRE(reader->bitsPerSample == 16);
+        REQUIRE(reader->numChannels == 2);
+        REQUIRE(std::abs (reader->lengthInSamples - 2 * 44100) <= 512);
+    }
+
+    SECTION("a range")
+    {
+        options.rangeStart = 0.5;
+        options.rangeEnd = 1.5;
+        options.bitDepth = 24;
+
+        REQUIRE(HeadlessRenderer::render (options, error) == HeadlessRenderer::success);
+
+        auto reader = readWav (options.output);
+        REQUIRE(reader != nullptr);
+        REQUIRE(reader->bitsPerSample == 24);
+        REQUIRE(std::abs (reader->lengthInSamples - 44100) <= 512);
+    }
+
+    SECTION("a range past the end of the edit")
+    {
+        options.rangeStart = 10.0;
+
+        REQUIRE(HeadlessRenderer::render (options, error) == HeadlessRenderer::renderError);
+        REQUIRE_FALSE(options.output.existsAsFile());
+    }
+
+    dir.deleteRecursively();
+}
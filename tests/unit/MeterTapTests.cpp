@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AudioEngine/MeterTap.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    /** Feeds @p seconds of a 997 Hz sine (the BS.1770 reference tone) in blocks. */
+    void feedSine (MeterTap& meter, float leftGain, float rightGain, double seconds, int numChannels = 2)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, blockSize);
+        const int total = (int) (seconds * sampleRate);
+        const double step = juce::MathConstants<double>::twoPi * 997.0 / sampleRate;
+
+        for (int done = 0; done < total; done += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto s = (float) std::sin ((done + i) * step);
+                buffer.setSample (0, i, s * leftGain);
+
+                if (numChannels > 1)
+                    buffer.setSample (1, i, s * rightGain);
+            }
+
+            meter.process (buffer, 0, blockSize);
+        }
+    }
+}
+
+TEST_CASE("MeterTap reports peak and RMS per channel", "[audio][metertap]")
+{
+    MeterTap meter;
+    meter.prepare (sampleRate);
+
+    feedSine (meter, 1.0f, 0.5f, 2.0);
+    const auto r = meter.read();
+
+    REQUIRE(r.fresh);
+    REQUIRE(r.peak[0] == Catch::Approx (1.0f).margin (0.001));
+    REQUIRE(r.peak[1] == Catch::Approx (0.5f).margin (0.001));
+    REQUIRE(r.rms[0] == Catch::Approx (0.7071f).margin (0.01));
+    REQUIRE(r.rms[1] == Catch::Approx (0.3536f).margin (0.01));
+
+    SECTION("reading starts a new peak interval")
+    {
+        const auto again = meter.read();
+        REQUIRE_FALSE(again.fresh);
+        REQUIRE(again.peak[0] == 0.0f);
+        REQUIRE(again.rms[0] == Catch::Approx (0.7071f).margin (0.01));
+    }
+}
+
+TEST_CASE("MeterTap measures short-term loudness per BS.1770", "[audio][metertap]")
+{
+    MeterTap meter;
+    meter.prepare (sampleRate);
+
+    REQUIRE(meter.read().shortTermLufs == MeterTap::minLufs);
+
+    SECTION("full-scale reference tone in both channels reads 0 LUFS")
+    {
+        feedSine (meter, 1.0f, 1.0f, 4.0);
+        REQUIRE(meter.read().shortTermLufs == Catch::Approx (0.0f).margin (0.1));
+    }
+
+    SECTION("one channel only reads 3 dB lower")
+    {
+        feedSine (meter, 1.0f, 0.0f, 4.0);
+        REQUIRE(meter.read().shortTermLufs == Catch::Approx (-3.01f).margin (0.1));
+    }
+
+    SECTION("-20 dB tone reads -20 LUFS")
+    {
+        const auto gain = juce::Decibels::decibelsToGain (-20.0f);
+        feedSine (meter, gain, gain, 4.0);
+        REQUIRE(meter.read().shortTermLufs == Catch::Approx (-20.0f).margin (0.1));
+    }
+}
+
+TEST_CASE("MeterTap shows a mono signal on both meters", "[audio][metertap]")
+{
+    MeterTap meter;
+    meter.prepare (sampleRate);
+
+    feedSine (meter, 0.5f, 0.0f, 4.0, 1);
+    const auto r = meter.read();
+
+    REQUIRE(r.peak[1] == r.peak[0]);
+    REQUIRE(r.rms[1] == r.rms[0]);
+    REQUIRE(r.shortTermLufs == Catch::Approx (-9.03f).margin (0.1));   // one channel, -6.02 dB
+}
+
+TEST_CASE("MeterTap::prepare clears the readings", "[audio][metertap]")
+{
+    MeterTap meter;
+    meter.prepare (sampleRate);
+    feedSine (meter, 1.0f, 1.0f, 1.0);
+
+    meter.prepare (44100.0);
+    const auto r = meter.read();
+
+    REQUIRE_FALSE(r.fresh);
+    REQUIRE(r.peak[0] == 0.0f);
+    REQUIRE(r.rms[0] == 0.0f);
+    REQUIRE(r.shortTermLufs == MeterTap::minLufs);
+}
@@ -0,0 +1,400 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AppEngine/MidiRecorder.h"
+#include "TestEdit.h"
+
+namespace
+{
+    void addOn(juce::MidiMessageSequence& seq, double time, int note, int channel = 1, float velocity = 0.8f)
+    {
+        seq.addEvent(juce::MidiMessage::noteOn(channel, note, velocity).withTimeStamp(time));
+    }
+
+    void addOff(juce::MidiMessageSequence& seq, double time, int note, int channel = 1)
+    {
+        seq.addEvent(juce::MidiMessage::noteOff(channel, note).withTimeStamp(time));
+    }
+
+    /** A dense loop take: 16th-note hi-hats plus a kick, as pairs of on/off events. */
+    juce::MidiMessageSequence makeDenseTake(int numEvents)
+    {
+        juce::MidiMessageSequence seq;
+        const double step = 0.125;
+
+        for (int i = 0; i < numEvents / 2; ++i)
+        {
+            const int note = (i % 4 == 0) ? 36 : 42;
+            addOn(seq, i * step, note);
+            addOff(seq, i * step + 0.05, note);
+        }
+
+        return seq;
+    }
+
+    /** The original forward-search pairing, kept as a reference. */
+    std::vector<MidiRecorder::RecordedNote> pairQuadratic(const juce::MidiMessageSequence& seq)
+    {
+        std::vector<MidiRecorder::RecordedNote> notes;
+
+        for (int i = 0; i < seq.getNumEvents(); ++i)
+        {
+            const auto& msg = seq.getEventPointer(i)->message;
+            if (!msg.isNoteOn())
+                continue;
+
+            double end = msg.getTimeStamp() + 0.1;
+            for (int j = i + 1; j < seq.getNumEvents(); ++j)
+            {
+                const auto& off = seq.getEventPointer(j)->message;
+                if (off.isNoteOff() && off.getNoteNumber() == msg.getNoteNumber())
+                {
+                    end = off.getTimeStamp();
+                    break;
+                }
+            }
+
+            notes.push_back({msg.getNoteNumber(), msg.getChannel(), msg.getTimeStamp(), end, msg.getFloatVelocity()});
+        }
+
+        return notes;
+    }
+
+    te::MidiClip* findMidiClip(te::AudioTrack& track)
+    {
+        for (auto* clip : track.getClips())
+            if (auto* midiClip = dynamic_cast<te::MidiClip*>(clip))
+                return midiClip;
+
+        return nullptr;
+    }
+}
+
+TEST_CASE("Recorded note pairing", "[midirecorder]")
+{
+    SECTION("Note-ons pair with the next note-off of the same note")
+    {
+        juce::MidiMessageSequence seq;
+        addOn(seq, 0.0, 60);
+        addOn(seq, 0.5, 64);
+        addOff(seq, 1.0, 60);
+        addOff(seq, 1.5, 64);
+
+        auto notes = MidiRecorder::pairRecordedNotes(seq);
+
+        REQUIRE(notes.size() == 2);
+        REQUIRE(notes[0].noteNumber == 60);
+        REQUIRE(notes[0].startSeconds == 0.0);
+        REQUIRE(notes[0].endSeconds == 1.0);
+        REQUIRE(notes[1].noteNumber == 64);
+        REQUIRE(notes[1].startSeconds == 0.5);
+        REQUIRE(notes[1].endSeconds == 1.5);
+    }
+
+    SECTION("Notes without a note-off default to 100ms")
+    {
+        juce::MidiMessageSequence seq;
+        addOn(seq, 2.0, 60);
+
+        auto notes = MidiRecorder::pairRecordedNotes(seq);
+
+        REQUIRE(notes.size() == 1);
+        REQUIRE(notes[0].endSeconds == 2.1);
+    }
+
+    SECTION("Channels are paired independently")
+    {
+        juce::MidiMessageSequence seq;
+        addOn(seq, 0.0, 60, 1);
+        addOn(seq, 0.2, 60, 2);
+        addOff(seq, 0.4, 60, 2);
+        addOff(seq, 0.6, 60, 1);
+
+        auto notes = MidiRecorder::pairRecordedNotes(seq);
+
+        REQUIRE(notes.size() == 2);
+        REQUIRE(notes[0].channel == 1);
+        REQUIRE(notes[0].endSeconds == 0.6);
+        REQUIRE(notes[1].channel == 2);
+        REQUIRE(notes[1].endSeconds == 0.4);
+    }
+
+    SECTION("Stray note-offs are ignored")
+    {
+        juce::MidiMessageSequence seq;
+        addOff(seq, 0.0, 60);
+        addOn(seq, 0.5, 60);
+        addOff(seq, 1.0, 60);
+
+        auto notes = MidiRecorder::pairRecordedNotes(seq);
+
+        REQUIRE(notes.size() == 1);
+        REQUIRE(notes[0].startSeconds == 0.5);
+        REQUIRE(notes[0].endSeconds == 1.0);
+    }
+
+    SECTION("Overdubbed passes pair correctly from a take buffer")
+    {
+        // Pass 2 is appended after pass 1 but starts earlier on the timeline;
+        // the note held across the wrap was closed at the loop end (2.0 s).
+        std::vector<juce::MidiMessage> take {
+            juce::MidiMessage::noteOn(1, 60, 0.8f).withTimeStamp(0.5),
+            juce::MidiMessage::noteOn(1, 64, 0.8f).withTimeStamp(1.5),
+            juce::MidiMessage::noteOff(1, 60).withTimeStamp(1.0),
+            juce::MidiMessage::noteOff(1, 64).withTimeStamp(2.0),
+            juce::MidiMessage::noteOn(1, 60, 0.8f).withTimeStamp(0.25),
+            juce::MidiMessage::noteOff(1, 60).withTimeStamp(0.75),
+        };
+
+        auto notes = MidiRecorder::pairRecordedNotes(take);
+
+        REQUIRE(notes.size() == 3);
+        REQUIRE(notes[0].endSeconds == 1.0);
+        REQUIRE(notes[1].endSeconds == 2.0);
+        REQUIRE(notes[2].startSeconds == 0.25);
+        REQUIRE(notes[2].endSeconds == 0.75);
+    }
+
+    SECTION("Matches the previous pairing for non-overlapping takes")
+    {
+        auto seq = makeDenseTake(2000);
+        auto fast = MidiRecorder::pairRecordedNotes(seq);
+        auto reference = pairQuadratic(seq);
+
+        REQUIRE(fast.size() == reference.size());
+        for (size_t i = 0; i < fast.size(); ++i)
+        {
+            REQUIRE(fast[i].noteNumber == reference[i].noteNumber);
+            REQUIRE(fast[i].startSeconds == reference[i].startSeconds);
+            REQUIRE(fast[i].endSeconds == reference[i].endSeconds);
+        }
+    }
+}
+
+TEST_CASE("Recording creates a clip with the played notes", "[midirecorder]")
+{
+    TestEdit t;
+    auto& transport = t.edit->getTransport();
+    MidiRecorder recorder(t.engine);
+
+    // 120 bpm: one beat every 0.5 s
+    recorder.startRecording(*t.edit, 0);
+    recorder.addRecordedEvent(1, 60, 0.8f, true, 0.5);
+    recorder.addRecordedEvent(1, 64, 0.5f, true, 1.0);
+    recorder.addRecordedEvent(1, 60, 0.0f, false, 1.25);
+    recorder.addRecordedEvent(1, 64, 0.0f, false, 2.0);
+    recorder.addRecordedEvent(1, 67, 1.0f, true, 2.5);
+    recorder.addRecordedEvent(1, 67, 0.0f, false, 3.0);
+
+    transport.setPosition(tracktion::TimePosition::fromSeconds(4.0));
+    REQUIRE(recorder.stopRecording(*t.edit));
+    transport.stop(false, false);
+
+    auto* clip = findMidiClip(t.track(0));
+    REQUIRE(clip != nullptr);
+    REQUIRE(clip->getPosition().getStart() == tracktion::TimePosition());
+
+    const auto& notes = clip->getSequence().getNotes();
+    REQUIRE(notes.size() == 3);
+
+    REQUIRE(notes[0]->getNoteNumber() == 60);
+    REQUIRE(notes[0]->getStartBeat().inBeats() == Catch::Approx(1.0));
+    REQUIRE(notes[0]->getLengthBeats().inBeats() == Catch::Approx(1.5));
+    REQUIRE(notes[0]->getVelocity() == 102);
+
+    REQUIRE(notes[1]->getNoteNumber() == 64);
+    REQUIRE(notes[1]->getStartBeat().inBeats() == Catch::Approx(2.0));
+    REQUIRE(notes[1]->getLengthBeats().inBeats() == Catch::Approx(2.0));
+    REQUIRE(notes[1]->getVelocity() == 64);
+
+    REQUIRE(notes[2]->getNoteNumber() == 67);
+    REQUIRE(notes[2]->getStartBeat().inBeats() == Catch::Approx(5.0));
+    REQUIRE(notes[2]->getLengthBeats().inBeats() == Catch::Approx(1.0));
+    REQUIRE(notes[2]->getVelocity() == 127);
+}
+
+TEST_CASE("Loop recording keeps passes across a wrap", "[midirecorder][loop]")
+{
+    TestEdit t;
+    auto& transport = t.edit->getTransport();
+    MidiRecorder recorder(t.engine);
+
+    // Two-second loop (one bar at 120 bpm) from the start of the edit
+    transport.setLoopRange({ tracktion::TimePosition(), tracktion::TimePosition::fromSeconds(2.0) });
+    transport.looping = true;
+
+    auto stopAt = [&](double seconds)
+    {
+        transport.setPosition(tracktion::TimePosition::fromSeconds(seconds));
+        const bool created = recorder.stopRecording(*t.edit);
+        transport.stop(false, false);
+        return created;
+    };
+
+    auto noteNumbers = [](te::MidiClip& clip)
+    {
+        std::vector<int> numbers;
+        for (auto* note : clip.getSequence().getNotes())
+            numbers.push_back(note->getNoteNumber());
+        return numbers;
+    };
+
+    SECTION("Takes: each pass is its own take, the last one active")
+    {
+        recorder.setLoopRecordMode(MidiRecorder::LoopRecordMode::takes);
+        recorder.startRecording(*t.edit, 0);
+        recorder.addRecordedEvent(1, 60, 0.8f, true, 0.5);
+        recorder.addRecordedEvent(1, 60, 0.0f, false, 1.0);
+        recorder.enterLoopPass(1);
+        recorder.addRecordedEvent(1, 62, 0.8f, true, 0.25);
+        recorder.addRecordedEvent(1, 62, 0.0f, false, 0.75);
+
+        REQUIRE(recorder.getNumTakes() == 2);
+        REQUIRE(stopAt(1.5));
+
+        auto* clip = findMidiClip(t.track(0));
+        REQUIRE(clip != nullptr);
+        REQUIRE(noteNumbers(*clip) == std::vector<int> { 62 });
+    }
+
+    SECTION("Takes: stopping right after a wrap keeps the finished pass")
+    {
+        recorder.setLoopRecordMode(MidiRecorder::LoopRecordMode::takes);
+        recorder.startRecording(*t.edit, 0);
+        recorder.addRecordedEvent(1, 60, 0.8f, true, 0.5);
+        recorder.addRecordedEvent(1, 60, 0.0f, false, 1.0);
+        recorder.addRecordedEvent(1, 64, 0.8f, true, 1.5);
+        recorder.enterLoopPass(1);
+
+        REQUIRE(stopAt(0.1));
+
+        auto* clip = findMidiClip(t.track(0));
+        REQUIRE(clip != nullptr);
+        REQUIRE(noteNumbers(*clip) == std::vector<int> { 60, 64 });
+
+        // The note held over the wrap was closed at the loop end
+        const auto& notes = clip->getSequence().getNotes();
+        REQUIRE(notes[1]->getStartBeat().inBeats() == Catch::Approx(3.0));
+        REQUIRE(notes[1]->getLengthBeats().inBeats() == Catch::Approx(1.0));
+    }
+
+    SECTION("Overdub: passes are merged in time order")
+    {
+        recorder.setLoopRecordMode(MidiRecorder::LoopRecordMode::overdub);
+        recorder.startRecording(*t.edit, 0);
+        recorder.addRecordedEvent(1, 60, 0.8f, true, 1.0);
+        recorder.addRecordedEvent(1, 60, 0.0f, false, 1.5);
+        recorder.enterLoopPass(1);
+        recorder.addRecordedEvent(1, 62, 0.8f, true, 0.5);
+        recorder.addRecordedEvent(1, 62, 0.0f, false, 0.75);
+
+        REQUIRE(recorder.getNumTakes() == 1);
+        REQUIRE(stopAt(1.0));
+
+        auto* clip = findMidiClip(t.track(0));
+        REQUIRE(clip != nullptr);
+        REQUIRE(noteNumbers(*clip) == std::vector<int> { 62, 60 });
+    }
+
+    SECTION("Overdub: stopping right after a wrap keeps every pass")
+    {
+        recorder.setLoopRecordMode(MidiRecorder::LoopRecordMode::overdub);
+        recorder.startRecording(*t.edit, 0);
+        recorder.addRecordedEvent(1, 60, 0.8f, true, 1.0);
+        recorder.addRecordedEvent(1, 60, 0.0f, false, 1.5);
+        recorder.enterLoopPass(1);
+        recorder.addRecordedEvent(1, 62, 0.8f, true, 0.5);
+        recorder.addRecordedEvent(1, 62, 0.0f, false, 0.75);
+        recorder.enterLoopPass(2);
+
+        REQUIRE(stopAt(0.1));
+
+        auto* clip = findMidiClip(t.track(0));
+        REQUIRE(clip != nullptr);
+        REQUIRE(noteNumbers(*clip) == std::vector<int> { 62, 60 });
+    }
+}
+
+TEST_CASE("Recorded note pairing benchmark", "[.][benchmark][midirecorder]")
+{
+    auto take = makeDenseTake(50000);
+
+    BENCHMARK("Single-pass pairing, 50k events")
+    {
+        return MidiRecorder::pairRecordedNotes(take).size();
+    };
+
+    BENCHMARK("Forward-search pairing, 50k events")
+    {
+        return pairQuadratic(take).size();
+    };
+
+    // Drum pads that never send note-offs: the forward search scans to the end
+    // of the take for every hit, so only the single-pass version is measured.
+    juce::MidiMessageSequence padHits;
+    for (int i = 0; i < 50000; ++i)
+        addOn(padHits, i * 0.0625, 36 + i % 8);
+
+    BENCHMARK("Single-pass pairing, 50k note-ons without note-offs")
+    {
+        return MidiRecorder::pairRecordedNotes(padHits).size();
+    };
+}
+
+TEST_CASE("Recording to a clip benchmark", "[.][benchmark][midirecorder]")
+{
+    TestEdit t;
+    auto& transport = t.edit->getTransport();
+    MidiRecorder recorder(t.engine);
+    const auto take = makeDenseTake(50000);
+
+    // Everything stopping a long take costs: pairing, tempo conversion and filling the clip
+    auto recordTake = [&]
+    {
+        transport.setPosition(tracktion::TimePosition());
+        recorder.startRecording(*t.edit, 0);
+
+        for (int i = 0; i < take.getNumEvents(); ++i)
+        {
+            const auto& m = take.getEventPointer(i)->message;
+            recorder.addRecordedEvent(m.getChannel(), m.getNoteNumber(), m.getFloatVelocity(), m.isNoteOn(), m.getTimeStamp());
+        }
+
+        transport.setPosition(tracktion::TimePosition::fromSeconds(take.getEndTime() + 1.0));
+        const bool created = recorder.stopRecording(*t.edit);
+        transport.stop(false, false);
+        return created;
+    };
+
+    REQUIRE(recordTake());
+    REQUIRE(findMidiClip(t.track(0))->getSequence().getNotes().size() == 25000);
+
+    BENCHMARK("Recording to a clip, 50k events")
+    {
+        return recordTake();
+    };
+
+    // The previous way of filling the clip: one note at a time into the live list
+    const auto notes = MidiRecorder::pairRecordedNotes(take);
+    const tracktion::TimeRange range { tracktion::TimePosition(), tracktion::TimePosition::fromSeconds(take.getEndTime() + 1.0) };
+
+    BENCHMARK("Appending the same notes to a live clip")
+    {
+        auto clip = t.track(0).insertMIDIClip("Append", range, nullptr);
+
+        for (const auto& note : notes)
+        {
+            juce::ValueTree noteState(te::IDs::NOTE);
+            noteState.setProperty(te::IDs::p, note.noteNumber, nullptr);
+            noteState.setProperty(te::IDs::b, note.startSeconds * 2.0, nullptr);   // 120 bpm
+            noteState.setProperty(te::IDs::l, (note.endSeconds - note.startSeconds) * 2.0, nullptr);
+            noteState.setProperty(te::IDs::v, juce::roundToInt(note.velocity * 127.0f), nullptr);
+            noteState.setProperty(te::IDs::c, 0, nullptr);
+            clip->getSequence().state.appendChild(noteState, nullptr);
+        }
+
+        const auto numNotes = clip->getSequence().getNotes().size();
+        clip->removeFromParent();
+        return numNotes;
+    };
+}
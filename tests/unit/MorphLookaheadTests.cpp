@@ -0,0 +1,407 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "UI/Plugins/Synthesizer/MorphLookahead.h"
+#include "MorphTestPatch.h"
+
+namespace
+{
+    using namespace MorphTest;
+
+    // A held sustain and a short release; no LFO or glide.
+    MorphParamSnapshot makeLookaheadParams()
+    {
+        auto p = makeTestParams();
+        p.set (MorphParam::cutoff, 8000.0f);
+        p.set (MorphParam::aA, 0.005f);
+        p.set (MorphParam::aF, 0.005f);
+        p.set (MorphParam::dA, 0.05f);
+        p.set (MorphParam::dF, 0.05f);
+        p.set (MorphParam::sA, 0.7f);
+        p.set (MorphParam::rA, 0.05f);
+        p.set (MorphParam::rF, 0.05f);
+        return p;
+    }
+
+    struct SampleNote { int start, end, noteNumber; };
+
+    std::vector<MorphLookahead::Note> toNotes (const std::vector<SampleNote>& notes)
+    {
+        std::vector<MorphLookahead::Note> result;
+
+        for (const auto& n : notes)
+        {
+            MorphLookahead::Note note;
+            note.startSeconds = n.start / sampleRate;
+            note.endSeconds   = n.end / sampleRate;
+            note.noteNumber   = n.noteNumber;
+            result.push_back (note);
+        }
+
+        return result;
+    }
+
+    /** MIDI for one block, as the clip would deliver it. */
+    void fillBlockMidi (juce::MidiBuffer& midi, const std::vector<SampleNote>& notes, int blockStart, int numSamples)
+    {
+        midi.clear();
+
+        for (const auto& n : notes)
+        {
+            if (n.end >= blockStart && n.end < blockStart + numSamples)
+                midi.addEvent (juce::MidiMessage::noteOff (1, n.noteNumber), n.end - blockStart);
+
+            if (n.start >= blockStart && n.start < blockStart + numSamples)
+                midi.addEvent (juce::MidiMessage::noteOn (1, n.noteNumber, 0.8f), n.start - blockStart);
+        }
+    }
+
+    struct Synth
+    {
+        explicit Synth (const MorphParamSnapshot& params)
+        {
+            synth.addSound (new TestSound());
+            synth.setMinimumRenderingSubdivisions (1);
+            synth.prepare (sampleRate, blockSize, &params);
+        }
+
+        MorphSynthesiser synth;
+    };
+
+    double rms (const juce::AudioBuffer<float>& b)
+    {
+        return b.getRMSLevel (0, 0, b.getNumSamples());
+    }
+
+    double rmsOfDifference (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        juce::AudioBuffer<float> diff (a);
+        diff.addFrom (0, 0, b, 0, 0, b.getNumSamples(), -1.0f);
+        return rms (diff);
+    }
+
+    double rmsIn (const juce::AudioBuffer<float>& b, int start, int end)
+    {
+        return b.getRMSLevel (0, start, end - start);
+    }
+
+    double rmsOfDifferenceIn (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start, int end)
+    {
+        juce::AudioBuffer<float> diff (a);
+        diff.addFrom (0, 0, b, 0, 0, b.getNumSamples(), -1.0f);
+        return rmsIn (diff, start, end);
+    }
+
+    using ParamChange = std::function<void (int, MorphParamSnapshot&)>;
+
+    /** Everything rendered live, block by block, the way the plugin does without look-ahead. */
+    juce::AudioBuffer<float> renderLive (const std::vector<SampleNote>& notes, int totalSamples,
+                                         const ParamChange& changeParams = {})
+    {
+        auto params = makeLookaheadParams();
+        Synth live (params);
+        juce::AudioBuffer<float> out (1, totalSamples);
+        out.clear();
+        juce::MidiBuffer midi;
+
+        for (int pos = 0; pos < totalSamples; pos += blockSize)
+        {
+            if (changeParams)
+                changeParams (pos, params);
+
+            fillBlockMidi (midi, notes, pos, blockSize);
+            live.synth.renderNextBlock (out, midi, pos, blockSize);
+        }
+
+        return out;
+    }
+
+    /**
+     * The plugin's look-ahead path: the worker (run inline) renders ahead, the
+     * live synth only gets the note-ons the buffer doesn't have. @p edit is
+     * called before each block so a test can change the notes mid-playback,
+     * @p changeParams likewise for the parameters; the worker is skipped for
+     * blocks where @p workerRunsAt returns false.
+     */
+    juce::AudioBuffer<float> renderWithLookahead (std::vector<SampleNote> notes, int totalSamples,
+                                                  MorphLookahead& lookahead,
+                                                  const std::function<void (int, std::vector<SampleNote>&)>& edit = {},
+                                                  const std::function<bool (int)>& workerRunsAt = {},
+                                                  const ParamChange& changeParams = {})
+    {
+        auto params = makeLookaheadParams();
+        Synth live (params);
+        juce::AudioBuffer<float> out (1, totalSamples);
+        out.clear();
+        juce::MidiBuffer midi;
+
+        lookahead.prepare (sampleRate, blockSize);
+        lookahead.setNotes (toNotes (notes));
+
+        for (int pos = 0; pos < totalSamples; pos += blockSize)
+        {
+            if (edit)
+            {
+                const auto before = notes.size();
+                edit (pos, notes);
+
+                if (notes.size() != before)
+                    lookahead.setNotes (toNotes (notes));
+            }
+
+            if (changeParams)
+                changeParams (pos, params);
+
+            const int liveNoteOnsUntil = lookahead.beginBlock (pos, blockSize, true, params);
+
+            if (! workerRunsAt || workerRunsAt (pos))
+                while (lookahead.renderAhead()) {}
+
+            fillBlockMidi (midi, notes, pos, blockSize);
+
+            juce::MidiBuffer liveMidi;
+            for (const auto metadata : midi)
+            {
+                const auto m = metadata.getMessage();
+                const bool playedByBuffer = metadata.samplePosition >= liveNoteOnsUntil;
+
+                if (! (m.isNoteOn() && playedByBuffer))
+                    liveMidi.addEvent (m, metadata.samplePosition + pos);
+
+                lookahead.trackNote (m, playedByBuffer);
+            }
+
+            lookahead.addHandedBackNotes (liveMidi, pos);
+            live.synth.renderNextBlock (out, liveMidi, pos, blockSize);
+            lookahead.addPrerendered (out, pos, blockSize);
+        }
+
+        return out;
+    }
+}
+
+TEST_CASE("MorphLookahead maps stream positions onto the timeline", "[morphsynth][lookahead]")
+{
+    SECTION("straight through without a loop")
+    {
+        REQUIRE(MorphLookahead::streamToEdit (0, 1000, {}) == 1000);
+        REQUIRE(MorphLookahead::streamToEdit (500, 1000, {}) == 1500);
+    }
+
+    SECTION("wraps at the loop end")
+    {
+        const MorphLookahead::LoopState loop { true, 1000, 2000 };
+
+        REQUIRE(MorphLookahead::streamToEdit (0, 1500, loop) == 1500);
+        REQUIRE(MorphLookahead::streamToEdit (499, 1500, loop) == 1999);
+        REQUIRE(MorphLookahead::streamToEdit (500, 1500, loop) == 1000);
+        REQUIRE(MorphLookahead::streamToEdit (1750, 1500, loop) == 1250);
+    }
+
+    SECTION("starting after the loop end plays straight through")
+    {
+        const MorphLookahead::LoopState loop { true, 1000, 2000 };
+        REQUIRE(MorphLookahead::streamToEdit (100, 2500, loop) == 2600);
+    }
+}
+
+TEST_CASE("MorphLookahead stays live when it can't help", "[morphsynth][lookahead]")
+{
+    const auto params = makeLookaheadParams();
+    MorphLookahead lookahead;
+    lookahead.prepare (sampleRate, blockSize);
+
+    SECTION("while stopped")
+    {
+        REQUIRE(lookahead.beginBlock (0, blockSize, false, params) == blockSize);
+    }
+
+    SECTION("while disabled (live input)")
+    {
+        lookahead.setEnabled (false);
+        REQUIRE(lookahead.beginBlock (0, blockSize, true, params) == blockSize);
+    }
+
+    SECTION("until the buffer has caught up with the playhead")
+    {
+        REQUIRE(lookahead.beginBlock (0, blockSize, true, params) == blockSize);
+        REQUIRE_FALSE(lookahead.isPlayingFromBuffer());
+    }
+}
+
+TEST_CASE("MorphLookahead sounds the same as live rendering", "[morphsynth][lookahead]")
+{
+    const int total = 48000;
+
+    // One note held across the hand-over, then notes only the buffer plays
+    const std::vector<SampleNote> notes {
+        { 1000, 20000, 48 },
+        { 6000, 9000, 60 },
+        { 10000, 30000, 64 },
+        { 14000, 16000, 67 },
+        { 36000, 40000, 72 }
+    };
+
+    const auto reference = renderLive (notes, total);
+
+    SECTION("hand-over from the live synth is seamless")
+    {
+        MorphLookahead lookahead;
+        const auto result = renderWithLookahead (notes, total, lookahead);
+
+        REQUIRE(lookahead.isPlayingFromBuffer());
+        REQUIRE(lookahead.getNumUnderruns() == 0);
+        REQUIRE(rms (reference) > 0.01);
+        REQUIRE(rmsOfDifference (result, reference) < rms (reference) * 0.01);   // at least 40 dB down
+    }
+
+    SECTION("editing notes mid-playback re-renders without re-attacking held notes")
+    {
+        auto edited = notes;
+        edited.push_back ({ 24000, 26000, 76 });
+        const auto editedReference = renderLive (edited, total);
+
+        // Add the note while note 64 is held and the buffer is already past it
+        MorphLookahead lookahead;
+        const auto result = renderWithLookahead (notes, total, lookahead,
+            [] (int pos, std::vector<SampleNote>& current)
+            {
+                if (pos == 12288)
+                    current.push_back ({ 24000, 26000, 76 });
+            });
+
+        REQUIRE(lookahead.getNumUnderruns() == 0);
+        REQUIRE(rmsOfDifference (result, editedReference) < rms (editedReference) * 0.01);
+    }
+}
+
+TEST_CASE("MorphLookahead falls back to live rendering when the worker falls behind", "[morphsynth][lookahead]")
+{
+    const int total = 48000;
+
+    // Note 60 comes from the buffer and is still held when the worker stalls;
+    // note 64 starts while the buffer has nothing for the playhead.
+    const std::vector<SampleNote> notes {
+        { 8000, 30000, 60 },
+        { 18000, 19500, 64 }
+    };
+
+    const auto reference = renderLive (notes, total);
+
+    MorphLookahead lookahead;
+    lookahead.setLookaheadSeconds (0.1);
+    const auto result = renderWithLookahead (notes, total, lookahead, {},
+                                             [] (int pos) { return pos < 12000 || pos >= 20000; });
+
+    REQUIRE(lookahead.getNumUnderruns() > 0);
+    REQUIRE(lookahead.isPlayingFromBuffer());
+
+    // The note that started during the stall was played live, not dropped
+    REQUIRE(rmsIn (reference, 18000, 19500) > 0.01);
+    REQUIRE(rmsIn (result, 18000, 19500) > rmsIn (reference, 18000, 19500) * 0.3);
+
+    // The next stream took over the held note without re-attacking it
+    REQUIRE(rmsOfDifferenceIn (result, reference, 24000, 29000) < rmsIn (reference, 24000, 29000) * 0.01);
+}
+
+TEST_CASE("MorphLookahead plays live while parameters move", "[morphsynth][lookahead]")
+{
+    const int total = 72000;
+    const int changeAt = 20480;   // a block start
+
+    // Note 48 comes from the buffer; note 64 starts after the parameters have settled again
+    const std::vector<SampleNote> notes {
+        { 8000, 50000, 48 },
+        { 56000, 60000, 64 }
+    };
+
+    const auto closeFilter = [changeAt] (int pos, MorphParamSnapshot& p)
+    {
+        if (pos == changeAt)
+            p.set (MorphParam::cutoff, 1500.0f);
+    };
+
+    const auto reference = renderLive (notes, total, closeFilter);
+
+    SECTION("the change is heard at once and held notes carry on")
+    {
+        MorphLookahead lookahead;
+        bool wasReadingBefore = false, wasLiveAfter = false;
+
+        const auto result = renderWithLookahead (notes, total, lookahead, {},
+            [&] (int pos)
+            {
+                if (pos == changeAt - blockSize)  wasReadingBefore = lookahead.isPlayingFromBuffer();
+                if (pos == changeAt + blockSize)  wasLiveAfter = ! lookahead.isPlayingFromBuffer();
+                return true;
+            },
+            closeFilter);
+
+        REQUIRE(wasReadingBefore);
+        REQUIRE(wasLiveAfter);
+        REQUIRE(lookahead.getNumUnderruns() == 0);
+
+        // Note 48 is restarted by the live synth with the new cutoff, not cut off
+        // (it re-attacks, so compare levels once it has reached its sustain)
+        const int from = changeAt + 4800, to = changeAt + 14400;
+        REQUIRE(rmsIn (result, from, to) == Catch::Approx (rmsIn (reference, from, to)).epsilon (0.1));
+
+        // The buffer took over again, rendering note 64 with the new cutoff
+        REQUIRE(lookahead.isPlayingFromBuffer());
+        REQUIRE(rmsOfDifferenceIn (result, reference, 56000, 60000) < rmsIn (reference, 56000, 60000) * 0.01);
+    }
+
+    SECTION("the buffer waits until the parameters have settled")
+    {
+        auto params = makeLookaheadParams();
+        MorphLookahead lookahead;
+        lookahead.prepare (sampleRate, blockSize);
+        lookahead.setNotes (toNotes (notes));
+
+        int pos = 0;
+        const auto playBlock = [&]
+        {
+            lookahead.beginBlock (pos, blockSize, true, params);
+            while (lookahead.renderAhead()) {}
+            pos += blockSize;
+        };
+
+        while (! lookahead.isPlayingFromBuffer() && pos < total)
+            playBlock();
+
+        REQUIRE(lookahead.isPlayingFromBuffer());
+
+        // Keep turning the knob: playback stays live the whole time
+        for (int i = 0; i < 100; ++i)
+        {
+            params.set (MorphParam::cutoff, 2000.0f + (float) i * 10.0f);
+            playBlock();
+            REQUIRE_FALSE(lookahead.isPlayingFromBuffer());
+        }
+
+        const int stoppedAt = pos;
+
+        while (! lookahead.isPlayingFromBuffer() && pos < total)
+            playBlock();
+
+        REQUIRE(lookahead.isPlayingFromBuffer());
+        REQUIRE(pos - stoppedAt >= (int) (MorphLookahead::paramSettleSeconds * sampleRate));
+    }
+}
+
+TEST_CASE("MorphSynthPlugin leaves pre-rendered note-ons out of the live MIDI", "[morphsynth][lookahead]")
+{
+    juce::Array<juce::MidiMessage> src;
+    src.add (juce::MidiMessage::noteOn (1, 60, 0.8f).withTimeStamp (10.0 / sampleRate));
+    src.add (juce::MidiMessage::noteOff (1, 48).withTimeStamp (100.0 / sampleRate));
+    src.add (juce::MidiMessage::noteOn (1, 64, 0.8f).withTimeStamp (200.0 / sampleRate));
+
+    juce::MidiBuffer dest;
+    MorphSynthPlugin::addMessagesToBuffer (dest, src, sampleRate, 0, blockSize, true, 150);
+
+    std::vector<int> notes;
+    for (const auto metadata : dest)
+        notes.push_back (metadata.getMessage().getNoteNumber());
+
+    REQUIRE(notes == std::vector<int> { 60, 48 });
+}
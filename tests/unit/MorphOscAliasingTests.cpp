@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "UI/Plugins/Synthesizer/MorphOsc.h"
+#include "UI/Plugins/Synthesizer/MorphSynthRegistration.h"
+#include "TestEdit.h"
+#include <vector>
+
+namespace
+{
+    constexpr int fftOrder = 13;
+    constexpr int fftSize  = 1 << fftOrder;
+    constexpr double sampleRate = 44100.0;
+
+    // Fundamental on FFT bin 700 (~3.77 kHz): the phase increment is exactly
+    // 700 / 8192, so one FFT frame holds a whole number of cycles and every
+    // harmonic - or alias - lands on an integer bin. No window needed.
+    constexpr int fundamentalBin = 700;
+    constexpr double fundamentalHz = sampleRate * fundamentalBin / fftSize;
+
+    std::vector<float> render (MorphOsc::Type type, bool bandLimited, int numSamples = fftSize)
+    {
+        MorphOsc osc;
+        osc.prepare (sampleRate);
+        osc.setBandLimited (bandLimited);
+        osc.setTypes (type, type);
+        osc.setMorph (0.0f);
+        osc.setPulseWidth (0.5f);
+        osc.setFrequency (fundamentalHz);
+
+        std::vector<float> out ((size_t) numSamples);
+        osc.renderBlock (out.data(), numSamples);
+        return out;
+    }
+
+    /** Energy outside the harmonic bins relative to energy on them, in dB. */
+    double aliasToHarmonicDb (const std::vector<float>& signal)
+    {
+        juce::dsp::FFT fft (fftOrder);
+        std::vector<float> data (2 * (size_t) fftSize, 0.0f);
+        std::copy (signal.begin(), signal.begin() + fftSize, data.begin());
+        fft.performFrequencyOnlyForwardTransform (data.data());
+
+        double harmonic = 0.0, alias = 0.0;
+        for (int bin = 1; bin <= fftSize / 2; ++bin)
+        {
+            const double power = (double) data[(size_t) bin] * data[(size_t) bin];
+            (bin % fundamentalBin == 0 ? harmonic : alias) += power;
+        }
+
+        return 10.0 * std::log10 (alias / harmonic + 1.0e-30);
+    }
+}
+
+TEST_CASE("Wavetable mip level stays below Nyquist", "[morphsynth][osc]")
+{
+    for (double inc : { 0.0001, 0.001, 0.01, 0.05, 0.1, 0.2, 0.45 })
+    {
+        const int level = MorphWavetables::levelForIncrement (inc);
+        REQUIRE(level >= 0);
+        REQUIRE(level < MorphWavetables::numLevels);
+        REQUIRE((1 << level) * inc < 0.5 + 1.0e-9);
+    }
+}
+
+TEST_CASE("Band-limited oscillator reduces aliasing", "[morphsynth][osc]")
+{
+    SECTION("PolyBLEP saw is at least 10 dB cleaner than the naive saw")
+    {
+        const double naive = aliasToHarmonicDb (render (MorphOsc::Saw, false));
+        const double bl    = aliasToHarmonicDb (render (MorphOsc::Saw, true));
+        REQUIRE(bl < naive - 10.0);
+    }
+
+    SECTION("PolyBLEP pulse is at least 10 dB cleaner than the naive pulse")
+    {
+        const double naive = aliasToHarmonicDb (render (MorphOsc::Pulse, false));
+        const double bl    = aliasToHarmonicDb (render (MorphOsc::Pulse, true));
+        REQUIRE(bl < naive - 10.0);
+    }
+
+    SECTION("Mip-mapped triangle is effectively alias-free")
+    {
+        REQUIRE(aliasToHarmonicDb (render (MorphOsc::Triangle, true)) < -60.0);
+    }
+
+    SECTION("Table sine matches std::sin closely")
+    {
+        const auto table = render (MorphOsc::Sine, true);
+        const auto exact = render (MorphOsc::Sine, false);
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < table.size(); ++i)
+            maxError = juce::jmax (maxError, std::abs (table[i] - exact[i]));
+
+        REQUIRE(maxError < 1.0e-5f);
+    }
+}
+
+TEST_CASE("MorphOsc throughput benchmark", "[.][benchmark][morphsynth]")
+{
+    constexpr int oneSecond = (int) sampleRate;
+
+    BENCHMARK("Naive saw + std::sin, 1 s")
+    {
+        return render (MorphOsc::Saw, false, oneSecond).back() + render (MorphOsc::Sine, false, oneSecond).back();
+    };
+
+    BENCHMARK("PolyBLEP saw + table sine, 1 s")
+    {
+        return render (MorphOsc::Saw, true, oneSecond).back() + render (MorphOsc::Sine, true, oneSecond).back();
+    };
+
+    BENCHMARK("Naive triangle, 1 s")
+    {
+        return render (MorphOsc::Triangle, false, oneSecond).back();
+    };
+
+    BENCHMARK("Wavetable triangle, 1 s")
+    {
+        return render (MorphOsc::Triangle, true, oneSecond).back();
+    };
+}
+
+TEST_CASE("MorphSynthPlugin keeps naive oscillators for projects saved before the quality setting", "[morphsynth][osc]")
+{
+    TestEdit t;
+    registerMorphSynthCompat (t.engine);
+
+    // A saved Morph Synth: the PLUGIN node with its MORPH_SYNTH child
+    const auto restore = [&t] (juce::ValueTree morphState)
+    {
+        juce::ValueTree state (te::IDs::PLUGIN, { { te::IDs::type, MorphSynthPlugin::pluginType } });
+        t.edit->createNewItemID().writeID (state, nullptr);
+        state.appendChild (morphState, nullptr);
+
+        auto plugin = t.edit->getPluginCache().getOrCreatePluginFor (state);
+        auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin.get());
+        REQUIRE(morph != nullptr);
+
+        morph->restoreFromValueTree (morph->state);
+        return plugin;
+    };
+
+    const auto qualityOf = [] (const te::Plugin::Ptr& plugin)
+    {
+        return dynamic_cast<MorphSynthPlugin&> (*plugin).oscQuality->getCurrentValue();
+    };
+
+    SECTION("new plugins are band-limited")
+    {
+        auto plugin = t.edit->getPluginCache().createNewPlugin (MorphSynthPlugin::pluginType, {});
+        REQUIRE(plugin != nullptr);
+        REQUIRE(qualityOf (plugin) == 0.0f);
+    }
+
+    SECTION("a saved synth without the setting restores as naive")
+    {
+        auto plugin = restore (juce::ValueTree ("MORPH_SYNTH", { { "cutoff", 800.0 } }));
+        REQUIRE(qualityOf (plugin) == 1.0f);
+        REQUIRE(dynamic_cast<MorphSynthPlugin&> (*plugin).cutoff->getCurrentValue() == 800.0f);
+    }
+
+    SECTION("a saved setting is kept")
+    {
+        auto plugin = restore (juce::ValueTree ("MORPH_SYNTH", { { "cutoff", 800.0 }, { "oscQuality", 0 } }));
+        REQUIRE(qualityOf (plugin) == 0.0f);
+    }
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "MorphTestPatch.h"
+
+namespace
+{
+    using namespace MorphTest;
+
+    /** Renders note-on/off pairs (absolute sample positions) block by block,
+        feeding each block the same way MorphSynthPlugin::applyToBuffer does. */
+    juce::AudioBuffer<float> renderPattern (const juce::Array<int>& onsets, int noteLength,
+                                            int totalSamples, bool sampleAccurate)
+    {
+        const auto params = makeTestParams();
+        juce::Synthesiser synth;
+        synth.setMinimumRenderingSubdivisions (1);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            auto* v = new MorphVoice();
+            v->prepare (sampleRate, blockSize, &params);
+            synth.addVoice (v);
+        }
+
+        synth.addSound (new TestSound());
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+
+        juce::AudioBuffer<float> out (1, totalSamples);
+        out.clear();
+
+        juce::MidiBuffer midi;
+
+        for (int blockStart = 0; blockStart < totalSamples; blockStart += blockSize)
+        {
+            const int num = juce::jmin (blockSize, totalSamples - blockStart);
+
+            // Block-relative timestamps in seconds, as Tracktion delivers them
+            juce::Array<juce::MidiMessage> events;
+            for (auto onset : onsets)
+            {
+                if (onset >= blockStart && onset < blockStart + num)
+                    events.add (juce::MidiMessage::noteOn (1, 60, 0.8f).withTimeStamp ((onset - blockStart) / sampleRate));
+
+                const int off = onset + noteLength;
+                if (off >= blockStart && off < blockStart + num)
+                    events.add (juce::MidiMessage::noteOff (1, 60).withTimeStamp ((off - blockStart) / sampleRate));
+            }
+
+            midi.clear();
+            MorphSynthPlugin::addMessagesToBuffer (midi, events, sampleRate, blockStart, num, sampleAccurate);
+            synth.renderNextBlock (out, midi, blockStart, num);
+        }
+
+        return out;
+    }
+
+    juce::Array<int> findOnsets (const juce::AudioBuffer<float>& buffer)
+    {
+        juce::Array<int> result;
+        const auto* data = buffer.getReadPointer (0);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            if (data[i] != 0.0f && (i == 0 || data[i - 1] == 0.0f))
+                result.add (i);
+
+        return result;
+    }
+}
+
+TEST_CASE("MIDI timestamp to sample offset", "[morphsynth][midi]")
+{
+    SECTION("Timestamps map to the nearest sample")
+    {
+        REQUIRE(MorphSynthPlugin::timeStampToSampleOffset(0.0, 48000.0, 512) == 0);
+        REQUIRE(MorphSynthPlugin::timeStampToSampleOffset(100.0 / 48000.0, 48000.0, 512) == 100);
+        REQUIRE(MorphSynthPlugin::timeStampToSampleOffset(99.9999 / 48000.0, 48000.0, 512) == 100);
+    }
+
+    SECTION("Offsets are clamped to the block")
+    {
+        REQUIRE(MorphSynthPlugin::timeStampToSampleOffset(-0.001, 48000.0, 512) == 0);
+        REQUIRE(MorphSynthPlugin::timeStampToSampleOffset(1.0, 48000.0, 512) == 511);
+        REQUIRE(MorphSynthPlugin::timeStampToSampleOffset(0.5, 48000.0, 0) == 0);
+    }
+}
+
+TEST_CASE("Quantised pattern renders with sample-accurate onsets", "[morphsynth][midi]")
+{
+    // 16th notes at 120 BPM / 48 kHz = 6000 samples apart; none land on a block boundary.
+    const juce::Array<int> onsets { 6000, 12000, 18000, 24000 };
+    const int noteLength   = 2400;
+    const int totalSamples = 30000;
+
+    SECTION("Sample-accurate mode places each onset on its exact sample")
+    {
+        auto out = renderPattern (onsets, noteLength, totalSamples, true);
+        REQUIRE(findOnsets(out) == onsets);
+    }
+
+    SECTION("Legacy mode snaps onsets to the start of their block")
+    {
+        auto out = renderPattern (onsets, noteLength, totalSamples, false);
+        auto found = findOnsets (out);
+
+        REQUIRE(found.size() == onsets.size());
+        for (int i = 0; i < found.size(); ++i)
+            REQUIRE(found[i] == (onsets[i] / blockSize) * blockSize);
+    }
+}
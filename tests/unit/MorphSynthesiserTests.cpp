@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include "UI/Plugins/Synthesizer/MorphSynthesiser.h"
+#include "MorphTestPatch.h"
+#include <set>
+
+namespace
+{
+    using namespace MorphTest;
+
+    // Long release so released voices keep sounding.
+    MorphParamSnapshot makeSynthParams()
+    {
+        auto p = makeTestParams();
+        p.set (MorphParam::dA, 0.001f);
+        p.set (MorphParam::dF, 0.001f);
+        p.set (MorphParam::rA, 0.5f);
+        p.set (MorphParam::rF, 0.5f);
+        return p;
+    }
+
+    struct Fixture
+    {
+        explicit Fixture (int polyphony)
+        {
+            synth.addSound (new TestSound());
+            synth.prepare (sampleRate, blockSize, &params);
+            synth.setPolyphony (polyphony);
+        }
+
+        void render()
+        {
+            buffer.clear();
+            synth.renderNextBlock (buffer, midi, 0, blockSize);
+        }
+
+        std::set<int> sounding() const
+        {
+            std::set<int> notes;
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                if (auto* v = synth.getVoice (i); v->isVoiceActive())
+                    notes.insert (v->getCurrentlyPlayingNote());
+            return notes;
+        }
+
+        MorphParamSnapshot params = makeSynthParams();
+        MorphSynthesiser synth;
+        juce::AudioBuffer<float> buffer { 1, blockSize };
+        juce::MidiBuffer midi;
+    };
+}
+
+TEST_CASE("MorphSynthesiser polyphony limit", "[morphsynth][voices]")
+{
+    SECTION("Voice pool is allocated once, at full size")
+    {
+        Fixture f (8);
+        REQUIRE(f.synth.getNumVoices() == MorphSynthesiser::maxVoices);
+    }
+
+    SECTION("Polyphony is clamped to the pool size")
+    {
+        Fixture f (8);
+        f.synth.setPolyphony (0);
+        REQUIRE(f.synth.getPolyphony() == 1);
+        f.synth.setPolyphony (1000);
+        REQUIRE(f.synth.getPolyphony() == MorphSynthesiser::maxVoices);
+    }
+
+    SECTION("No more than getPolyphony() voices sound at once")
+    {
+        Fixture f (4);
+        for (int note = 60; note < 72; ++note)
+        {
+            f.synth.noteOn (1, note, 0.8f);
+            f.render();
+            REQUIRE(f.synth.getNumActiveVoices() <= 4);
+        }
+        REQUIRE(f.synth.getNumActiveVoices() == 4);
+    }
+}
+
+TEST_CASE("MorphSynthesiser voice stealing order", "[morphsynth][voices]")
+{
+    SECTION("Oldest note is stolen when all voices are equally loud")
+    {
+        Fixture f (2);
+        f.synth.noteOn (1, 60, 0.8f); f.render();
+        f.synth.noteOn (1, 62, 0.8f); f.render();
+        f.synth.noteOn (1, 64, 0.8f); f.render();
+
+        REQUIRE(f.sounding() == std::set<int> { 62, 64 });
+    }
+
+    SECTION("Released notes are stolen before held ones")
+    {
+        Fixture f (2);
+        f.synth.noteOn (1, 60, 0.8f); f.render();
+        f.synth.noteOn (1, 62, 0.8f); f.render();
+        f.synth.noteOff (1, 62, 0.0f, true); f.render();
+        REQUIRE(f.sounding() == std::set<int> { 60, 62 }); // 62 still in its tail
+
+        f.synth.noteOn (1, 64, 0.8f); f.render();
+        REQUIRE(f.sounding() == std::set<int> { 60, 64 });
+    }
+
+    SECTION("Quieter held notes are stolen before louder, older ones")
+    {
+        Fixture f (2);
+        f.synth.noteOn (1, 60, 0.9f); f.render();
+        f.synth.noteOn (1, 62, 0.2f); f.render();
+        f.synth.noteOn (1, 64, 0.8f); f.render();
+
+        REQUIRE(f.sounding() == std::set<int> { 60, 64 });
+    }
+}
+
+TEST_CASE("MorphSynthesiser ends inaudible tails early", "[morphsynth][voices]")
+{
+    // Renders until the voice stops; returns the number of blocks rendered.
+    auto blocksUntilSilent = [] (Fixture& f, int maxBlocks)
+    {
+        int blocks = 0;
+        while (f.synth.getNumActiveVoices() > 0 && blocks < maxBlocks)
+        {
+            f.render();
+            ++blocks;
+        }
+        return blocks;
+    };
+
+    const int releaseBlocks = (int) (0.5 * sampleRate) / blockSize; // rA = 0.5 s
+    const int holdBlocks    = (MorphVoice::defaultSilenceHoldSamples + blockSize - 1) / blockSize;
+
+    SECTION("A released note below -90 dBFS stops after the hold time")
+    {
+        Fixture f (8);
+        f.synth.noteOn (1, 60, 1.0e-5f); f.render();   // ~ -100 dBFS
+        f.synth.noteOff (1, 60, 0.0f, true);
+
+        REQUIRE(blocksUntilSilent (f, 1000) <= holdBlocks + 1);
+        REQUIRE(f.synth.getNumVoicesEndedEarly() == 1);
+    }
+
+    SECTION("With detection disabled the same note plays its whole release")
+    {
+        Fixture f (8);
+        f.synth.setSilenceDetection (MorphVoice::defaultSilenceThresholdDb, 0);
+        f.synth.noteOn (1, 60, 1.0e-5f); f.render();
+        f.synth.noteOff (1, 60, 0.0f, true);
+
+        REQUIRE(blocksUntilSilent (f, 1000) >= releaseBlocks);
+        REQUIRE(f.synth.getNumVoicesEndedEarly() == 0);
+    }
+
+    SECTION("A held note that decayed to zero sustain is ended")
+    {
+        Fixture f (8);
+        f.params.set (MorphParam::sA, 0.0f);
+        f.synth.noteOn (1, 60, 0.8f);
+
+        REQUIRE(blocksUntilSilent (f, 1000) <= holdBlocks + 2);
+        REQUIRE(f.synth.getNumVoicesEndedEarly() == 1);
+    }
+
+    SECTION("Audible tails and held notes are left alone")
+    {
+        Fixture f (8);
+        f.synth.noteOn (1, 60, 1.0e-5f);   // quiet, but still held at full sustain
+        f.synth.noteOn (1, 64, 0.8f);
+        f.render();
+        f.synth.noteOff (1, 64, 0.0f, true);
+
+        for (int i = 0; i < releaseBlocks / 2; ++i)
+            f.render();
+
+        REQUIRE(f.sounding() == std::set<int> { 60, 64 });
+        REQUIRE(f.synth.getNumVoicesEndedEarly() == 0);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "UI/Plugins/Synthesizer/MorphSynthesiser.h"
+
+/**
+ * Shared set-up for the MorphSynth tests: the render settings, a sound that
+ * plays everything, and the patches the tests start from.
+ */
+namespace MorphTest
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize     = 512;
+
+    struct TestSound : juce::SynthesiserSound
+    {
+        bool appliesToNote (int) override    { return true; }
+        bool appliesToChannel (int) override { return true; }
+    };
+
+    /**
+     * Plain sine through an open filter with near-instant attack, decay and
+     * release at full sustain: a note sounds at its velocity within a block and
+     * is silent soon after its note-off. Tests change what they exercise on top.
+     */
+    inline MorphParamSnapshot makeTestParams()
+    {
+        MorphParamSnapshot p;
+        p.set (MorphParam::cutoff,     20000.0f);
+        p.set (MorphParam::resonance,  0.7f);
+        p.set (MorphParam::pulseWidth, 0.5f);
+        p.set (MorphParam::aA, 0.001f);
+        p.set (MorphParam::aF, 0.001f);
+        p.set (MorphParam::dA, 0.01f);
+        p.set (MorphParam::dF, 0.01f);
+        p.set (MorphParam::sA, 1.0f);
+        p.set (MorphParam::rA, 0.001f);
+        p.set (MorphParam::rF, 0.001f);
+        p.set (MorphParam::lfoRate,    5.0f);
+        return p;
+    }
+
+    /** MorphSynthPlugin's default patch, with Osc B mixed in so the filter has harmonics to work on. */
+    inline MorphParamSnapshot makeDefaultPatch()
+    {
+        MorphParamSnapshot p;
+        p.set (MorphParam::oscAType, 0); // Sine
+        p.set (MorphParam::oscBType, 2); // Saw
+        p.set (MorphParam::morph, 0.5f);
+        p.set (MorphParam::pulseWidth, 0.5f);
+        p.set (MorphParam::cutoff, 1200.0f);
+        p.set (MorphParam::resonance, 0.7f);
+        p.set (MorphParam::aA, 0.01f); p.set (MorphParam::dA, 0.12f); p.set (MorphParam::sA, 0.8f); p.set (MorphParam::rA, 0.2f);
+        p.set (MorphParam::aF, 0.01f); p.set (MorphParam::dF, 0.2f);  p.set (MorphParam::sF, 0.0f); p.set (MorphParam::rF, 0.25f);
+        p.set (MorphParam::fEnvAmt, 0.5f);
+        p.set (MorphParam::lfoRate, 5.0f);
+        return p;
+    }
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "MorphTestPatch.h"
+
+namespace
+{
+    using namespace MorphTest;
+
+    /** Plays @p notes for one second and releases them, rendering block by block. */
+    juce::AudioBuffer<float> renderChord (const juce::Array<int>& notes, bool useBlocks, int numVoices = 8)
+    {
+        const auto params = makeDefaultPatch();
+        juce::Synthesiser synth;
+
+        for (int i = 0; i < numVoices; ++i)
+        {
+            auto* v = new MorphVoice();
+            v->prepare (sampleRate, blockSize, &params);
+            v->setUseBlockRendering (useBlocks);
+            synth.addVoice (v);
+        }
+
+        synth.addSound (new TestSound());
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+
+        const int totalSamples = (int) (sampleRate * 1.5);
+        const int releaseAt    = (int) sampleRate;
+
+        juce::AudioBuffer<float> out (2, totalSamples);
+        out.clear();
+
+        juce::MidiBuffer midi;
+
+        for (int blockStart = 0; blockStart < totalSamples; blockStart += blockSize)
+        {
+            const int num = juce::jmin (blockSize, totalSamples - blockStart);
+            midi.clear();
+
+            for (auto note : notes)
+            {
+                if (blockStart == 0)
+                    midi.addEvent (juce::MidiMessage::noteOn (1, note, 0.8f), 0);
+                if (releaseAt >= blockStart && releaseAt < blockStart + num)
+                    midi.addEvent (juce::MidiMessage::noteOff (1, note), releaseAt);
+            }
+
+            synth.renderNextBlock (out, midi, blockStart, num);
+        }
+
+        return out;
+    }
+}
+
+TEST_CASE("Block renderer matches the per-sample renderer", "[morphsynth][voice]")
+{
+    const juce::Array<int> notes { 48, 55, 60, 64 };
+
+    const auto reference = renderChord (notes, false);
+    const auto blocked   = renderChord (notes, true);
+
+    REQUIRE(reference.getNumSamples() == blocked.getNumSamples());
+
+    double signalEnergy = 0.0, errorEnergy = 0.0;
+    float maxError = 0.0f;
+
+    const auto* ref = reference.getReadPointer (0);
+    const auto* blk = blocked.getReadPointer (0);
+
+    for (int i = 0; i < reference.getNumSamples(); ++i)
+    {
+        const float diff = blk[i] - ref[i];
+        signalEnergy += (double) ref[i] * ref[i];
+        errorEnergy  += (double) diff * diff;
+        maxError = juce::jmax (maxError, std::abs (diff));
+    }
+
+    REQUIRE(signalEnergy > 0.0);
+
+    // Stated tolerance: error at least 40 dB below the signal (RMS), and no
+    // single sample off by more than 0.02 full scale.
+    const double errorDb = 10.0 * std::log10 (errorEnergy / signalEnergy + 1.0e-30);
+    REQUIRE(errorDb < -40.0);
+    REQUIRE(maxError < 0.02f);
+}
+
+TEST_CASE("ParamsView shim fills the snapshot by ID", "[morphsynth][voice]")
+{
+    struct View : MorphVoice::ParamsView
+    {
+        float get (const juce::String& id) const override { return id == "cutoff" ? 440.0f : 0.25f; }
+        int choice (const juce::String& id) const override { return id == "filterType" ? 2 : 1; }
+    };
+
+    MorphParamSnapshot snap;
+    View().fillSnapshot (snap);
+
+    REQUIRE(snap.get (MorphParam::cutoff) == 440.0f);
+    REQUIRE(snap.get (MorphParam::morph) == 0.25f);
+    REQUIRE(snap.choice (MorphParam::filterType) == 2);
+    REQUIRE(snap.choice (MorphParam::oscAType) == 1);
+}
+
+TEST_CASE("MorphVoice render benchmark", "[.][benchmark][morphsynth]")
+{
+    const juce::Array<int> chord { 48, 52, 55, 59, 60, 64, 67, 71 };
+
+    BENCHMARK("Per-sample renderer, 8 voices, 1.5 s")
+    {
+        return renderChord (chord, false).getMagnitude (0, 0, 512);
+    };
+
+    BENCHMARK("Sub-block renderer, 8 voices, 1.5 s")
+    {
+        return renderChord (chord, true).getMagnitude (0, 0, 512);
+    };
+}
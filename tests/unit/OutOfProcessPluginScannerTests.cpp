@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include "PluginManager/OutOfProcessPluginScanner.h"
+#include "FakePluginFormat.h"
+#include <map>
+
+namespace
+{
+    using Outcome = OutOfProcessPluginScanner::Result::Outcome;
+
+    struct StubPlugins
+    {
+        juce::TemporaryFile dirTmp;
+        juce::File dir = dirTmp.getFile();
+
+        StubPlugins() { dir.createDirectory(); }
+        ~StubPlugins() { dir.deleteRecursively(); }
+
+        juce::String add (const juce::String& name)
+        {
+            auto f = dir.getChildFile (name + ".fakeplug");
+            f.replaceWithText ("stub");
+            return f.getFullPathName();
+        }
+    };
+
+    OutOfProcessPluginScanner::Options stubOptions()
+    {
+        OutOfProcessPluginScanner::Options options;
+        options.workerCommand = { PLUGIN_SCAN_STUB_WORKER };
+        options.numWorkers = 2;
+        options.timeoutMs = 1500;
+        return options;
+    }
+}
+
+TEST_CASE("PluginScanWorker protocol round-trips results", "[plugins][scan]")
+{
+    StubPlugins stubs;
+    const juce::StringArray files { stubs.add ("Synth"), stubs.add ("Empty") };
+
+    FakePluginFormat format;
+    juce::StringArray lines;
+    PluginScanWorker::scanFiles (format, files, [&] (const juce::String& l) { lines.add (l); });
+
+    REQUIRE(lines.size() == 4);
+
+    PluginScanWorker::Message message;
+
+    // A plugin's own stdout chatter in front of a line doesn't hide it
+    REQUIRE(PluginScanWorker::parseLine ("some plugin log" + lines[0], message));
+    REQUIRE(message.type == PluginScanWorker::Message::Type::begin);
+    REQUIRE(message.fileOrIdentifier == files[0]);
+
+    REQUIRE(PluginScanWorker::parseLine (lines[1], message));
+    REQUIRE(message.type == PluginScanWorker::Message::Type::result);
+    REQUIRE(message.types.size() == 1);
+    REQUIRE(message.types.getReference (0).name == "Synth");
+
+    REQUIRE(PluginScanWorker::parseLine (lines[3], message));
+    REQUIRE(message.types.isEmpty());
+
+    REQUIRE_FALSE(PluginScanWorker::parseLine ("unrelated output", message));
+}
+
+TEST_CASE("OutOfProcessPluginScanner survives hanging and crashing plugins", "[plugins][scan]")
+{
+    StubPlugins stubs;
+    const juce::StringArray files { stubs.add ("A"), stubs.add ("HangForever"), stubs.add ("B"),
+                                    stubs.add ("CrashOnLoad"), stubs.add ("C"), stubs.add ("Empty") };
+
+    std::map<juce::String, OutOfProcessPluginScanner::Result> results;
+    int numReports = 0;
+
+    OutOfProcessPluginScanner scanner (stubOptions());
+    const bool ok = scanner.scan ("Fake", files, [&] (const OutOfProcessPluginScanner::Result& r)
+    {
+        results[r.fileOrIdentifier] = r;
+        ++numReports;
+    });
+
+    REQUIRE(ok);
+    REQUIRE(numReports == files.size());   // every file exactly once
+
+    for (auto name : { "A", "B", "C" })
+    {
+        const auto& r = results[stubs.dir.getChildFile (juce::String (name) + ".fakeplug").getFullPathName()];
+        REQUIRE(r.outcome == Outcome::ok);
+        REQUIRE(r.types.size() == 1);
+    }
+
+    const auto& hung = results[files[1]];
+    REQUIRE(hung.outcome == Outcome::timedOut);
+    REQUIRE(hung.shouldBlacklist());
+
+    const auto& crashed = results[files[3]];
+    REQUIRE(crashed.outcome == Outcome::crashed);
+    REQUIRE(crashed.shouldBlacklist());
+
+    const auto& empty = results[files[5]];
+    REQUIRE(empty.outcome == Outcome::failed);
+    REQUIRE_FALSE(empty.shouldBlacklist());
+}
+
+TEST_CASE("OutOfProcessPluginScanner reports a missing worker", "[plugins][scan]")
+{
+    StubPlugins stubs;
+
+    auto options = stubOptions();
+    options.workerCommand = { stubs.dir.getChildFile ("no-such-worker").getFullPathName() };
+
+    int numReports = 0;
+    OutOfProcessPluginScanner scanner (options);
+
+    REQUIRE_FALSE(scanner.scan ("Fake", { stubs.add ("A") }, [&] (const auto&) { ++numReports; }));
+    REQUIRE(numReports == 0);
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include "PluginManager/PluginScanCache.h"
+#include "FakePluginFormat.h"
+
+namespace
+{
+    struct Fixture
+    {
+        juce::TemporaryFile dirTmp;
+        juce::File dir = dirTmp.getFile();
+        juce::File cacheFile = dir.getSiblingFile (dir.getFileName() + "_cache.xml");
+
+        Fixture()
+        {
+            dir.createDirectory();
+
+            for (int i = 0; i < 4; ++i)
+                dir.getChildFile ("Plug" + juce::String (i) + ".fakeplug").replaceWithText ("v1");
+        }
+
+        ~Fixture()
+        {
+            dir.deleteRecursively();
+            cacheFile.deleteFile();
+        }
+
+        juce::FileSearchPath searchPath() const { return juce::FileSearchPath (dir.getFullPathName()); }
+    };
+}
+
+TEST_CASE("PluginScanCache only scans new or changed plugins", "[plugins][scan]")
+{
+    Fixture fx;
+    FakePluginFormat format;
+    PluginScanCache cache (fx.cacheFile);
+
+    auto first = cache.scan (format, fx.searchPath(), {}, {});
+    REQUIRE(first.scanned == 4);
+    REQUIRE(format.numInstantiations == 4);
+    REQUIRE(cache.getAllTypes().size() == 4);
+
+    SECTION("an unchanged tree is answered entirely from the cache")
+    {
+        auto second = cache.scan (format, fx.searchPath(), {}, {});
+        REQUIRE(second.scanned == 0);
+        REQUIRE(second.skipped == 4);
+        REQUIRE(format.numInstantiations == 4);
+    }
+
+    SECTION("a modified plugin is rescanned")
+    {
+        auto changed = fx.dir.getChildFile ("Plug2.fakeplug");
+        changed.setLastModificationTime (changed.getLastModificationTime() + juce::RelativeTime::seconds (10));
+
+        juce::StringArray reported;
+        auto second = cache.scan (format, fx.searchPath(), {}, {}, {},
+                                  [&] (const PluginScanCache::Entry& e) { reported.add (e.fileOrIdentifier); });
+
+        REQUIRE(second.scanned == 1);
+        REQUIRE(second.skipped == 3);
+        REQUIRE(reported == juce::StringArray (changed.getFullPathName()));
+    }
+
+    SECTION("new and removed plugins are picked up")
+    {
+        fx.dir.getChildFile ("Plug0.fakeplug").deleteFile();
+        fx.dir.getChildFile ("New.fakeplug").replaceWithText ("v1");
+
+        auto second = cache.scan (format, fx.searchPath(), {}, {});
+        REQUIRE(second.scanned == 1);
+        REQUIRE(second.removed == 1);
+        REQUIRE(second.removedFiles == juce::StringArray (fx.dir.getChildFile ("Plug0.fakeplug").getFullPathName()));
+        REQUIRE(cache.getNumEntries() == 4);
+    }
+
+    SECTION("skipped files are never instantiated")
+    {
+        fx.dir.getChildFile ("Bad.fakeplug").replaceWithText ("v1");
+
+        auto second = cache.scan (format, fx.searchPath(),
+                                  juce::StringArray (fx.dir.getChildFile ("Bad.fakeplug").getFullPathName()), {});
+        REQUIRE(second.scanned == 0);
+        REQUIRE(format.numInstantiations == 4);
+    }
+}
+
+TEST_CASE("PluginScanCache persists across sessions", "[plugins][scan]")
+{
+    Fixture fx;
+
+    {
+        FakePluginFormat format;
+        PluginScanCache cache (fx.cacheFile);
+        cache.scan (format, fx.searchPath(), {}, {});
+        REQUIRE(cache.save());
+    }
+
+    FakePluginFormat format;
+    PluginScanCache reloaded (fx.cacheFile);
+    REQUIRE(reloaded.load());
+    REQUIRE(reloaded.getNumEntries() == 4);
+    REQUIRE(reloaded.getAllTypes().size() == 4);
+
+    auto stats = reloaded.scan (format, fx.searchPath(), {}, {});
+    REQUIRE(stats.skipped == 4);
+    REQUIRE(format.numInstantiations == 0);
+}
+
+TEST_CASE("PluginScanCache rejects a missing or foreign file", "[plugins][scan]")
+{
+    juce::TemporaryFile tmp (".xml");
+    PluginScanCache cache (tmp.getFile());
+
+    REQUIRE_FALSE(cache.load());
+
+    tmp.getFile().replaceWithText ("<SOMETHINGELSE/>");
+    REQUIRE_FALSE(cache.load());
+    REQUIRE(cache.getNumEntries() == 0);
+}
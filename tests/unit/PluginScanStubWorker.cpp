@@ -0,0 +1,17 @@
+// Stand-in for GrooveKit's --plugin-scan-worker mode, scanning FakePluginFormat
+// stub plugins so the scanner tests can make workers hang and crash.
+
+#include "PluginManager/PluginScanWorker.h"
+#include "FakePluginFormat.h"
+
+int main (int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add (juce::CharPointer_UTF8 (argv[i]));
+
+    juce::AudioPluginFormatManager formats;
+    formats.addFormat (new FakePluginFormat());
+
+    return PluginScanWorker::runFromCommandLine (args, formats);
+}
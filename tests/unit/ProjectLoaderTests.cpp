@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/ProjectLoader.h"
+#include "AppEngine/ProjectSaver.h"
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "TestProject.h"
+#include <algorithm>
+
+namespace
+{
+    // Project with a Morph Synth after the volume plugin on each track, each with distinct saved values
+    juce::ValueTree makeProject (int numTracks)
+    {
+        auto edit = makeTestProject (numTracks, 16);
+
+        for (int t = 0; t < numTracks; ++t)
+        {
+            juce::ValueTree plugin (te::IDs::PLUGIN, { { te::IDs::type, MorphSynthPlugin::pluginType }, { te::IDs::id, 1000 + t } });
+            plugin.appendChild (juce::ValueTree ("MORPH_SYNTH", { { "cutoff", 500.0 + t }, { "gain", -6.0 } }), nullptr);
+
+            auto track = edit.getChild (t);
+            track.appendChild (juce::ValueTree (te::IDs::PLUGIN, { { te::IDs::type, "volume" }, { te::IDs::id, 5000 + t } }), nullptr);
+            track.appendChild (plugin, nullptr);
+        }
+
+        return edit;
+    }
+
+    float cutoffOf (const juce::ValueTree& state, int track)
+    {
+        return (float) state.getChild (track).getChildWithProperty (te::IDs::type, MorphSynthPlugin::pluginType)
+                                             .getChildWithName ("MORPH_SYNTH")["cutoff"];
+    }
+}
+
+TEST_CASE("ProjectLoader reads projects off the message thread", "[project][load]")
+{
+    juce::TemporaryFile tmp (ProjectSaver::binaryExtension);
+    REQUIRE(ProjectSaver::writeSnapshot (makeProject (12), tmp.getFile()));
+
+    SECTION("Binary projects are read back whole")
+    {
+        const auto result = ProjectLoader::load (tmp.getFile());
+
+        REQUIRE(result->state.isValid());
+        REQUIRE(result->state.isEquivalentTo (makeProject (12)));
+        REQUIRE(cutoffOf (result->state, 3) == 503.0f);
+    }
+
+    SECTION("XML projects load through the same path")
+    {
+        juce::TemporaryFile xml (".tracktionedit");
+        REQUIRE(ProjectSaver::writeSnapshot (makeProject (3), xml.getFile()));
+
+        const auto result = ProjectLoader::load (xml.getFile());
+        REQUIRE(result->state.getNumChildren() == 3);
+        REQUIRE(cutoffOf (result->state, 2) == 502.0f);
+    }
+
+    SECTION("Progress is reported in order and ends at 1")
+    {
+        std::vector<double> progress;
+        ProjectLoader::load (tmp.getFile(), [&] (double p, const juce::String&) { progress.push_back (p); });
+
+        REQUIRE_FALSE(progress.empty());
+        REQUIRE(std::is_sorted (progress.begin(), progress.end()));
+        REQUIRE(progress.back() == 1.0);
+    }
+
+    SECTION("Missing files and stopped loads produce no state")
+    {
+        REQUIRE_FALSE(ProjectLoader::load (tmp.getFile().getSiblingFile ("missing.gkproj"))->state.isValid());
+        REQUIRE_FALSE(ProjectLoader::load (tmp.getFile(), {}, [] { return true; })->state.isValid());
+    }
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "AppEngine/ProjectSaver.h"
+#include "TestEdit.h"
+#include "TestProject.h"
+
+namespace
+{
+    /** A real edit's state: one MIDI clip of 16th notes per track, added through Tracktion. */
+    juce::ValueTree makeEditState (TestEdit& t, int notesPerTrack)
+    {
+        for (auto* track : te::getAudioTracks (*t.edit))
+        {
+            const tracktion::TimeRange range { tracktion::TimePosition(), tracktion::TimePosition::fromSeconds (notesPerTrack * 0.125) };
+            auto clip = track->insertMIDIClip (range, nullptr);
+
+            for (int n = 0; n < notesPerTrack; ++n)
+                clip->getSequence().addNote (36 + n % 48, tracktion::BeatPosition::fromBeats (n * 0.25),
+                                             tracktion::BeatDuration::fromBeats (0.25), 100, 0, nullptr);
+        }
+
+        t.edit->flushState();
+        return t.edit->state.createCopy();
+    }
+
+    juce::ValueTree readProject (const juce::File& f)
+    {
+        if (auto xml = juce::parseXML (f))
+            return juce::ValueTree::fromXml (*xml);
+        return {};
+    }
+
+    // Typed properties as TE writes them: XML stores everything as strings,
+    // so equivalence is checked after the XML leg turns values into text
+    juce::ValueTree viaXml (const juce::ValueTree& tree)
+    {
+        return juce::ValueTree::fromXml (*tree.createXml());
+    }
+}
+
+TEST_CASE("ProjectSaver writes snapshots", "[project][save]")
+{
+    juce::TemporaryFile tmp (".tracktionedit");
+    const auto file = tmp.getFile();
+
+    SECTION("writeSnapshot round-trips the tree")
+    {
+        const auto project = makeTestProject (4);
+        REQUIRE(ProjectSaver::writeSnapshot (project, file));
+        REQUIRE(readProject (file).isEquivalentTo (project));
+    }
+
+    SECTION("An invalid tree leaves the existing file untouched")
+    {
+        REQUIRE(file.replaceWithText ("previous"));
+        REQUIRE_FALSE(ProjectSaver::writeSnapshot ({}, file));
+        REQUIRE(file.loadFileAsString() == "previous");
+    }
+
+    SECTION("saveAsync writes a snapshot taken before later edits")
+    {
+        ProjectSaver saver;
+        auto project = makeTestProject (8);
+        const auto expected = project.createCopy();
+
+        saver.saveAsync (project.createCopy(), file);
+        project.removeAllChildren (nullptr);   // the live tree moves on; the save must not see it
+
+        REQUIRE(saver.waitForPendingSaves (5000));
+        REQUIRE_FALSE(saver.isSaving());
+        REQUIRE(readProject (file).isEquivalentTo (expected));
+    }
+
+    SECTION("Queued saves complete in order")
+    {
+        ProjectSaver saver;
+        for (int i = 1; i <= 5; ++i)
+            saver.saveAsync (makeTestProject (i), file);
+
+        REQUIRE(saver.waitForPendingSaves (5000));
+        REQUIRE(readProject (file).getNumChildren() == 5);
+    }
+}
+
+TEST_CASE("Binary project format", "[project][format]")
+{
+    const auto project = makeTestProject (8);
+
+    SECTION("Extension selects the format")
+    {
+        REQUIRE(ProjectSaver::getFormatForFile (juce::File ("/tmp/a.gkproj")) == ProjectSaver::Format::binary);
+        REQUIRE(ProjectSaver::getFormatForFile (juce::File ("/tmp/a.tracktionedit")) == ProjectSaver::Format::xml);
+    }
+
+    SECTION("In-memory round trip preserves the tree")
+    {
+        const auto data = ProjectSaver::createBinaryProject (project);
+        REQUIRE(ProjectSaver::parseBinaryProject (data.getData(), data.getSize()).isEquivalentTo (project));
+    }
+
+    SECTION("XML -> binary -> XML round trip through files")
+    {
+        juce::TemporaryFile xmlFile (".tracktionedit");
+        juce::TemporaryFile binFile (ProjectSaver::binaryExtension);
+        juce::TemporaryFile xmlAgain (".tracktionedit");
+
+        REQUIRE(ProjectSaver::writeSnapshot (project, xmlFile.getFile()));
+        const auto fromXml = ProjectSaver::readProject (xmlFile.getFile());
+
+        REQUIRE(ProjectSaver::writeSnapshot (fromXml, binFile.getFile()));
+        REQUIRE(ProjectSaver::isBinaryProject (binFile.getFile()));
+        REQUIRE_FALSE(ProjectSaver::isBinaryProject (xmlFile.getFile()));
+
+        const auto fromBinary = ProjectSaver::readProject (binFile.getFile());
+        REQUIRE(fromBinary.isEquivalentTo (fromXml));
+
+        REQUIRE(ProjectSaver::writeSnapshot (fromBinary, xmlAgain.getFile()));
+        REQUIRE(xmlAgain.getFile().loadFileAsString() == xmlFile.getFile().loadFileAsString());
+        REQUIRE(viaXml (fromBinary).isEquivalentTo (viaXml (project)));
+
+        REQUIRE(binFile.getFile().getSize() < xmlFile.getFile().getSize());
+    }
+
+    SECTION("Corrupt, truncated and newer-version files are rejected")
+    {
+        auto data = ProjectSaver::createBinaryProject (project);
+
+        REQUIRE_FALSE(ProjectSaver::parseBinaryProject (data.getData(), data.getSize() / 2).isValid());
+        REQUIRE_FALSE(ProjectSaver::parseBinaryProject (data.getData(), 6).isValid());
+
+        static_cast<char*> (data.getData())[4] = (char) (ProjectSaver::binaryFormatVersion + 1);
+        REQUIRE_FALSE(ProjectSaver::parseBinaryProject (data.getData(), data.getSize()).isValid());
+    }
+}
+
+TEST_CASE("Project load benchmark", "[.][benchmark][project]")
+{
+    // 20k notes across 16 tracks
+    TestEdit t (16);
+    const auto project = makeEditState (t, 1250);
+
+    juce::TemporaryFile xmlFile (".tracktionedit");
+    juce::TemporaryFile binFile (ProjectSaver::binaryExtension);
+    REQUIRE(ProjectSaver::writeSnapshot (project, xmlFile.getFile()));
+    REQUIRE(ProjectSaver::writeSnapshot (project, binFile.getFile()));
+
+    // What opening a project costs end to end, Edit included
+    BENCHMARK("Open XML project with Tracktion's loader")
+    {
+        return te::loadEditFromFile (t.engine, xmlFile.getFile()) != nullptr;
+    };
+
+    BENCHMARK("Open binary project")
+    {
+        return te::loadEditFromState (t.engine, ProjectSaver::readProject (binFile.getFile()), te::Edit::forEditing) != nullptr;
+    };
+
+    // The part ProjectSaver changes: reading the file into a tree
+    BENCHMARK("Read XML project")
+    {
+        return ProjectSaver::readProject (xmlFile.getFile());
+    };
+
+    BENCHMARK("Read binary project")
+    {
+        return ProjectSaver::readProject (binFile.getFile());
+    };
+
+    BENCHMARK("Save XML project")
+    {
+        return ProjectSaver::writeSnapshot (project, xmlFile.getFile());
+    };
+
+    BENCHMARK("Save binary project")
+    {
+        return ProjectSaver::writeSnapshot (project, binFile.getFile());
+    };
+}
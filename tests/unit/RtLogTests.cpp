@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AudioEngine/RtLog.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Fixture
+    {
+        Fixture()
+        {
+            dir.deleteRecursively();
+            rtLog.setLogFile (log);
+        }
+
+        ~Fixture()
+        {
+            rtLog.setLogFile ({});
+            dir.deleteRecursively();
+        }
+
+        juce::File dir = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                             .getChildFile ("GrooveKitRtLogTest_" + juce::String::toHexString (juce::Random::getSystemRandom().nextInt()));
+        juce::File log = dir.getChildFile ("realtime.log");
+        RtLog rtLog;
+    };
+
+    RtLog::Record makeRecord (RtLog::Event event, int channel, int a, int b, double value)
+    {
+        RtLog::Record r;
+        r.event = event;
+        r.channel = (juce::uint8) channel;
+        r.a = a;
+        r.b = b;
+        r.value = value;
+        return r;
+    }
+}
+
+TEST_CASE("RtLog formats records like the old log lines", "[audio][rtlog]")
+{
+    using Event = RtLog::Event;
+
+    REQUIRE(RtLog::formatRecord (makeRecord (Event::midiNoteOn, 1, 60, 100, 1.5))
+            == "[MIDI EVENT] NOTE ON:  Note=60 Velocity=100 | Time=1.500s | Channel=1");
+    REQUIRE(RtLog::formatRecord (makeRecord (Event::midiController, 2, 7, 64, 0.0))
+            == "[MIDI EVENT] CC:       Controller=7 Value=64 | Time=0.000s | Channel=2");
+    REQUIRE(RtLog::formatRecord (makeRecord (Event::midiOther, 0, 0xf8, 1, 0.0))
+            == "[MIDI EVENT] F8 | Time=0.000s | Channel=0");
+    REQUIRE(RtLog::formatRecord (makeRecord (Event::midiOther, 0, 0xf0 | (0x7e << 8) | (0x7f << 16), 6, 0.0))
+            == "[MIDI EVENT] F0 7E 7F ... (6 bytes) | Time=0.000s | Channel=0");
+    REQUIRE(RtLog::formatRecord (makeRecord (Event::recorderNoteOff, 3, 64, 0, 0.5))
+            == "[MidiRecorder] NOTE OFF: Note=64 Velocity=0.50 Channel=3");
+    REQUIRE(RtLog::formatRecord (makeRecord (Event::recorderLoopNewTake, 0, 2, 0, 0.0))
+            == "[MidiRecorder] Loop wraparound detected - starting take 2");
+}
+
+TEST_CASE("RtLog filters by level", "[audio][rtlog]")
+{
+    Fixture f;
+
+    REQUIRE(f.rtLog.getLevel() == RtLog::Level::info);
+    REQUIRE_FALSE(f.rtLog.isEnabled (RtLog::Level::debug));
+    REQUIRE(f.rtLog.isEnabled (RtLog::Level::warning));
+
+    f.rtLog.setLevel (RtLog::Level::off);
+    REQUIRE_FALSE(f.rtLog.isEnabled (RtLog::Level::error));
+    REQUIRE_FALSE(f.rtLog.isEnabled (RtLog::Level::off));
+
+    f.rtLog.setLevel (RtLog::Level::warning);
+    f.rtLog.log (RtLog::Level::info, RtLog::Event::recorderLoopOverdub);
+    f.rtLog.log (RtLog::Level::warning, RtLog::Event::recorderOrphanNoteOff, 1, 61);
+    REQUIRE(f.rtLog.flush());
+
+    const auto text = f.log.loadFileAsString();
+    REQUIRE_FALSE(text.contains ("overdubbing"));
+    REQUIRE(text.contains ("WARNING"));
+    REQUIRE(text.contains ("Discarding orphaned NOTE OFF (no matching note-on): Note=61"));
+}
+
+TEST_CASE("RtLog writes records from several threads to the file", "[audio][rtlog]")
+{
+    Fixture f;
+    constexpr int numThreads = 4;
+    constexpr int perThread = 200;   // well under queueCapacity, so nothing is dropped
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < numThreads; ++t)
+        producers.emplace_back ([&f, t]
+        {
+            for (int i = 0; i < perThread; ++i)
+                f.rtLog.log (RtLog::Level::info, RtLog::Event::midiNoteOn, t + 1, i % 128, 100, 0.0);
+        });
+
+    for (auto& p : producers)
+        p.join();
+
+    REQUIRE(f.rtLog.flush());
+    REQUIRE(f.rtLog.getNumDropped() == 0);
+
+    juce::StringArray lines;
+    lines.addLines (f.log.loadFileAsString().trimEnd());
+    REQUIRE(lines.size() == numThreads * perThread);
+    REQUIRE(lines[0].contains ("INFO"));
+    REQUIRE(lines[0].contains ("[MIDI EVENT] NOTE ON:"));
+}
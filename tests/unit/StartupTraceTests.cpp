@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/StartupTrace.h"
+
+namespace
+{
+    const StartupTrace::Event* findEvent (const std::vector<StartupTrace::Event>& events, const juce::String& name)
+    {
+        for (const auto& e : events)
+            if (e.name == name)
+                return &e;
+        return nullptr;
+    }
+}
+
+TEST_CASE("StartupTrace records nested phases", "[startup][trace]")
+{
+    auto& trace = StartupTrace::getInstance();
+    trace.reset();
+
+    {
+        GK_TRACE_SCOPE ("outer");
+        juce::Thread::sleep (5);
+
+        {
+            GK_TRACE_SCOPE ("inner");
+            juce::Thread::sleep (5);
+        }
+    }
+
+    const auto events = trace.getEvents();
+    const auto* outer = findEvent (events, "outer");
+    const auto* inner = findEvent (events, "inner");
+
+    REQUIRE(outer != nullptr);
+    REQUIRE(inner != nullptr);
+    REQUIRE(inner->startMicros >= outer->startMicros);
+    REQUIRE(inner->startMicros + inner->durationMicros <= outer->startMicros + outer->durationMicros);
+    REQUIRE(outer->durationMicros >= 10000);
+    REQUIRE(inner->threadIndex == outer->threadIndex);
+}
+
+TEST_CASE("StartupTrace writes Chrome trace-event JSON", "[startup][trace]")
+{
+    auto& trace = StartupTrace::getInstance();
+    trace.reset();
+
+    { GK_TRACE_SCOPE ("phase"); }
+
+    const auto start = trace.now();
+    trace.addAsyncPhase ("background", start, start + 1500);
+    trace.addMarker ("first frame");
+
+    const auto json = juce::JSON::parse (trace.toChromeTraceJson());
+    const auto* traceEvents = json["traceEvents"].getArray();
+    REQUIRE(traceEvents != nullptr);
+
+    int numComplete = 0, numAsync = 0, numMarkers = 0, numMetadata = 0;
+
+    for (const auto& e : *traceEvents)
+    {
+        const auto ph = e["ph"].toString();
+        REQUIRE(e.hasProperty ("name"));
+        REQUIRE(e.hasProperty ("pid"));
+        REQUIRE(e.hasProperty ("tid"));
+
+        if (ph == "X")      { ++numComplete; REQUIRE(e.hasProperty ("dur")); }
+        else if (ph == "b" || ph == "e") ++numAsync;
+        else if (ph == "i") ++numMarkers;
+        else if (ph == "M") ++numMetadata;
+    }
+
+    REQUIRE(numComplete == 1);
+    REQUIRE(numAsync == 2);
+    REQUIRE(numMarkers == 1);
+    REQUIRE(numMetadata >= 2);   // process + thread names
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "AppEngine/GrooveKitUIBehaviour.h"
+
+namespace te = tracktion::engine;
+
+/**
+ * An engine and an empty edit with a number of audio tracks, for tests that
+ * need real Tracktion objects. The edit file is never written.
+ */
+struct TestEdit
+{
+    explicit TestEdit (int numTracks = 1)
+    {
+        edit->ensureNumberOfAudioTracks (numTracks);
+    }
+
+    te::AudioTrack& track (int index) const { return *te::getAudioTracks (*edit)[index]; }
+
+    juce::ScopedJuceInitialiser_GUI gui;
+    te::Engine engine { "GrooveKitTests", std::make_unique<GrooveKitUIBehaviour>(), nullptr };
+    std::unique_ptr<te::Edit> edit = te::createEmptyEdit (engine, juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                                                      .getNonexistentChildFile ("GrooveKitTest", ".tracktionedit"));
+};
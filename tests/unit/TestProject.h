@@ -0,0 +1,49 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+namespace te = tracktion::engine;
+
+/** A 16th note as Tracktion saves it: p = pitch, b = start beat, l = length in beats, v = velocity. */
+inline juce::ValueTree makeTestNote (int pitch, double beat)
+{
+    return juce::ValueTree (te::IDs::NOTE, { { te::IDs::p, pitch }, { te::IDs::b, beat },
+                                             { te::IDs::l, 0.25 }, { te::IDs::v, 100 } });
+}
+
+/**
+ * A project state with one MIDI clip of 16th notes per track, laid out as
+ * Tracktion saves it (EDIT > TRACK > MIDICLIP > SEQUENCE > NOTE), for tests
+ * that work on the tree without creating an Edit.
+ */
+inline juce::ValueTree makeTestProject (int numTracks, int notesPerTrack = 64)
+{
+    juce::ValueTree edit (te::IDs::EDIT);
+    edit.setProperty (te::IDs::appVersion, "GrooveKit", nullptr);
+
+    for (int t = 0; t < numTracks; ++t)
+    {
+        juce::ValueTree track (te::IDs::TRACK);
+        track.setProperty (te::IDs::name, "Track " + juce::String (t + 1), nullptr);
+
+        juce::ValueTree clip (te::IDs::MIDICLIP);
+        clip.setProperty (te::IDs::start, 0.0, nullptr);
+        clip.setProperty (te::IDs::length, notesPerTrack * 0.125, nullptr);   // 120 bpm
+
+        juce::ValueTree seq (te::IDs::SEQUENCE);
+        for (int n = 0; n < notesPerTrack; ++n)
+            seq.appendChild (makeTestNote (36 + n % 48, n * 0.25), nullptr);
+
+        clip.appendChild (seq, nullptr);
+        track.appendChild (clip, nullptr);
+        edit.appendChild (track, nullptr);
+    }
+
+    return edit;
+}
+
+/** The note list of @p track's first clip in a makeTestProject() tree. */
+inline juce::ValueTree getTestSequence (const juce::ValueTree& edit, int track)
+{
+    return edit.getChild (track).getChildWithName (te::IDs::MIDICLIP).getChildWithName (te::IDs::SEQUENCE);
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/TrackFreezer.h"
+#include "TestEdit.h"
+
+namespace
+{
+    const juce::Identifier bypassedByFreeze ("gk_bypassedByFreeze");
+
+    /** A second of MIDI played by a tone generator, plus a tone generator that's already switched off. */
+    void addFreezableContent (te::AudioTrack& track)
+    {
+        track.insertMIDIClip ({ tracktion::TimePosition(), tracktion::TimePosition::fromSeconds (1.0) }, nullptr);
+
+        for (int i = 0; i < 2; ++i)
+            if (auto tone = track.edit.getPluginCache().createNewPlugin (te::ToneGeneratorPlugin::xmlTypeName, {}))
+                track.pluginList.insertPlugin (tone, 0, nullptr);
+
+        track.pluginList.getPlugins()[1]->setEnabled (false);
+    }
+
+    int countFreezeClips (te::AudioTrack& track)
+    {
+        int num = 0;
+
+        for (auto* clip : track.getClips())
+            if (TrackFreezer::isFreezeClip (*clip) && dynamic_cast<te::WaveAudioClip*> (clip) != nullptr)
+                ++num;
+
+        return num;
+    }
+
+    /** Each plugin on the track in order: on or off, and whether freezing switched it off. */
+    juce::StringArray describePlugins (te::AudioTrack& track)
+    {
+        juce::StringArray result;
+
+        for (auto* plugin : track.pluginList)
+            result.add (juce::String (plugin->isEnabled() ? "on" : "off")
+                        + (plugin->state.getProperty (bypassedByFreeze, false) ? " (freeze)" : ""));
+
+        return result;
+    }
+}
+
+TEST_CASE("TrackFreezer picks a folder for freeze files", "[freeze]")
+{
+    SECTION("next to the project, named after it")
+    {
+        const auto project = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                 .getChildFile ("Songs").getChildFile ("My Song.tracktionedit");
+        const auto dir = TrackFreezer::getFreezeDirectory (project);
+
+        REQUIRE(dir.getParentDirectory() == project.getParentDirectory());
+        REQUIRE(dir.getFileName() == "My Song Freeze");
+    }
+
+    SECTION("in the temp folder for an untitled edit")
+    {
+        const auto dir = TrackFreezer::getFreezeDirectory (juce::File());
+
+        REQUIRE(dir.isAChildOf (juce::File::getSpecialLocation (juce::File::tempDirectory)));
+        REQUIRE(dir.getFileName() == "GrooveKit Freeze");
+    }
+}
+
+TEST_CASE("TrackFreezer swaps a track's plugins for its freeze file and back", "[freeze]")
+{
+    TestEdit t;
+    auto& track = t.track (0);
+    auto& um = t.edit->getUndoManager();
+    addFreezableContent (track);
+
+    const auto live = describePlugins (track);
+    REQUIRE(live[0] == "on");
+    REQUIRE(live[1] == "off");
+
+    const auto freezeDir = TrackFreezer::getFreezeDirectory ({});
+    TrackFreezer freezer (t.engine);
+    um.beginNewTransaction();
+
+    REQUIRE(freezer.freeze (track, t.edit->state, {}, 44100.0));
+    REQUIRE(freezer.getState (track) == TrackFreezer::State::freezing);
+    REQUIRE(freezer.waitForPendingFreezes (60000));
+
+    // Only the enabled instrument is switched off and marked; the fader and meters stay live
+    auto frozen = live;
+    frozen.set (0, "off (freeze)");
+
+    REQUIRE(freezer.getState (track) == TrackFreezer::State::frozen);
+    REQUIRE(countFreezeClips (track) == 1);
+    REQUIRE(describePlugins (track) == frozen);
+
+    // The tone generator never stops, so the whole tail allowance is audible
+    for (auto* clip : track.getClips())
+        if (TrackFreezer::isFreezeClip (*clip))
+            REQUIRE(clip->getPosition().getLength().inSeconds() > 1.0 + TrackFreezer::renderTailSeconds - 0.05);
+
+    SECTION("unfreezing removes the clip and re-enables exactly the plugins freezing disabled")
+    {
+        freezer.unfreeze (track);
+
+        REQUIRE(freezer.getState (track) == TrackFreezer::State::live);
+        REQUIRE(countFreezeClips (track) == 0);
+        REQUIRE(describePlugins (track) == live);
+    }
+
+    SECTION("freeze and unfreeze are each one undo step")
+    {
+        freezer.unfreeze (track);
+
+        REQUIRE(um.undo());
+        REQUIRE(freezer.getState (track) == TrackFreezer::State::frozen);
+        REQUIRE(countFreezeClips (track) == 1);
+        REQUIRE(describePlugins (track) == frozen);
+
+        REQUIRE(um.undo());
+        REQUIRE(freezer.getState (track) == TrackFreezer::State::live);
+        REQUIRE(countFreezeClips (track) == 0);
+        REQUIRE(describePlugins (track) == live);
+
+        REQUIRE(um.redo());
+        REQUIRE(freezer.getState (track) == TrackFreezer::State::frozen);
+        REQUIRE(describePlugins (track) == frozen);
+    }
+
+    freezeDir.deleteRecursively();
+}
+
+TEST_CASE("TrackFreezer sizes freeze clips to where the audio ends", "[freeze]")
+{
+    // One second of tone, then two of silence
+    const double sampleRate = 44100.0;
+    juce::AudioBuffer<float> audio (2, (int) (3 * sampleRate));
+    audio.clear();
+
+    for (int i = 0; i < (int) sampleRate; ++i)
+        for (int ch = 0; ch < 2; ++ch)
+            audio.setSample (ch, i, 0.5f * std::sin (i * 0.05f));
+
+    juce::TemporaryFile tmp (".wav");
+
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer (wav.createWriterFor (tmp.getFile().createOutputStream().release(),
+                                                                              sampleRate, 2, 24, {}, 0));
+        REQUIRE(writer != nullptr);
+        REQUIRE(writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples()));
+    }
+
+    SECTION("the silent end is left out")
+    {
+        const auto length = TrackFreezer::findAudibleLength (tmp.getFile(), tracktion::TimeDuration::fromSeconds (2.5));
+        REQUIRE(length.inSeconds() > 0.99);
+        REQUIRE(length.inSeconds() <= 1.0);
+    }
+
+    SECTION("only the searched stretch can be left out")
+    {
+        const auto length = TrackFreezer::findAudibleLength (tmp.getFile(), tracktion::TimeDuration::fromSeconds (1.0));
+        REQUIRE(length.inSeconds() > 1.99);
+        REQUIRE(length.inSeconds() <= 2.0);
+    }
+}